@@ -30,14 +30,14 @@
 
 // the noinline is so you can see the timeLambda when profiling
 template <class L>
-TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message)
+TB_NOINLINE static std::chrono::duration<double> timeLambda(
+  L&& lambda, const std::string& message)
 {
   const auto start = std::chrono::high_resolution_clock::now();
   lambda();
   const auto end = std::chrono::high_resolution_clock::now();
 
-  printf(
-    "Time elapsed for '%s': %fms\n",
-    message.c_str(),
-    std::chrono::duration<double>(end - start).count() * 1000.0);
+  const auto elapsed = std::chrono::duration<double>(end - start);
+  printf("Time elapsed for '%s': %fms\n", message.c_str(), elapsed.count() * 1000.0);
+  return elapsed;
 }
@@ -0,0 +1,182 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "Assets/EntityModel.h"
+#include "Assets/Palette.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/Md2Loader.h"
+#include "IO/Reader.h"
+#include "IO/VirtualFileSystem.h"
+#include "Logger.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+constexpr size_t NumModels = 500;
+constexpr size_t NumFrames = 200;
+constexpr size_t NumVertices = 512;
+
+template <typename T>
+void write(std::vector<char>& buffer, const T value)
+{
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Creates an animated MD2 model with a single triangle strip. The vertex positions
+ * depend on the given model index so that every model is distinct.
+ */
+std::vector<char> makeMd2(const size_t modelIndex)
+{
+  const auto frameSize = 6 * sizeof(float) + 16 + NumVertices * 4;
+  const auto commandCount = 1 + 3 * NumVertices;
+  const auto frameOffset = 17 * sizeof(int32_t);
+  const auto commandOffset = frameOffset + NumFrames * frameSize;
+  const auto endOffset = commandOffset + commandCount * 4;
+
+  auto buffer = std::vector<char>{};
+  buffer.reserve(endOffset);
+
+  write<int32_t>(buffer, ('2' << 24) + ('P' << 16) + ('D' << 8) + 'I');
+  write<int32_t>(buffer, 8);
+  write<int32_t>(buffer, 64);                   // skin width
+  write<int32_t>(buffer, 64);                   // skin height
+  write<int32_t>(buffer, int32_t(frameSize));   // frame size
+  write<int32_t>(buffer, 0);                    // skin count
+  write<int32_t>(buffer, int32_t(NumVertices)); // vertex count
+  write<int32_t>(buffer, 0);                    // uv coord count
+  write<int32_t>(buffer, 0);                    // triangle count
+  write<int32_t>(buffer, int32_t(commandCount));
+  write<int32_t>(buffer, int32_t(NumFrames));
+  write<int32_t>(buffer, int32_t(frameOffset)); // skin offset
+  write<int32_t>(buffer, int32_t(frameOffset)); // uv coord offset
+  write<int32_t>(buffer, int32_t(frameOffset)); // triangle offset
+  write<int32_t>(buffer, int32_t(frameOffset));
+  write<int32_t>(buffer, int32_t(commandOffset));
+  write<int32_t>(buffer, int32_t(endOffset));
+
+  for (size_t f = 0; f < NumFrames; ++f)
+  {
+    write<float>(buffer, 1.0f); // scale
+    write<float>(buffer, 1.0f);
+    write<float>(buffer, 1.0f);
+    write<float>(buffer, 0.0f); // offset
+    write<float>(buffer, 0.0f);
+    write<float>(buffer, 0.0f);
+
+    const auto frameName = "frame" + std::to_string(f);
+    buffer.insert(buffer.end(), frameName.begin(), frameName.end());
+    buffer.insert(buffer.end(), 16 - frameName.size(), '\0');
+
+    for (size_t v = 0; v < NumVertices; ++v)
+    {
+      write<uint8_t>(buffer, uint8_t((v * 7 + f + modelIndex) % 256));
+      write<uint8_t>(buffer, uint8_t((v * 13 + f) % 256));
+      write<uint8_t>(buffer, uint8_t((v * 17 + modelIndex) % 256));
+      write<uint8_t>(buffer, uint8_t(v % 162)); // normal index
+    }
+  }
+
+  write<int32_t>(buffer, int32_t(NumVertices)); // triangle strip
+  for (size_t v = 0; v < NumVertices; ++v)
+  {
+    write<float>(buffer, float(v % 64) / 64.0f);
+    write<float>(buffer, float(v / 64) / 64.0f);
+    write<int32_t>(buffer, int32_t(v));
+  }
+
+  return buffer;
+}
+} // namespace
+
+TEST_CASE("EntityModelLoadingBenchmark.loadAnimatedModels")
+{
+  auto logger = NullLogger{};
+  const auto paletteData = std::vector<unsigned char>(768, 0);
+  const auto palette =
+    Assets::makePalette(paletteData, Assets::PaletteColorFormat::Rgb) | kdl::value();
+  const auto fs = VirtualFileSystem{};
+
+  auto buffers = std::vector<std::vector<char>>{};
+  buffers.reserve(NumModels);
+  for (size_t i = 0; i < NumModels; ++i)
+  {
+    buffers.push_back(makeMd2(i));
+  }
+
+  const auto loadModel = [&](const size_t i) {
+    const auto& buffer = buffers[i];
+    const auto reader = Reader::from(buffer.data(), buffer.data() + buffer.size());
+    auto loader = Md2Loader{"model" + std::to_string(i), reader, palette, fs};
+    return loader.load(logger) | kdl::value();
+  };
+
+  // opening a map only needs the first frame of each model
+  auto models = std::vector<Assets::EntityModelData>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumModels; ++i)
+      {
+        models.push_back(loadModel(i));
+      }
+    },
+    "Load " + std::to_string(NumModels) + " animated models on one thread");
+
+  CHECK(models.size() == NumModels);
+  models.clear();
+
+  auto taskManager = kdl::task_manager{};
+  timeLambda(
+    [&]() {
+      auto tasks = std::vector<std::function<Assets::EntityModelData()>>{};
+      tasks.reserve(NumModels);
+      for (size_t i = 0; i < NumModels; ++i)
+      {
+        tasks.emplace_back([&, i]() { return loadModel(i); });
+      }
+      models = taskManager.run_tasks_and_wait(std::move(tasks));
+    },
+    "Load " + std::to_string(NumModels) + " animated models on "
+      + std::to_string(taskManager.thread_count()) + " threads");
+
+  CHECK(models.size() == NumModels);
+
+  timeLambda(
+    [&]() {
+      for (auto& model : models)
+      {
+        model.frames();
+      }
+    },
+    "Decode the remaining frames of " + std::to_string(NumModels) + " animated models");
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "IO/NodeWriter.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::IO
+{
+namespace
+{
+// 60 * 60 * 64 = 230,400 cuboids, which yields a map file of more than 100 MB
+constexpr size_t NumBrushesX = 60;
+constexpr size_t NumBrushesY = 60;
+constexpr size_t NumBrushesZ = 64;
+
+std::vector<Model::Node*> makeBrushNodes(const Model::BrushBuilder& builder)
+{
+  auto result = std::vector<Model::Node*>{};
+  result.reserve(NumBrushesX * NumBrushesY * NumBrushesZ);
+
+  for (size_t x = 0; x < NumBrushesX; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesY; ++y)
+    {
+      for (size_t z = 0; z < NumBrushesZ; ++z)
+      {
+        const auto min =
+          vm::vec3{double(x) - 30.0, double(y) - 30.0, double(z) - 32.0} * 96.0
+          + vm::vec3{0.125, 0.25, 0.5};
+        const auto bounds = vm::bbox3{min, min + vm::vec3{33.5, 47.25, 64.75}};
+        result.push_back(new Model::BrushNode{
+          builder.createCuboid(bounds, "some_material") | kdl::value()});
+      }
+    }
+  }
+
+  return result;
+}
+
+std::string writeMap(const Model::WorldNode& world)
+{
+  auto stream = std::stringstream{};
+  auto writer = NodeWriter{world, stream};
+  writer.writeMap();
+  return stream.str();
+}
+
+double megaBytes(const std::string& str)
+{
+  return double(str.size()) / 1024.0 / 1024.0;
+}
+
+void printThroughput(const std::string& str, const std::chrono::duration<double> elapsed)
+{
+  printf(
+    "Wrote %f MB at %f MB/s\n", megaBytes(str), megaBytes(str) / elapsed.count());
+}
+} // namespace
+
+TEST_CASE("NodeWriterBenchmark.writeMapAfterEdit")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto world = Model::WorldNode{{}, Model::Entity{}, Model::MapFormat::Standard};
+  world.defaultLayer()->addChildren(makeBrushNodes(builder));
+
+  auto str = std::string{};
+  const auto coldWriteTime = timeLambda(
+    [&]() { str = writeMap(world); },
+    "Write map with " + std::to_string(world.defaultLayer()->childCount())
+      + " brushes");
+  printThroughput(str, coldWriteTime);
+
+  const auto size = str.size();
+
+  const auto cachedWriteTime =
+    timeLambda([&]() { str = writeMap(world); }, "Write unchanged map again");
+  printThroughput(str, cachedWriteTime);
+
+  // edit a single brush
+  auto* brushNode =
+    static_cast<Model::BrushNode*>(world.defaultLayer()->children().front());
+  auto brush = brushNode->brush();
+  REQUIRE(brush
+            .transform(worldBounds, vm::translation_matrix(vm::vec3{0, 0, 16}), true)
+            .is_success());
+  brushNode->setBrush(std::move(brush));
+
+  const auto editedWriteTime = timeLambda(
+    [&]() { str = writeMap(world); }, "Write map again after editing one brush");
+  printThroughput(str, editedWriteTime);
+
+  CHECK(str.size() == size);
+}
+
+} // namespace TrenchBroom::IO
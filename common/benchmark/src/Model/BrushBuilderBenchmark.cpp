@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <string>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// the number of mouse move events of a drag
+constexpr size_t NumDragSteps = 20;
+
+constexpr size_t NumSides = 128;
+
+/**
+ * Returns the bounds of the shape in the given step of a drag that enlarges it.
+ */
+vm::bbox3 dragBounds(const size_t step)
+{
+  const auto size = 512.0 + 16.0 * double(step);
+  return vm::bbox3{{0, 0, 0}, {size, size, 256.0}};
+}
+} // namespace
+
+TEST_CASE("BrushBuilderBenchmark.createCylinder")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  // create the shape for every mouse move event, like DrawShapeTool does while dragging
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumDragSteps; ++i)
+      {
+        const auto brush = builder.createCylinder(
+          dragBounds(i), NumSides, RadiusMode::ToEdge, vm::axis::z, "material");
+        REQUIRE(brush.is_success());
+      }
+    },
+    "Create " + std::to_string(NumSides) + " sided cylinder "
+      + std::to_string(NumDragSteps) + " times");
+}
+
+TEST_CASE("BrushBuilderBenchmark.createHollowCylinder")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumDragSteps; ++i)
+      {
+        const auto brushes = builder.createHollowCylinder(
+          dragBounds(i), 16.0, NumSides, RadiusMode::ToEdge, vm::axis::z, "material");
+        REQUIRE(brushes.is_success());
+        REQUIRE(brushes.value().size() == NumSides);
+      }
+    },
+    "Create " + std::to_string(NumSides) + " sided hollow cylinder "
+      + std::to_string(NumDragSteps) + " times");
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// 250 * 200 = 50,000 cuboids
+constexpr size_t NumBrushesX = 250;
+constexpr size_t NumBrushesY = 200;
+
+// the number of mouse move events of a drag
+constexpr size_t NumDragSteps = 10;
+
+std::vector<Brush> makeBrushes(const BrushBuilder& builder)
+{
+  auto result = std::vector<Brush>{};
+  result.reserve(NumBrushesX * NumBrushesY);
+
+  for (size_t x = 0; x < NumBrushesX; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesY; ++y)
+    {
+      const auto min = vm::vec3{double(x) - 125.0, double(y) - 100.0, 0.0} * 24.0;
+      const auto bounds = vm::bbox3{min, min + vm::vec3{16, 16, 32}};
+      result.push_back(builder.createCuboid(bounds, "material") | kdl::value());
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Transforms copies of the given brushes by the given transformation in each drag step,
+ * like MapDocument::transformObjects does for every mouse move event while dragging.
+ */
+std::vector<Brush> drag(
+  const vm::bbox3& worldBounds,
+  const std::vector<Brush>& brushes,
+  const vm::mat4x4& transformation)
+{
+  auto result = brushes;
+  for (size_t i = 0; i < NumDragSteps; ++i)
+  {
+    result = kdl::vec_transform(brushes, [&](auto brush) {
+               return brush.transform(worldBounds, transformation, false)
+                      | kdl::transform([&]() { return std::move(brush); });
+             })
+             | kdl::fold | kdl::value();
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("BrushTransformBenchmark.dragBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  const auto brushes = makeBrushes(builder);
+
+  auto translated = std::vector<Brush>{};
+  timeLambda(
+    [&]() {
+      translated = drag(worldBounds, brushes, vm::translation_matrix(vm::vec3{16, 0, 0}));
+    },
+    "Translate " + std::to_string(brushes.size()) + " brushes "
+      + std::to_string(NumDragSteps) + " times");
+
+  auto rotated = std::vector<Brush>{};
+  timeLambda(
+    [&]() {
+      rotated = drag(
+        worldBounds, brushes, vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)));
+    },
+    "Rotate " + std::to_string(brushes.size()) + " brushes "
+      + std::to_string(NumDragSteps) + " times");
+
+  // for comparison, rebuild the geometry from the translated faces as it used to be done
+  auto rebuilt = std::vector<Brush>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumDragSteps; ++i)
+      {
+        rebuilt = kdl::vec_transform(
+                    translated,
+                    [&](const auto& brush) {
+                      return Brush::create(worldBounds, brush.faces());
+                    })
+                  | kdl::fold | kdl::value();
+      }
+    },
+    "Rebuild " + std::to_string(brushes.size()) + " translated brushes "
+      + std::to_string(NumDragSteps) + " times");
+
+  CHECK(translated.size() == brushes.size());
+  CHECK(rotated.size() == brushes.size());
+  CHECK(rebuilt == translated);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// 25 * 20 = 500 shared vertices, each shared by 4 cuboids
+constexpr size_t NumVerticesX = 25;
+constexpr size_t NumVerticesY = 20;
+
+// the number of mouse move events of a drag
+constexpr size_t NumDragSteps = 10;
+
+/**
+ * Creates 4 cuboids around each shared vertex such that the shared vertex is a top corner
+ * of each of them.
+ */
+std::vector<Brush> makeBrushes(
+  const BrushBuilder& builder, std::vector<vm::vec3>& vertices)
+{
+  auto result = std::vector<Brush>{};
+  result.reserve(NumVerticesX * NumVerticesY * 4);
+
+  for (size_t x = 0; x < NumVerticesX; ++x)
+  {
+    for (size_t y = 0; y < NumVerticesY; ++y)
+    {
+      const auto vertex = vm::vec3{double(x) - 12.0, double(y) - 10.0, 1.0} * 256.0;
+      vertices.push_back(vertex);
+
+      const auto offsets = std::vector<vm::vec3>{
+        {0, 0, 0},
+        {64, 0, 0},
+        {0, 64, 0},
+        {64, 64, 0},
+      };
+      for (const auto& offset : offsets)
+      {
+        const auto min = vertex - vm::vec3{64, 64, 64} + offset;
+        const auto bounds = vm::bbox3{min, min + vm::vec3{64, 64, 64}};
+        result.push_back(builder.createCuboid(bounds, "material") | kdl::value());
+      }
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("BrushVertexMoveBenchmark.dragSharedVertices")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto vertices = std::vector<vm::vec3>{};
+  auto brushes = makeBrushes(builder, vertices);
+
+  const auto delta = vm::vec3{2, 2, 2};
+
+  // move the shared vertices of all brushes in each drag step, like
+  // MapDocument::moveVertices does for every mouse move event while dragging
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumDragSteps; ++i)
+      {
+        for (size_t j = 0; j < brushes.size(); ++j)
+        {
+          auto& brush = brushes[j];
+          auto& vertex = vertices[j / 4];
+          const auto vertexPositions = std::vector<vm::vec3>{vertex};
+
+          REQUIRE(brush.canMoveVertices(worldBounds, vertexPositions, delta));
+          REQUIRE(
+            brush.moveVertices(worldBounds, vertexPositions, delta, false).is_success());
+        }
+
+        for (auto& vertex : vertices)
+        {
+          vertex = vertex + delta;
+        }
+      }
+    },
+    "Move " + std::to_string(vertices.size()) + " vertices of "
+      + std::to_string(brushes.size()) + " brushes " + std::to_string(NumDragSteps)
+      + " times");
+
+  for (size_t j = 0; j < brushes.size(); ++j)
+  {
+    CHECK(brushes[j].hasVertex(vertices[j / 4]));
+  }
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
+
+#include "kdl/result.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+constexpr size_t NumEntities = 100000;
+
+std::vector<std::unique_ptr<EntityNode>> makeEntityNodes()
+{
+  auto result = std::vector<std::unique_ptr<EntityNode>>{};
+  result.reserve(NumEntities);
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    const auto n = std::to_string(i);
+    result.push_back(std::make_unique<EntityNode>(Entity{{
+      {"classname", i % 2 == 0 ? "light" : "trigger_multiple"},
+      {"targetname", "target_" + n},
+      {"target", "target_" + std::to_string(i + 1)},
+      {"message", "This is message number " + n},
+    }}));
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("EntityNodeIndexBenchmark.findEntityNodes")
+{
+  const auto nodes = makeEntityNodes();
+
+  auto index = EntityNodeIndex{};
+  timeLambda(
+    [&]() {
+      for (const auto& node : nodes)
+      {
+        index.addEntityNode(node.get());
+      }
+    },
+    "Index " + std::to_string(NumEntities) + " entities");
+
+  auto result = std::vector<EntityNodeBase*>{};
+  timeLambda(
+    [&]() {
+      result = index.findEntityNodes(
+        EntityNodeIndexQuery::any(), EntityNodeIndexQuery::substring("number 4242"));
+    },
+    "Find entities by substring");
+  CHECK(result.size() == 11u);
+
+  timeLambda(
+    [&]() {
+      result = index.findEntityNodes(
+        EntityNodeIndexQuery::exact("targetname"),
+        EntityNodeIndexQuery::glob("target_1234%"));
+    },
+    "Find entities by glob");
+  CHECK(result.size() == 10u);
+
+  timeLambda(
+    [&]() {
+      result = index.findEntityNodes(
+        EntityNodeIndexQuery::exact("target"),
+        EntityNodeIndexQuery::regex("^target_9999.$") | kdl::value());
+    },
+    "Find entities by regex");
+  CHECK(result.size() == 10u);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/LinkedGroupUtils.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/parallel.h"
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// 50 * 100 = 5,000 cuboids
+constexpr size_t NumBrushesX = 50;
+constexpr size_t NumBrushesY = 100;
+constexpr size_t NumLinkedGroups = 40;
+
+// 100 linked groups of 100 brushes each in a world of 200,000 nodes
+constexpr size_t NumLinkedGroupsInWorld = 100;
+constexpr size_t NumBrushesPerLinkedGroup = 100;
+constexpr size_t NumBrushesInWorld = 190000;
+
+std::vector<Node*> makeBrushNodes(const BrushBuilder& builder)
+{
+  auto result = std::vector<Node*>{};
+  result.reserve(NumBrushesX * NumBrushesY);
+
+  for (size_t x = 0; x < NumBrushesX; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesY; ++y)
+    {
+      const auto min = vm::vec3{double(x) - 25.0, double(y) - 50.0, 0.0} * 64.0;
+      const auto bounds = vm::bbox3{min, min + vm::vec3{32, 32, 32}};
+      result.push_back(
+        new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+    }
+  }
+
+  return result;
+}
+
+std::vector<Node*> makeCubes(
+  const BrushBuilder& builder, const size_t count, const size_t rowLength)
+{
+  auto result = std::vector<Node*>{};
+  result.reserve(count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3{double(i % rowLength), double(i / rowLength), 0.0} * 16.0
+                     - vm::vec3{4096.0, 4096.0, 0.0};
+    const auto bounds = vm::bbox3{min, min + vm::vec3{8, 8, 8}};
+    result.push_back(
+      new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("LinkedGroupBenchmark.updateLinkedGroups")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto sourceGroupNode = GroupNode{Group{"source"}};
+  sourceGroupNode.addChildren(makeBrushNodes(builder));
+
+  auto targetGroupNodes = std::vector<std::unique_ptr<GroupNode>>{};
+  for (size_t i = 0; i < NumLinkedGroups; ++i)
+  {
+    auto group = Group{"target"};
+    group.transform(vm::translation_matrix(vm::vec3{0, 0, double(i + 1) * 128.0}));
+    targetGroupNodes.push_back(std::make_unique<GroupNode>(std::move(group)));
+  }
+
+  const auto targets = kdl::vec_transform(
+    targetGroupNodes, [](const auto& groupNode) { return groupNode.get(); });
+
+  // populate the linked groups the same way that a propagation does
+  for (auto& [groupNode, newChildren] :
+       updateLinkedGroups(sourceGroupNode, targets, worldBounds) | kdl::value())
+  {
+    groupNode->replaceChildren(std::move(newChildren));
+  }
+
+  // edit a single brush in the source group
+  auto* brushNode = static_cast<BrushNode*>(sourceGroupNode.children().front());
+  auto brush = brushNode->brush();
+  REQUIRE(brush
+            .transform(worldBounds, vm::translation_matrix(vm::vec3{0, 0, 16}), true)
+            .is_success());
+  brushNode->setBrush(std::move(brush));
+
+  auto fullUpdate = UpdateLinkedGroupsResult{};
+  timeLambda(
+    [&]() {
+      fullUpdate = updateLinkedGroups(sourceGroupNode, targets, worldBounds)
+                   | kdl::value();
+    },
+    "Update " + std::to_string(NumLinkedGroups) + " linked groups of "
+      + std::to_string(sourceGroupNode.childCount()) + " brushes by replacing all nodes");
+
+  auto incrementalUpdate = LinkedNodeUpdates{};
+  timeLambda(
+    [&]() {
+      incrementalUpdate =
+        updateLinkedNodes(sourceGroupNode, targets, worldBounds) | kdl::value();
+    },
+    "Update " + std::to_string(NumLinkedGroups) + " linked groups of "
+      + std::to_string(sourceGroupNode.childCount())
+      + " brushes by replacing changed nodes");
+
+  CHECK(fullUpdate.size() == NumLinkedGroups);
+  CHECK(incrementalUpdate.childrenToReplace.empty());
+  CHECK(incrementalUpdate.contentsToSwap.size() == NumLinkedGroups);
+}
+
+TEST_CASE("LinkedGroupBenchmark.transformLinkedBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto world = WorldNode{{}, Entity{}, MapFormat::Standard};
+  world.defaultLayer()->addChildren(makeCubes(builder, NumBrushesInWorld, 500));
+
+  auto* sourceGroupNode = new GroupNode{Group{"source"}};
+  sourceGroupNode->addChildren(makeCubes(builder, NumBrushesPerLinkedGroup, 10));
+
+  auto targetGroupNodes = std::vector<GroupNode*>{};
+  for (size_t i = 1; i < NumLinkedGroupsInWorld; ++i)
+  {
+    auto group = Group{"target"};
+    group.transform(vm::translation_matrix(vm::vec3{0, 0, double(i) * 16.0}));
+    targetGroupNodes.push_back(new GroupNode{std::move(group)});
+  }
+
+  for (auto& [groupNode, newChildren] :
+       updateLinkedGroups(*sourceGroupNode, targetGroupNodes, worldBounds)
+         | kdl::value())
+  {
+    groupNode->replaceChildren(std::move(newChildren));
+  }
+
+  world.defaultLayer()->addChild(sourceGroupNode);
+  world.defaultLayer()->addChildren(kdl::vec_static_cast<Node*>(targetGroupNodes));
+
+  const auto linkedBrushNodes = kdl::vec_static_cast<BrushNode*>(
+    kdl::vec_flatten(kdl::vec_transform(targetGroupNodes, [](const auto* groupNode) {
+      return groupNode->children();
+    })));
+
+  // move the brushes in the same way that MapDocument::transformObjects does
+  const auto transformation = vm::translation_matrix(vm::vec3{16, 16, 0});
+  auto transformedBrushes = std::vector<Brush>{};
+  timeLambda(
+    [&]() {
+      transformedBrushes =
+        kdl::vec_parallel_transform(
+          linkedBrushNodes,
+          [&](const auto* brushNode) {
+            const auto lockAlignment =
+              collectLinkedNodes({&world}, *brushNode).size() > 1;
+
+            auto brush = brushNode->brush();
+            return brush.transform(worldBounds, transformation, lockAlignment)
+                   | kdl::transform([&]() { return std::move(brush); });
+          })
+        | kdl::fold | kdl::value();
+    },
+    "Transform " + std::to_string(linkedBrushNodes.size())
+      + " brushes in linked groups in a world with "
+      + std::to_string(world.defaultLayer()->childCount()) + " top level nodes");
+
+  CHECK(transformedBrushes.size() == linkedBrushNodes.size());
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/HitFilter.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Model/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// 100 * 100 * 20 = 200,000 cuboids
+constexpr size_t NumBrushesX = 100;
+constexpr size_t NumBrushesY = 100;
+constexpr size_t NumBrushesZ = 20;
+constexpr size_t NumPicks = 1000;
+
+std::vector<Node*> makeBrushNodes(const BrushBuilder& builder)
+{
+  auto result = std::vector<Node*>{};
+  result.reserve(NumBrushesX * NumBrushesY * NumBrushesZ);
+
+  for (size_t x = 0; x < NumBrushesX; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesY; ++y)
+    {
+      for (size_t z = 0; z < NumBrushesZ; ++z)
+      {
+        const auto min =
+          vm::vec3{double(x) - 50.0, double(y) - 50.0, double(z) - 10.0} * 64.0;
+        const auto bounds = vm::bbox3{min, min + vm::vec3{32, 32, 32}};
+        result.push_back(
+          new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+      }
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("PickingBenchmark.pick")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto world = WorldNode{{}, Entity{}, MapFormat::Standard};
+  world.defaultLayer()->addChildren(makeBrushNodes(builder));
+
+  const auto editorContext = EditorContext{};
+
+  // look into the grid from one of its corners so that every ray passes many brushes
+  const auto origin = vm::vec3{-3500, -3500, 0};
+  auto pickRays = std::vector<vm::ray3>{};
+  pickRays.reserve(NumPicks);
+  for (size_t i = 0; i < NumPicks; ++i)
+  {
+    const auto target = vm::vec3{
+      double((i * 37) % 100) * 64.0 - 3200.0 + 16.0,
+      double((i * 53) % 100) * 64.0 - 3200.0 + 16.0,
+      double(i % 20) * 64.0 - 640.0 + 16.0};
+    pickRays.emplace_back(origin, vm::normalize(target - origin));
+  }
+
+  auto numHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        auto pickResult = PickResult::byDistance();
+        world.pick(editorContext, pickRay, pickResult);
+        numHits += pickResult.size();
+      }
+    },
+    "Pick " + std::to_string(NumPicks) + " times collecting all hits among "
+      + std::to_string(world.defaultLayer()->childCount()) + " brushes");
+
+  auto numQueryHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        auto pickResult = PickResult::query(HitFilters::type(BrushNode::BrushHitType));
+        world.pick(editorContext, pickRay, pickResult);
+        numQueryHits += pickResult.size();
+      }
+    },
+    "Pick " + std::to_string(NumPicks) + " times collecting the closest hit among "
+      + std::to_string(world.defaultLayer()->childCount()) + " brushes");
+
+  CHECK(numQueryHits <= NumPicks);
+  CHECK(numHits >= numQueryHits);
+}
+
+} // namespace TrenchBroom::Model
@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/PortalFile.h"
+
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom::Model
+{
+namespace
+{
+// 1,000,000 portals with 4 vertices each yield a portal file of more than 100 MB
+constexpr size_t NumPortals = 1000000;
+
+std::string makePortalFile()
+{
+  auto result = std::string{};
+  auto out = std::back_inserter(result);
+  fmt::format_to(out, "PRT1\n{}\n{}\n", NumPortals * 2, NumPortals);
+  for (size_t i = 0; i < NumPortals; ++i)
+  {
+    const auto x = double(i % 1000) * 64.0 + 0.125;
+    const auto y = double(i / 1000) * 64.0 - 0.25;
+    fmt::format_to(
+      out,
+      "4 {} {} ({} {} 64.5 ) ({} {} 64.5 ) ({} {} 128.5 ) ({} {} 128.5 )\n",
+      i * 2,
+      i * 2 + 1,
+      x,
+      y,
+      x + 32.0,
+      y,
+      x + 32.0,
+      y,
+      x,
+      y);
+  }
+  return result;
+}
+
+double megaBytes(const std::string& str)
+{
+  return double(str.size()) / 1024.0 / 1024.0;
+}
+} // namespace
+
+TEST_CASE("PortalFileBenchmark.loadPortalFile")
+{
+  const auto str = makePortalFile();
+
+  auto portalCount = size_t(0);
+  const auto elapsed = timeLambda(
+    [&]() {
+      const auto portalFile = loadPortalFile(std::string_view{str}) | kdl::value();
+      portalCount = portalFile.portalCount();
+    },
+    "Load portal file with " + std::to_string(NumPortals) + " portals");
+  printf(
+    "Read %f MB at %f MB/s\n", megaBytes(str), megaBytes(str) / elapsed.count());
+
+  CHECK(portalCount == NumPortals);
+}
+
+} // namespace TrenchBroom::Model
@@ -32,9 +32,13 @@
 #include "Renderer/BrushRenderer.h"
 
 #include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -118,6 +122,8 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
     },
     "validate after adding " + std::to_string(brushes.size())
       + " brushes to BrushRenderer");
+  printf(
+    "Vertex memory for %zu brushes: %zu bytes\n", brushes.size(), r.vertexMemoryUsage());
 
   // Tiny change: remove the last brush
   timeLambda([&]() { r.removeBrush(brushes.back()); }, "call removeBrush once");
@@ -155,5 +161,85 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
   kdl::vec_clear_and_delete(brushes);
   kdl::vec_clear_and_delete(materials);
 }
+
+TEST_CASE("BrushRendererBenchmark.dragUV")
+{
+  // 1,000 cubes with 5 selected faces each
+  constexpr auto NumUVBrushes = size_t(1'000);
+  constexpr auto NumSelectedFacesPerBrush = size_t(5);
+  constexpr auto NumDragSteps = size_t(10);
+
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto brushes = std::vector<Model::BrushNode*>{};
+  for (size_t i = 0; i < NumUVBrushes; ++i)
+  {
+    auto* brushNode =
+      new Model::BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+    for (size_t j = 0; j < NumSelectedFacesPerBrush; ++j)
+    {
+      brushNode->selectFace(j);
+    }
+    brushes.push_back(brushNode);
+  }
+
+  BrushRenderer r;
+  for (auto* brushNode : brushes)
+  {
+    r.addBrush(brushNode);
+  }
+  r.validate();
+
+  // like MapDocument::setFaceAttributes, which is called for every mouse move event, but
+  // the brushes are changed upfront to only measure updating the renderer
+  const auto drag = [&](const auto& changeAttributes) {
+    auto changedBrushes = std::vector<std::vector<Model::Brush>>{};
+    for (size_t i = 0; i < NumDragSteps; ++i)
+    {
+      changedBrushes.push_back(kdl::vec_transform(brushes, [&](const auto* brushNode) {
+        auto brush = brushNode->brush();
+        for (size_t j = 0; j < NumSelectedFacesPerBrush; ++j)
+        {
+          auto attributes = brush.face(j).attributes();
+          changeAttributes(attributes, float(i));
+          brush.face(j).setAttributes(attributes);
+        }
+        return brush;
+      }));
+    }
+
+    return [&, changedBrushes = std::move(changedBrushes)]() mutable {
+      for (auto& brushesOfStep : changedBrushes)
+      {
+        for (size_t i = 0; i < brushes.size(); ++i)
+        {
+          brushes[i]->setBrush(std::move(brushesOfStep[i]));
+          r.invalidateBrush(brushes[i]);
+        }
+        r.validate();
+      }
+    };
+  };
+
+  const auto numSelectedFaces = std::to_string(NumUVBrushes * NumSelectedFacesPerBrush);
+
+  timeLambda(
+    drag([](auto& attributes, const float step) { attributes.setOffset({step, step}); }),
+    "drag UV offset of " + numSelectedFaces + " faces " + std::to_string(NumDragSteps)
+      + " times");
+
+  // changing the surface value forces the brushes to be rebuilt, which is what a UV drag
+  // used to cost
+  timeLambda(
+    drag([](auto& attributes, const float step) {
+      attributes.setOffset({step, step});
+      attributes.setSurfaceValue(step);
+    }),
+    "drag UV offset and change surface value of " + numSelectedFaces + " faces "
+      + std::to_string(NumDragSteps) + " times");
+
+  kdl::vec_clear_and_delete(brushes);
+}
 } // namespace Renderer
 } // namespace TrenchBroom
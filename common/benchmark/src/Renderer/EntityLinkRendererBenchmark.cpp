@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Color.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+#include "Renderer/EntityLinkRenderer.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+// 50,000 entities in chains of 10, each entity targeting the next one in its chain
+constexpr size_t NumEntities = 50'000;
+constexpr size_t ChainLength = 10;
+
+std::vector<Model::Node*> makeEntityNodes()
+{
+  auto result = std::vector<Model::Node*>{};
+  result.reserve(NumEntities);
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    const auto x = std::to_string(i % 100 * 32);
+    const auto y = std::to_string(i / 100 * 32);
+    auto properties = std::vector<Model::EntityProperty>{
+      {"classname", "trigger_relay"},
+      {"origin", x + " " + y + " 0"},
+      {"targetname", "t" + std::to_string(i)},
+    };
+    if ((i + 1) % ChainLength != 0)
+    {
+      properties.emplace_back("target", "t" + std::to_string(i + 1));
+    }
+    result.push_back(new Model::EntityNode{Model::Entity{std::move(properties)}});
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("EntityLinkRendererBenchmark.updateLinks")
+{
+  auto world = Model::WorldNode{{}, Model::Entity{}, Model::MapFormat::Standard};
+  world.defaultLayer()->addChildren(makeEntityNodes());
+
+  const auto editorContext = Model::EditorContext{};
+  const auto defaultColor = Color{0.5f, 1.0f, 0.5f, 1.0f};
+  const auto selectedColor = Color{1.0f, 0.0f, 0.0f, 1.0f};
+
+  auto cache = EntityLinkCache{};
+  auto links = std::vector<LinkRenderer::LineVertex>{};
+
+  timeLambda(
+    [&]() { links = cache.getLinks(world, editorContext, defaultColor, selectedColor); },
+    "Collect links of " + std::to_string(NumEntities) + " entities");
+
+  const auto expectedLinkCount = NumEntities / ChainLength * (ChainLength - 1);
+  CHECK(links.size() == expectedLinkCount * 2);
+
+  // move an entity in the middle of a chain
+  auto* entityNode = static_cast<Model::EntityNode*>(
+    world.defaultLayer()->children()[NumEntities / 2 + 5]);
+  auto entity = entityNode->entity();
+  entity.addOrUpdateProperty("origin", "0 0 512");
+  entityNode->setEntity(std::move(entity));
+
+  timeLambda(
+    [&]() {
+      cache.invalidateNodes({entityNode});
+      links = cache.getLinks(world, editorContext, defaultColor, selectedColor);
+    },
+    "Update links after changing one entity");
+  CHECK(links.size() == expectedLinkCount * 2);
+
+  timeLambda(
+    [&]() {
+      cache.invalidate();
+      links = cache.getLinks(world, editorContext, defaultColor, selectedColor);
+    },
+    "Collect all links again");
+  CHECK(links.size() == expectedLinkCount * 2);
+}
+
+} // namespace TrenchBroom::Renderer
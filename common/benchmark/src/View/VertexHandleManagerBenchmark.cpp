@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom::View
+{
+namespace
+{
+// 50 * 50 * 5 cuboids with 8 vertices each yield 100,000 vertex handles
+constexpr size_t NumBrushesX = 50;
+constexpr size_t NumBrushesY = 50;
+constexpr size_t NumBrushesZ = 5;
+constexpr size_t NumQueries = 1000;
+
+std::vector<std::unique_ptr<Model::BrushNode>> makeBrushNodes()
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::unique_ptr<Model::BrushNode>>{};
+  result.reserve(NumBrushesX * NumBrushesY * NumBrushesZ);
+
+  for (size_t x = 0; x < NumBrushesX; ++x)
+  {
+    for (size_t y = 0; y < NumBrushesY; ++y)
+    {
+      for (size_t z = 0; z < NumBrushesZ; ++z)
+      {
+        // leave gaps between the brushes so that no vertex handles are shared
+        const auto min = vm::vec3{double(x), double(y), double(z)} * 64.0;
+        const auto bounds = vm::bbox3{min, min + vm::vec3{48, 48, 48}};
+        result.push_back(std::make_unique<Model::BrushNode>(
+          builder.createCuboid(bounds, "material") | kdl::value()));
+      }
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+TEST_CASE("VertexHandleManagerBenchmark.pickAndFindIncidentBrushes")
+{
+  const auto brushNodes = makeBrushNodes();
+  const auto brushNodePtrs =
+    kdl::vec_transform(brushNodes, [](const auto& brushNode) { return brushNode.get(); });
+
+  auto manager = VertexHandleManager{};
+  timeLambda(
+    [&]() { manager.addHandles(brushNodePtrs.begin(), brushNodePtrs.end()); },
+    "Add " + std::to_string(brushNodes.size() * 8) + " vertex handles");
+
+  REQUIRE(manager.totalHandleCount() == brushNodes.size() * 8);
+
+  auto camera = Renderer::PerspectiveCamera{};
+  camera.moveTo(vm::vec3f{-512, -512, 1024});
+  camera.lookAt(vm::vec3f{1600, 1600, 160}, vm::vec3f::pos_z());
+
+  // every pick ray is aimed at a vertex of some brush
+  const auto targets = kdl::vec_transform(brushNodePtrs, [](const auto* brushNode) {
+    return brushNode->logicalBounds().max;
+  });
+
+  auto numHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumQueries; ++i)
+      {
+        const auto origin = vm::vec3{camera.position()};
+        const auto& target = targets[(i * 7919) % targets.size()];
+        const auto pickRay = vm::ray3{origin, vm::normalize(target - origin)};
+
+        auto pickResult = Model::PickResult{};
+        manager.pick(pickRay, camera, pickResult);
+        numHits += pickResult.size();
+      }
+    },
+    "Pick " + std::to_string(NumQueries) + " times among "
+      + std::to_string(manager.totalHandleCount()) + " vertex handles");
+
+  CHECK(numHits >= NumQueries);
+
+  auto indexedResults = std::vector<std::vector<Model::BrushNode*>>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumQueries; ++i)
+      {
+        const auto& target = targets[(i * 7919) % targets.size()];
+        indexedResults.push_back(manager.findIncidentBrushes(target));
+      }
+    },
+    "Find incident brushes of " + std::to_string(NumQueries)
+      + " handles using the index");
+
+  auto linearResults = std::vector<std::vector<Model::BrushNode*>>{};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumQueries; ++i)
+      {
+        const auto& target = targets[(i * 7919) % targets.size()];
+        linearResults.push_back(manager.findIncidentBrushes(
+          target, brushNodePtrs.begin(), brushNodePtrs.end()));
+      }
+    },
+    "Find incident brushes of " + std::to_string(NumQueries)
+      + " handles by testing every brush");
+
+  CHECK(indexedResults == linearResults);
+}
+
+} // namespace TrenchBroom::View
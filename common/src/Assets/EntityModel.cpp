@@ -37,6 +37,7 @@
 
 #include <ranges>
 #include <string>
+#include <utility>
 
 namespace TrenchBroom::Assets
 {
@@ -81,6 +82,25 @@ std::ostream& operator<<(std::ostream& lhs, const Orientation rhs)
 
 // EntityModelFrame
 
+namespace
+{
+
+auto makeSpacialTree(const std::vector<vm::vec3f>& tris)
+{
+  auto spacialTree = octree<float, size_t>{16.0f};
+  for (size_t i = 0; i + 2 < tris.size(); i += 3)
+  {
+    auto bounds = vm::bbox3f::builder{};
+    bounds.add(tris[i + 0]);
+    bounds.add(tris[i + 1]);
+    bounds.add(tris[i + 2]);
+    spacialTree.insert(bounds.bounds(), i / 3u);
+  }
+  return spacialTree;
+}
+
+} // namespace
+
 kdl_reflect_impl(EntityModelFrame);
 
 EntityModelFrame::EntityModelFrame(
@@ -88,7 +108,6 @@ EntityModelFrame::EntityModelFrame(
   : m_index{index}
   , m_name{std::move(name)}
   , m_bounds{bounds}
-  , m_spacialTree{16.0f}
 {
 }
 
@@ -119,9 +138,14 @@ const vm::bbox3f& EntityModelFrame::bounds() const
 
 std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
 {
+  if (!m_spacialTree)
+  {
+    m_spacialTree = makeSpacialTree(m_tris);
+  }
+
   auto closestDistance = std::optional<float>{};
 
-  const auto candidates = m_spacialTree.find_intersectors(ray);
+  const auto candidates = m_spacialTree->find_intersectors(ray);
   for (const auto triNum : candidates)
   {
     const auto& p1 = m_tris[triNum * 3 + 0];
@@ -140,6 +164,9 @@ void EntityModelFrame::addToSpacialTree(
   const size_t index,
   const size_t count)
 {
+  // invalidate the spacial tree, it will be rebuilt when this frame is intersected
+  m_spacialTree = std::nullopt;
+
   switch (primType)
   {
   case Renderer::PrimType::Points:
@@ -152,19 +179,9 @@ void EntityModelFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + count);
     for (size_t i = 0; i < count; i += 3)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
-      const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-      const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      m_tris.push_back(Renderer::getVertexComponent<0>(vertices[index + i + 0]));
+      m_tris.push_back(Renderer::getVertexComponent<0>(vertices[index + i + 1]));
+      m_tris.push_back(Renderer::getVertexComponent<0>(vertices[index + i + 2]));
     }
     break;
   }
@@ -176,18 +193,9 @@ void EntityModelFrame::addToSpacialTree(
     const auto& p1 = Renderer::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i]);
-      const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
       m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      m_tris.push_back(Renderer::getVertexComponent<0>(vertices[index + i]));
+      m_tris.push_back(Renderer::getVertexComponent<0>(vertices[index + i + 1]));
     }
     break;
   }
@@ -198,15 +206,10 @@ void EntityModelFrame::addToSpacialTree(
     m_tris.reserve(m_tris.size() + (count - 2) * 3);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = Renderer::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = Renderer::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = Renderer::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
 
-      const auto triIndex = m_tris.size() / 3u;
       if (i % 2 == 0)
       {
         m_tris.push_back(p1);
@@ -219,7 +222,6 @@ void EntityModelFrame::addToSpacialTree(
         m_tris.push_back(p3);
         m_tris.push_back(p2);
       }
-      m_spacialTree.insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -467,6 +469,11 @@ std::unique_ptr<Renderer::MaterialIndexRangeRenderer> EntityModelSurface::buildR
 
 // EntityModelData
 
+bool shouldDecodeFrameOnDemand(const size_t frameIndex)
+{
+  return frameIndex > 0;
+}
+
 kdl_reflect_impl(EntityModelData);
 
 EntityModelData::EntityModelData(const PitchType pitchType, const Orientation orientation)
@@ -534,9 +541,46 @@ void EntityModelData::drop(const bool glContextAvailable)
 
 EntityModelFrame& EntityModelData::addFrame(std::string name, const vm::bbox3f& bounds)
 {
+  return addFrame(std::move(name), bounds, EntityModelFrameLoader{});
+}
+
+EntityModelFrame& EntityModelData::addFrame(
+  std::string name, const vm::bbox3f& bounds, EntityModelFrameLoader loader)
+{
+  if (loader)
+  {
+    auto frameLoader = std::make_unique<FrameLoader>();
+    frameLoader->load = std::move(loader);
+    m_frameLoaders.push_back(std::move(frameLoader));
+  }
+  else
+  {
+    m_frameLoaders.push_back(nullptr);
+  }
   return m_frames.emplace_back(frameCount(), std::move(name), bounds);
 }
 
+bool EntityModelData::isFrameLoaded(const size_t frameIndex) const
+{
+  return frameIndex < m_frameLoaders.size()
+         && (!m_frameLoaders[frameIndex] || m_frameLoaders[frameIndex]->loaded);
+}
+
+void EntityModelData::loadFrame(const size_t frameIndex)
+{
+  if (frameIndex < m_frameLoaders.size() && m_frameLoaders[frameIndex])
+  {
+    auto& frameLoader = *m_frameLoaders[frameIndex];
+    std::call_once(frameLoader.loadOnce, [&]() {
+      frameLoader.load(*this, m_frames[frameIndex]);
+
+      // release the data captured by the loader
+      frameLoader.load = nullptr;
+      frameLoader.loaded = true;
+    });
+  }
+}
+
 EntityModelSurface& EntityModelData::addSurface(std::string name, const size_t frameCount)
 {
   return m_surfaces.emplace_back(std::move(name), frameCount);
@@ -554,11 +598,19 @@ size_t EntityModelData::surfaceCount() const
 
 const std::vector<EntityModelFrame>& EntityModelData::frames() const
 {
+  for (size_t i = 0; i < frameCount(); ++i)
+  {
+    ensureFrameLoaded(i);
+  }
   return m_frames;
 }
 
 std::vector<EntityModelFrame>& EntityModelData::frames()
 {
+  for (size_t i = 0; i < frameCount(); ++i)
+  {
+    loadFrame(i);
+  }
   return m_frames;
 }
 
@@ -571,12 +623,24 @@ const EntityModelFrame* EntityModelData::frame(const std::string& name) const
 {
   const auto it = std::ranges::find_if(
     m_frames, [&](const auto& frame) { return frame.name() == name; });
-  return it != m_frames.end() ? &*it : nullptr;
+  if (it == m_frames.end())
+  {
+    return nullptr;
+  }
+
+  ensureFrameLoaded(it->index());
+  return &*it;
 }
 
 const EntityModelFrame* EntityModelData::frame(const size_t index) const
 {
-  return index < frameCount() ? &m_frames[index] : nullptr;
+  if (index >= frameCount())
+  {
+    return nullptr;
+  }
+
+  ensureFrameLoaded(index);
+  return &m_frames[index];
 }
 
 const EntityModelSurface& EntityModelData::surface(const size_t index) const
@@ -601,6 +665,14 @@ const EntityModelSurface* EntityModelData::surface(const std::string& name) cons
   return it != m_surfaces.end() ? &*it : nullptr;
 }
 
+void EntityModelData::ensureFrameLoaded(const size_t frameIndex) const
+{
+  // Decoding a frame does not change the observable state of this model, and loadFrame
+  // decodes each frame only once even if it is called from multiple threads, so this is
+  // allowed in const member functions.
+  const_cast<EntityModelData&>(*this).loadFrame(frameIndex);
+}
+
 kdl_reflect_impl(EntityModel);
 
 EntityModel::EntityModel(
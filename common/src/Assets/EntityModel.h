@@ -28,7 +28,10 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 #include "vm/bbox.h"
 #include "vm/forward.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -84,8 +87,8 @@ enum class Orientation
 std::ostream& operator<<(std::ostream& lhs, Orientation rhs);
 
 /**
- * One frame of the model. Since frames are loaded on demand, each frame has two possible
- * states: loaded and unloaded. These states are modeled as subclasses of this class.
+ * One frame of the model. The name and the bounds of a frame are always available, but
+ * its meshes may be decoded on demand, see EntityModelData::addFrame.
  */
 class EntityModelFrame
 {
@@ -99,7 +102,9 @@ private:
   std::vector<vm::vec3f> m_tris;
   using TriNum = size_t;
   using SpacialTree = octree<float, TriNum>;
-  SpacialTree m_spacialTree;
+
+  // Built from m_tris when this frame is first intersected
+  mutable std::optional<SpacialTree> m_spacialTree;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
 
@@ -152,7 +157,8 @@ public:
   std::optional<float> intersect(const vm::ray3f& ray) const;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Adds the given primitives to the triangles used for hit testing this frame. The
+   * spacial tree for these triangles is built when the frame is first intersected.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -167,8 +173,21 @@ public:
     size_t count);
 };
 
+class EntityModelData;
 class EntityModelMesh;
 
+/**
+ * Decodes the meshes of a frame and adds them to the surfaces of the given model data.
+ */
+using EntityModelFrameLoader = std::function<void(EntityModelData&, EntityModelFrame&)>;
+
+/**
+ * Indicates whether a model loader should decode the meshes of the frame with the given
+ * index on demand. The first frame is used by most entities, so it is decoded right away
+ * and all other frames are decoded on demand.
+ */
+bool shouldDecodeFrameOnDemand(size_t frameIndex);
+
 /**
  * A model surface represents an individual part of a model. MDL and MD2 models use only
  * one surface, while more complex model formats such as MD3 contain multiple surfaces
@@ -296,6 +315,20 @@ private:
   std::vector<EntityModelFrame> m_frames;
   std::vector<EntityModelSurface> m_surfaces;
 
+  /**
+   * Decodes the meshes of a frame. Frames may be accessed from multiple threads, so the
+   * loader is called under a once flag.
+   */
+  struct FrameLoader
+  {
+    EntityModelFrameLoader load;
+    std::once_flag loadOnce;
+    std::atomic<bool> loaded{false};
+  };
+
+  // One loader per frame, null if the frame was decoded eagerly
+  std::vector<std::unique_ptr<FrameLoader>> m_frameLoaders;
+
   kdl_reflect_decl(EntityModelData, m_pitchType, m_orientation, m_frames, m_surfaces);
 
 public:
@@ -351,6 +384,34 @@ public:
    */
   EntityModelFrame& addFrame(std::string name, const vm::bbox3f& bounds);
 
+  /**
+   * Adds a frame with the given name and bounds whose meshes are decoded on demand. The
+   * given loader is called at most once, when the frame is first accessed via frame(),
+   * frames() or buildRenderer(), or when loadFrame() is called. Concurrent accesses wait
+   * until the loader has finished.
+   *
+   * The loader must not refer to the model data or its frames and surfaces other than
+   * through its arguments, since the model data may be moved before the loader is called.
+   *
+   * @param name the frame name
+   * @param bounds the frame bounds
+   * @param loader the function that decodes the meshes of the frame
+   * @return the newly added frame
+   */
+  EntityModelFrame& addFrame(
+    std::string name, const vm::bbox3f& bounds, EntityModelFrameLoader loader);
+
+  /**
+   * Indicates whether the meshes of the frame with the given index have been decoded.
+   */
+  bool isFrameLoaded(size_t frameIndex) const;
+
+  /**
+   * Decodes the meshes of the frame with the given index if they have not been decoded
+   * yet.
+   */
+  void loadFrame(size_t frameIndex);
+
   /**
    * Adds a surface with the given name.
    *
@@ -375,14 +436,14 @@ public:
   size_t surfaceCount() const;
 
   /**
-   * Returns all frames of this model.
+   * Returns all frames of this model, decoding any frames that have not been loaded yet.
    *
    * @return the frames
    */
   const std::vector<EntityModelFrame>& frames() const;
 
   /**
-   * Returns all frames of this model.
+   * Returns all frames of this model, decoding any frames that have not been loaded yet.
    *
    * @return the frames
    */
@@ -396,7 +457,7 @@ public:
   const std::vector<EntityModelSurface>& surfaces() const;
 
   /**
-   * Returns the frame with the given name.
+   * Returns the frame with the given name, decoding it if it has not been loaded yet.
    *
    * @param name the name of the frame to find
    * @return the frame with the given name or null if no such frame was found
@@ -404,7 +465,7 @@ public:
   const EntityModelFrame* frame(const std::string& name) const;
 
   /**
-   * Returns the frame with the given index.
+   * Returns the frame with the given index, decoding it if it has not been loaded yet.
    *
    * @param index the index of the frame
    * @return the frame with the given index or null if the index is out of bounds
@@ -436,6 +497,9 @@ public:
    * @return the surface with the given name or null if no such surface was found
    */
   const EntityModelSurface* surface(const std::string& name) const;
+
+private:
+  void ensureFrameLoaded(size_t frameIndex) const;
 };
 
 class EntityModel
@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferedWriter.h"
+
+#include <ostream>
+
+namespace TrenchBroom::IO
+{
+
+BufferedWriter::BufferedWriter(std::ostream& stream, const size_t chunkSize)
+  : m_stream{stream}
+  , m_chunkSize{chunkSize}
+{
+  m_buffer.reserve(m_chunkSize);
+}
+
+BufferedWriter::~BufferedWriter()
+{
+  flush();
+}
+
+void BufferedWriter::write(const std::string_view str)
+{
+  if (str.size() >= m_chunkSize)
+  {
+    // don't copy large strings into the buffer
+    flush();
+    m_stream.write(str.data(), std::streamsize(str.size()));
+  }
+  else
+  {
+    m_buffer.append(str.data(), str.data() + str.size());
+    flushIfFull();
+  }
+}
+
+void BufferedWriter::flush()
+{
+  if (m_buffer.size() > 0)
+  {
+    m_stream.write(m_buffer.data(), std::streamsize(m_buffer.size()));
+    m_buffer.clear();
+  }
+}
+
+void BufferedWriter::flushIfFull()
+{
+  if (m_buffer.size() >= m_chunkSize)
+  {
+    flush();
+  }
+}
+
+} // namespace TrenchBroom::IO
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <iosfwd>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace TrenchBroom::IO
+{
+
+/**
+ * Collects formatted text in a memory buffer and writes it to an output stream in large
+ * chunks.
+ *
+ * Formatting is done by fmt, which formats floating point values directly into the buffer
+ * instead of going through the stream. The buffer is written to the stream with a single
+ * call whenever it exceeds the chunk size, and it is reused afterwards. The remaining
+ * contents are written when flush() is called or the writer is destroyed.
+ */
+class BufferedWriter
+{
+public:
+  static constexpr size_t DefaultChunkSize = 1024 * 1024;
+
+private:
+  std::ostream& m_stream;
+  size_t m_chunkSize;
+  fmt::memory_buffer m_buffer;
+
+public:
+  explicit BufferedWriter(std::ostream& stream, size_t chunkSize = DefaultChunkSize);
+  ~BufferedWriter();
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter(BufferedWriter&&) = delete;
+
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(BufferedWriter&&) = delete;
+
+  /**
+   * Formats the given arguments according to the given fmt format string and appends the
+   * result. The format string is checked against the arguments at compile time.
+   */
+  template <typename... Args>
+  void format(fmt::format_string<Args...> format, Args&&... args)
+  {
+    fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
+    flushIfFull();
+  }
+
+  /**
+   * Appends the given string.
+   */
+  void write(std::string_view str);
+
+  /**
+   * Writes the buffered contents to the stream.
+   */
+  void flush();
+
+private:
+  void flushIfFull();
+};
+
+} // namespace TrenchBroom::IO
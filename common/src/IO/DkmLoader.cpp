@@ -42,6 +42,7 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <string>
 
 namespace TrenchBroom::IO
@@ -446,49 +447,83 @@ auto getVertices(const DkmFrame& frame, const std::vector<DkmMeshVertex>& meshVe
   });
 }
 
-void buildFrame(
-  Assets::EntityModelData& model,
+auto getFrameBounds(const DkmFrame& frame, const std::vector<DkmMesh>& meshes)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& mesh : meshes)
+  {
+    for (const auto& meshVertex : mesh.vertices)
+    {
+      bounds.add(frame.vertex(meshVertex.vertexIndex));
+    }
+  }
+  return bounds.bounds();
+}
+
+void addFrameMesh(
   Assets::EntityModelSurface& surface,
+  Assets::EntityModelFrame& modelFrame,
   const DkmFrame& frame,
   const std::vector<DkmMesh>& meshes)
 {
   size_t vertexCount = 0;
   auto size = Renderer::IndexRangeMap::Size{};
-
   for (const auto& mesh : meshes)
   {
     vertexCount += mesh.vertices.size();
     size.inc(mesh.type);
   }
 
-  auto bounds = vm::bbox3f::builder{};
-
   auto builder =
     Renderer::IndexRangeMapBuilder<Assets::EntityModelVertex::Type>{vertexCount, size};
   for (const auto& mesh : meshes)
   {
     if (!mesh.vertices.empty())
     {
-      vertexCount += mesh.vertices.size();
       const auto vertices = getVertices(frame, mesh.vertices);
-
-      bounds.add(vertices.begin(), vertices.end(), Renderer::GetVertexComponent<0>());
-      if (mesh.type == Renderer::PrimType::TriangleStrip)
+      if (mesh.type == Renderer::PrimType::TriangleFan)
       {
-        builder.addTriangleStrip(vertices);
+        builder.addTriangleFan(vertices);
       }
-      else if (mesh.type == Renderer::PrimType::TriangleFan)
+      else if (mesh.type == Renderer::PrimType::TriangleStrip)
       {
-        builder.addTriangleFan(vertices);
+        builder.addTriangleStrip(vertices);
       }
     }
   }
 
-  auto& modelFrame = model.addFrame(frame.name, bounds.bounds());
   surface.addMesh(
     modelFrame, std::move(builder.vertices()), std::move(builder.indices()));
 }
 
+void buildFrame(
+  Assets::EntityModelData& model,
+  const size_t surfaceIndex,
+  DkmFrame frame,
+  const std::shared_ptr<const std::vector<DkmMesh>>& meshes,
+  const bool deferMesh)
+{
+  const auto bounds = getFrameBounds(frame, *meshes);
+  auto name = frame.name;
+
+  if (deferMesh)
+  {
+    // keep the packed frame vertices, the mesh is built when the frame is loaded
+    model.addFrame(
+      std::move(name),
+      bounds,
+      [=, frame = std::move(frame)](
+        Assets::EntityModelData& modelData, Assets::EntityModelFrame& modelFrame) {
+        addFrameMesh(modelData.surface(surfaceIndex), modelFrame, frame, *meshes);
+      });
+  }
+  else
+  {
+    auto& modelFrame = model.addFrame(std::move(name), bounds);
+    addFrameMesh(model.surface(surfaceIndex), modelFrame, frame, *meshes);
+  }
+}
+
 } // namespace
 
 DkmLoader::DkmLoader(std::string name, const Reader& reader, const FileSystem& fs)
@@ -556,20 +591,22 @@ Result<Assets::EntityModelData> DkmLoader::load(Logger& logger)
     auto data =
       Assets::EntityModelData{Assets::PitchType::Normal, Assets::Orientation::Oriented};
 
+    const auto surfaceIndex = data.surfaceCount();
     auto& surface = data.addSurface(m_name, frameCount);
     return loadSkins(surface, skins, m_fs, logger).transform([&]() {
-      const auto meshes = parseMeshes(
-        reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount);
+      const auto meshes = std::make_shared<const std::vector<DkmMesh>>(parseMeshes(
+        reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount));
 
       for (size_t i = 0; i < frameCount; ++i)
       {
-        const auto frame = parseFrame(
+        auto frame = parseFrame(
           reader.subReaderFromBegin(frameOffset + i * frameSize, frameSize),
           i,
           vertexCount,
           version);
 
-        buildFrame(data, surface, frame, meshes);
+        const auto deferMesh = Assets::shouldDecodeFrameOnDemand(i);
+        buildFrame(data, surfaceIndex, std::move(frame), meshes, deferMesh);
       }
 
       return std::move(data);
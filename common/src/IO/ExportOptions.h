@@ -23,6 +23,7 @@
 #include "kdl/reflection_decl.h"
 
 #include <filesystem>
+#include <functional>
 #include <variant>
 
 namespace TrenchBroom
@@ -49,6 +50,12 @@ struct ObjExportOptions
   std::filesystem::path exportPath;
   ObjMtlPathMode mtlPathMode;
 
+  /**
+   * If set, called with the fraction of the exported objects that have been written so
+   * far, and with 1.0 once the export is complete.
+   */
+  std::function<void(double)> progress = {};
+
   kdl_reflect_decl(ObjExportOptions, exportPath, mtlPathMode);
 };
 
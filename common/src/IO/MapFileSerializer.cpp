@@ -39,7 +39,7 @@
 
 #include <fmt/format.h>
 
-#include <iterator> // for std::ostreambuf_iterator
+#include <iterator> // for std::back_inserter
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -53,26 +53,27 @@ namespace IO
 class QuakeFileSerializer : public MapFileSerializer
 {
 public:
-  explicit QuakeFileSerializer(std::ostream& stream)
-    : MapFileSerializer(stream)
+  QuakeFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : MapFileSerializer(format, stream)
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
+    fmt::format_to(std::back_inserter(buffer), "\n");
   }
 
 protected:
-  void writeFacePoints(std::ostream& stream, const Model::BrushFace& face) const
+  void writeFacePoints(fmt::memory_buffer& buffer, const Model::BrushFace& face) const
   {
     const Model::BrushFace::Points& points = face.points();
 
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(buffer),
       "( {} {} {} ) ( {} {} {} ) ( {} {} {} )",
       points[0].x(),
       points[0].y(),
@@ -96,14 +97,14 @@ protected:
     return "\"" + kdl::str_escape(materialName, "\"") + "\"";
   }
 
-  void writeMaterialInfo(std::ostream& stream, const Model::BrushFace& face) const
+  void writeMaterialInfo(fmt::memory_buffer& buffer, const Model::BrushFace& face) const
   {
     const std::string& materialName = face.attributes().materialName().empty()
                                         ? Model::BrushFaceAttributes::NoMaterialName
                                         : face.attributes().materialName();
 
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(buffer),
       " {} {} {} {} {} {}",
       shouldQuoteMaterialName(materialName) ? quoteMaterialName(materialName)
                                             : materialName,
@@ -114,7 +115,8 @@ protected:
       face.attributes().yScale());
   }
 
-  void writeValveMaterialInfo(std::ostream& stream, const Model::BrushFace& face) const
+  void writeValveMaterialInfo(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const
   {
     const std::string& materialName = face.attributes().materialName().empty()
                                         ? Model::BrushFaceAttributes::NoMaterialName
@@ -123,7 +125,7 @@ protected:
     const vm::vec3 vAxis = face.vAxis();
 
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(buffer),
       " {} [ {} {} {} {} ] [ {} {} {} {} ] {} {} {}",
       shouldQuoteMaterialName(materialName) ? quoteMaterialName(materialName)
                                             : materialName,
@@ -147,30 +149,32 @@ protected:
 class Quake2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Quake2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Quake2FileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(buffer), "\n");
   }
 
 protected:
-  void writeSurfaceAttributes(std::ostream& stream, const Model::BrushFace& face) const
+  void writeSurfaceAttributes(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const
   {
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(buffer),
       " {} {} {}",
       face.resolvedSurfaceContents(),
       face.resolvedSurfaceFlags(),
@@ -181,23 +185,24 @@ protected:
 class Quake2ValveFileSerializer : public Quake2FileSerializer
 {
 public:
-  explicit Quake2ValveFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  Quake2ValveFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : Quake2FileSerializer(format, stream)
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeValveMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(buffer), "\n");
   }
 };
 
@@ -207,35 +212,36 @@ private:
   std::string SurfaceColorFormat;
 
 public:
-  explicit DaikatanaFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  DaikatanaFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : Quake2FileSerializer(format, stream)
     , SurfaceColorFormat(" %d %d %d")
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
 
     if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(buffer, face);
     }
     if (face.attributes().hasColor())
     {
-      writeSurfaceColor(stream, face);
+      writeSurfaceColor(buffer, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(buffer), "\n");
   }
 
 protected:
-  void writeSurfaceColor(std::ostream& stream, const Model::BrushFace& face) const
+  void writeSurfaceColor(fmt::memory_buffer& buffer, const Model::BrushFace& face) const
   {
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(buffer),
       " {} {} {}",
       static_cast<int>(face.resolvedColor().r()),
       static_cast<int>(face.resolvedColor().g()),
@@ -246,142 +252,118 @@ protected:
 class Hexen2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Hexen2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Hexen2FileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeMaterialInfo(stream, face);
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(stream), " 0\n"); // extra value written here
+    writeFacePoints(buffer, face);
+    writeMaterialInfo(buffer, face);
+    fmt::format_to(std::back_inserter(buffer), " 0\n"); // extra value written here
   }
 };
 
 class ValveFileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit ValveFileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  ValveFileSerializer(const Model::MapFormat format, std::ostream& stream)
+    : QuakeFileSerializer(format, stream)
   {
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveMaterialInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    writeFacePoints(buffer, face);
+    writeValveMaterialInfo(buffer, face);
+    fmt::format_to(std::back_inserter(buffer), "\n");
   }
 };
 
-std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+namespace
+{
+std::unique_ptr<MapFileSerializer> createMapFileSerializer(
   const Model::MapFormat format, std::ostream& stream)
 {
   switch (format)
   {
   case Model::MapFormat::Standard:
-    return std::make_unique<QuakeFileSerializer>(stream);
+    return std::make_unique<QuakeFileSerializer>(format, stream);
   case Model::MapFormat::Quake2:
     // TODO 2427: Implement Quake3 serializers and use them
   case Model::MapFormat::Quake3:
   case Model::MapFormat::Quake3_Legacy:
-    return std::make_unique<Quake2FileSerializer>(stream);
+    return std::make_unique<Quake2FileSerializer>(format, stream);
   case Model::MapFormat::Quake2_Valve:
   case Model::MapFormat::Quake3_Valve:
-    return std::make_unique<Quake2ValveFileSerializer>(stream);
+    return std::make_unique<Quake2ValveFileSerializer>(format, stream);
   case Model::MapFormat::Daikatana:
-    return std::make_unique<DaikatanaFileSerializer>(stream);
+    return std::make_unique<DaikatanaFileSerializer>(format, stream);
   case Model::MapFormat::Valve:
-    return std::make_unique<ValveFileSerializer>(stream);
+    return std::make_unique<ValveFileSerializer>(format, stream);
   case Model::MapFormat::Hexen2:
-    return std::make_unique<Hexen2FileSerializer>(stream);
+    return std::make_unique<Hexen2FileSerializer>(format, stream);
   case Model::MapFormat::Unknown:
     throw FileFormatException("Unknown map file format");
     switchDefault();
   }
 }
+} // namespace
 
-MapFileSerializer::MapFileSerializer(std::ostream& stream)
-  : m_line(1)
-  , m_stream(stream)
+std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+  const Model::MapFormat format, std::ostream& stream)
 {
+  return createMapFileSerializer(format, stream);
 }
 
-void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
+void MapFileSerializer::updateCachedSerializations(
+  const Model::MapFormat format, const std::vector<const Model::Node*>& rootNodes)
 {
-  ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
-
-  // collect nodes
-  std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>>
-    nodesToSerialize;
-  nodesToSerialize.reserve(rootNodes.size());
-
-  Model::Node::visitAll(
-    rootNodes,
-    kdl::overload(
-      [](auto&& thisLambda, const Model::WorldNode* world) {
-        world->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::LayerNode* layer) {
-        layer->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::GroupNode* group) {
-        group->visitChildren(thisLambda);
-      },
-      [](auto&& thisLambda, const Model::EntityNode* entity) {
-        entity->visitChildren(thisLambda);
-      },
-      [&](const Model::BrushNode* brush) { nodesToSerialize.push_back(brush); },
-      [&](const Model::PatchNode* patchNode) { nodesToSerialize.push_back(patchNode); }));
+  auto stream = std::ostringstream{};
+  createMapFileSerializer(format, stream)->updateCachedSerializations(rootNodes);
+}
 
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const Model::Node*, PrecomputedString>;
-  std::vector<Entry> result =
-    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
-      return std::visit(
-        kdl::overload(
-          [&](const Model::BrushNode* brushNode) {
-            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-          },
-          [&](const Model::PatchNode* patchNode) {
-            return Entry{patchNode, writePatch(patchNode->patch())};
-          }),
-        node);
-    });
+MapFileSerializer::MapFileSerializer(const Model::MapFormat format, std::ostream& stream)
+  : m_line(1)
+  , m_format(format)
+  , m_writer(stream)
+{
+}
 
-  // move strings into a map
-  for (auto& entry : result)
-  {
-    m_nodeToPrecomputedString.insert(std::move(entry));
-  }
+void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
+{
+  updateCachedSerializations(rootNodes);
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  m_writer.flush();
+}
 
 void MapFileSerializer::doBeginEntity(const Model::Node* /* node */)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// entity {}\n", entityNo());
+  m_writer.format("// entity {}\n", entityNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  m_writer.write("{\n");
   ++m_line;
 }
 
 void MapFileSerializer::doEndEntity(const Model::Node* node)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  m_writer.write("}\n");
   ++m_line;
   setFilePosition(node);
 }
 
 void MapFileSerializer::doEntityProperty(const Model::EntityProperty& attribute)
 {
-  fmt::format_to(
-    std::ostreambuf_iterator<char>(m_stream),
+  m_writer.format(
     "\"{}\" \"{}\"\n",
     escapeEntityProperties(attribute.key()),
     escapeEntityProperties(attribute.value()));
@@ -390,22 +372,18 @@ void MapFileSerializer::doEntityProperty(const Model::EntityProperty& attribute)
 
 void MapFileSerializer::doBrush(const Model::BrushNode* brush)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  m_writer.format("// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  m_writer.write("{\n");
   ++m_line;
 
   // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  const auto& serialization = cachedSerialization(brush);
+  m_writer.write(serialization.string);
+  m_line += serialization.lineCount;
 
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  m_writer.write("}\n");
   ++m_line;
   setFilePosition(brush);
 }
@@ -413,29 +391,100 @@ void MapFileSerializer::doBrush(const Model::BrushNode* brush)
 void MapFileSerializer::doBrushFace(const Model::BrushFace& face)
 {
   const size_t lines = 1u;
-  doWriteBrushFace(m_stream, face);
+  auto buffer = fmt::memory_buffer{};
+  doWriteBrushFace(buffer, face);
+  m_writer.write(std::string_view{buffer.data(), buffer.size()});
   face.setFilePosition(m_line, lines);
   m_line += lines;
 }
 
 void MapFileSerializer::doPatch(const Model::PatchNode* patchNode)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  m_writer.format("// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
 
   // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  const auto& serialization = cachedSerialization(patchNode);
+  m_writer.write(serialization.string);
+  m_line += serialization.lineCount;
 
   setFilePosition(patchNode);
 }
 
+void MapFileSerializer::updateCachedSerializations(
+  const std::vector<const Model::Node*>& rootNodes) const
+{
+  const auto isCached = [&](const Model::Node* node) {
+    const auto& serialization = node->cachedSerialization();
+    return serialization && serialization->format == m_format;
+  };
+
+  // collect nodes that have changed since they were last serialized
+  std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>>
+    nodesToSerialize;
+
+  Model::Node::visitAll(
+    rootNodes,
+    kdl::overload(
+      [](auto&& thisLambda, const Model::WorldNode* world) {
+        world->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::LayerNode* layer) {
+        layer->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::GroupNode* group) {
+        group->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::EntityNode* entity) {
+        entity->visitChildren(thisLambda);
+      },
+      [&](const Model::BrushNode* brush) {
+        if (!isCached(brush))
+        {
+          nodesToSerialize.push_back(brush);
+        }
+      },
+      [&](const Model::PatchNode* patchNode) {
+        if (!isCached(patchNode))
+        {
+          nodesToSerialize.push_back(patchNode);
+        }
+      }));
+
+  // serialize brushes to strings in parallel
+  using Entry = std::pair<const Model::Node*, Model::NodeSerialization>;
+  std::vector<Entry> result =
+    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
+      return std::visit(
+        kdl::overload(
+          [&](const Model::BrushNode* brushNode) {
+            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
+          },
+          [&](const Model::PatchNode* patchNode) {
+            return Entry{patchNode, writePatch(patchNode->patch())};
+          }),
+        node);
+    });
+
+  // cache the strings in the nodes
+  for (auto& [node, serialization] : result)
+  {
+    node->setCachedSerialization(
+      std::make_shared<const Model::NodeSerialization>(std::move(serialization)));
+  }
+}
+
+const Model::NodeSerialization& MapFileSerializer::cachedSerialization(
+  const Model::Node* node) const
+{
+  const auto& serialization = node->cachedSerialization();
+  ensure(
+    serialization && serialization->format == m_format,
+    "attempted to serialize a node which was not passed to doBeginFile");
+  return *serialization;
+}
+
 void MapFileSerializer::setFilePosition(const Model::Node* node)
 {
   const size_t start = startLine();
@@ -453,48 +502,49 @@ size_t MapFileSerializer::startLine()
 /**
  * Threadsafe
  */
-MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
+Model::NodeSerialization MapFileSerializer::writeBrushFaces(
   const Model::Brush& brush) const
 {
-  std::stringstream stream;
+  auto buffer = fmt::memory_buffer{};
   for (const Model::BrushFace& face : brush.faces())
   {
-    doWriteBrushFace(stream, face);
+    doWriteBrushFace(buffer, face);
   }
-  return PrecomputedString{stream.str(), brush.faces().size()};
+  return Model::NodeSerialization{
+    m_format, fmt::to_string(buffer), brush.faces().size()};
 }
 
-MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
+Model::NodeSerialization MapFileSerializer::writePatch(
   const Model::BezierPatch& patch) const
 {
   size_t lineCount = 0u;
-  std::stringstream stream;
+  auto buffer = fmt::memory_buffer{};
 
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{{\n");
+  fmt::format_to(std::back_inserter(buffer), "{{\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "patchDef2\n");
+  fmt::format_to(std::back_inserter(buffer), "patchDef2\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{{\n");
+  fmt::format_to(std::back_inserter(buffer), "{{\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{}\n", patch.materialName());
+  fmt::format_to(std::back_inserter(buffer), "{}\n", patch.materialName());
   ++lineCount;
   fmt::format_to(
-    std::ostreambuf_iterator<char>(stream),
+    std::back_inserter(buffer),
     "( {} {} 0 0 0 )\n",
     patch.pointRowCount(),
     patch.pointColumnCount());
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "(\n");
+  fmt::format_to(std::back_inserter(buffer), "(\n");
   ++lineCount;
 
   for (size_t row = 0u; row < patch.pointRowCount(); ++row)
   {
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "( ");
+    fmt::format_to(std::back_inserter(buffer), "( ");
     for (size_t col = 0u; col < patch.pointColumnCount(); ++col)
     {
       const auto& p = patch.controlPoint(row, col);
       fmt::format_to(
-        std::ostreambuf_iterator<char>(stream),
+        std::back_inserter(buffer),
         "( {} {} {} {} {} ) ",
         p[0],
         p[1],
@@ -502,18 +552,18 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
         p[3],
         p[4]);
     }
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), ")\n");
+    fmt::format_to(std::back_inserter(buffer), ")\n");
     ++lineCount;
   }
 
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), ")\n");
+  fmt::format_to(std::back_inserter(buffer), ")\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "}}\n");
+  fmt::format_to(std::back_inserter(buffer), "}}\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "}}\n");
+  fmt::format_to(std::back_inserter(buffer), "}}\n");
   ++lineCount;
 
-  return PrecomputedString{stream.str(), lineCount};
+  return Model::NodeSerialization{m_format, fmt::to_string(buffer), lineCount};
 }
 } // namespace IO
 } // namespace TrenchBroom
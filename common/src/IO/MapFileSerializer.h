@@ -19,9 +19,12 @@
 
 #pragma once
 
+#include "IO/BufferedWriter.h"
 #include "IO/NodeSerializer.h"
 #include "Model/MapFormat.h"
 
+#include <fmt/format.h>
+
 #include <iosfwd>
 #include <memory>
 #include <vector>
@@ -36,6 +39,7 @@ class BrushNode;
 class BrushFace;
 class EntityProperty;
 class Node;
+struct NodeSerialization;
 class PatchNode;
 } // namespace Model
 
@@ -47,21 +51,23 @@ private:
   using LineStack = std::vector<size_t>;
   LineStack m_startLineStack;
   size_t m_line;
-  std::ostream& m_stream;
-
-  struct PrecomputedString
-  {
-    std::string string;
-    size_t lineCount;
-  };
-  std::unordered_map<const Model::Node*, PrecomputedString> m_nodeToPrecomputedString;
+  Model::MapFormat m_format;
+  BufferedWriter m_writer;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
     Model::MapFormat format, std::ostream& stream);
 
+  /**
+   * Serializes the brushes and patches among the given nodes and their descendants whose
+   * cached serialization is missing or was created for another format, and caches the
+   * results in the nodes. The nodes are serialized in parallel.
+   */
+  static void updateCachedSerializations(
+    Model::MapFormat format, const std::vector<const Model::Node*>& rootNodes);
+
 protected:
-  explicit MapFileSerializer(std::ostream& stream);
+  MapFileSerializer(Model::MapFormat format, std::ostream& stream);
 
 private:
   void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
@@ -76,14 +82,16 @@ private:
   void doPatch(const Model::PatchNode* patchNode) override;
 
 private:
+  void updateCachedSerializations(const std::vector<const Model::Node*>& rootNodes) const;
+  const Model::NodeSerialization& cachedSerialization(const Model::Node* node) const;
   void setFilePosition(const Model::Node* node);
   size_t startLine();
 
 private: // threadsafe
   virtual void doWriteBrushFace(
-    std::ostream& stream, const Model::BrushFace& face) const = 0;
-  PrecomputedString writeBrushFaces(const Model::Brush& brush) const;
-  PrecomputedString writePatch(const Model::BezierPatch& patch) const;
+    fmt::memory_buffer& buffer, const Model::BrushFace& face) const = 0;
+  Model::NodeSerialization writeBrushFaces(const Model::Brush& brush) const;
+  Model::NodeSerialization writePatch(const Model::BezierPatch& patch) const;
 };
 } // namespace IO
 } // namespace TrenchBroom
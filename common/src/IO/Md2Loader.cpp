@@ -36,6 +36,7 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <string>
 
 namespace TrenchBroom::IO
@@ -364,50 +365,83 @@ auto getVertices(const Md2Frame& frame, const std::vector<Md2MeshVertex>& meshVe
   return vertices;
 }
 
-void buildFrame(
-  Assets::EntityModelData& model,
+auto getFrameBounds(const Md2Frame& frame, const std::vector<Md2Mesh>& meshes)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& mesh : meshes)
+  {
+    for (const auto& meshVertex : mesh.vertices)
+    {
+      bounds.add(frame.vertex(meshVertex.vertexIndex));
+    }
+  }
+  return bounds.bounds();
+}
+
+void addFrameMesh(
   Assets::EntityModelSurface& surface,
+  Assets::EntityModelFrame& modelFrame,
   const Md2Frame& frame,
   const std::vector<Md2Mesh>& meshes)
 {
   size_t vertexCount = 0;
   auto size = Renderer::IndexRangeMap::Size{};
-  for (const auto& md2Mesh : meshes)
+  for (const auto& mesh : meshes)
   {
-    vertexCount += md2Mesh.vertices.size();
-    size.inc(md2Mesh.type);
+    vertexCount += mesh.vertices.size();
+    size.inc(mesh.type);
   }
 
-  auto bounds = vm::bbox3f::builder{};
-
   auto builder =
     Renderer::IndexRangeMapBuilder<Assets::EntityModelVertex::Type>{vertexCount, size};
-  for (const auto& md2Mesh : meshes)
+  for (const auto& mesh : meshes)
   {
-    if (!md2Mesh.vertices.empty())
+    if (!mesh.vertices.empty())
     {
-      vertexCount += md2Mesh.vertices.size();
-      const auto vertices = getVertices(frame, md2Mesh.vertices);
-
-      bounds.add(
-        std::begin(vertices), std::end(vertices), Renderer::GetVertexComponent<0>());
-
-      if (md2Mesh.type == Renderer::PrimType::TriangleFan)
+      const auto vertices = getVertices(frame, mesh.vertices);
+      if (mesh.type == Renderer::PrimType::TriangleFan)
       {
         builder.addTriangleFan(vertices);
       }
-      else if (md2Mesh.type == Renderer::PrimType::TriangleStrip)
+      else if (mesh.type == Renderer::PrimType::TriangleStrip)
       {
         builder.addTriangleStrip(vertices);
       }
     }
   }
 
-  auto& modelFrame = model.addFrame(frame.name, bounds.bounds());
   surface.addMesh(
     modelFrame, std::move(builder.vertices()), std::move(builder.indices()));
 }
 
+void buildFrame(
+  Assets::EntityModelData& model,
+  const size_t surfaceIndex,
+  Md2Frame frame,
+  const std::shared_ptr<const std::vector<Md2Mesh>>& meshes,
+  const bool deferMesh)
+{
+  const auto bounds = getFrameBounds(frame, *meshes);
+  auto name = frame.name;
+
+  if (deferMesh)
+  {
+    // keep the packed frame vertices, the mesh is built when the frame is loaded
+    model.addFrame(
+      std::move(name),
+      bounds,
+      [=, frame = std::move(frame)](
+        Assets::EntityModelData& modelData, Assets::EntityModelFrame& modelFrame) {
+        addFrameMesh(modelData.surface(surfaceIndex), modelFrame, frame, *meshes);
+      });
+  }
+  else
+  {
+    auto& modelFrame = model.addFrame(std::move(name), bounds);
+    addFrameMesh(model.surface(surfaceIndex), modelFrame, frame, *meshes);
+  }
+}
+
 } // namespace
 
 Md2Loader::Md2Loader(
@@ -476,22 +510,24 @@ Result<Assets::EntityModelData> Md2Loader::load(Logger& logger)
     auto data =
       Assets::EntityModelData{Assets::PitchType::Normal, Assets::Orientation::Oriented};
 
+    const auto surfaceIndex = data.surfaceCount();
     auto& surface = data.addSurface(m_name, frameCount);
     loadSkins(surface, skins, m_palette, m_fs, logger);
 
     const auto frameSize =
       6 * sizeof(float) + Md2Layout::FrameNameLength + vertexCount * 4;
-    const auto meshes = parseMeshes(
-      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount);
+    const auto meshes = std::make_shared<const std::vector<Md2Mesh>>(parseMeshes(
+      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount));
 
     for (size_t i = 0; i < frameCount; ++i)
     {
-      const auto frame = parseFrame(
+      auto frame = parseFrame(
         reader.subReaderFromBegin(frameOffset + i * frameSize, frameSize),
         i,
         vertexCount);
 
-      buildFrame(data, surface, frame, meshes);
+      const auto deferMesh = Assets::shouldDecodeFrameOnDemand(i);
+      buildFrame(data, surfaceIndex, std::move(frame), meshes, deferMesh);
     }
 
     return data;
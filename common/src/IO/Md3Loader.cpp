@@ -30,14 +30,15 @@
 
 #include "kdl/range_utils.h"
 #include "kdl/result.h"
-#include "kdl/result_fold.h" // IWYU pragma: keep
 #include "kdl/string_format.h"
 #include "kdl/vector_utils.h"
 
 #include <fmt/core.h>
 
+#include <memory>
 #include <ranges>
 #include <string>
+#include <tuple>
 
 namespace TrenchBroom::IO
 {
@@ -68,6 +69,29 @@ struct Md3Triangle
   size_t i1, i2, i3;
 };
 
+/**
+ * The data of a surface that is shared by all frames.
+ */
+struct Md3Surface
+{
+  size_t frameCount;
+  size_t vertexCount;
+  Reader vertexReader;
+  std::shared_ptr<const std::vector<Md3Triangle>> triangles;
+  std::shared_ptr<const std::vector<vm::vec2f>> uvCoords;
+};
+
+/**
+ * The vertex positions of a surface in a particular frame.
+ */
+struct Md3FrameSurface
+{
+  size_t surfaceIndex;
+  std::vector<vm::vec3f> positions;
+  std::shared_ptr<const std::vector<Md3Triangle>> triangles;
+  std::shared_ptr<const std::vector<vm::vec2f>> uvCoords;
+};
+
 
 auto parseShaders(Reader reader, const size_t shaderCount)
 {
@@ -94,13 +118,64 @@ void loadSurfaceMaterials(
     shaderPaths | transform(loadMaterial) | kdl::to<std::vector<Assets::Material>>());
 }
 
-Result<void> parseSurfaces(
+auto parseVertexPositions(Reader reader, const size_t vertexCount)
+{
+  auto positions = std::vector<vm::vec3f>{};
+  positions.reserve(vertexCount);
+
+  for (size_t i = 0; i < vertexCount; ++i)
+  {
+    const auto x = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
+    const auto y = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
+    const auto z = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
+    /* const auto n = */ reader.readInt<int16_t>();
+    positions.emplace_back(x, y, z);
+  }
+
+  return positions;
+}
+
+auto parseUV(Reader reader, const size_t vertexCount)
+{
+  auto uv = std::vector<vm::vec2f>{};
+  uv.reserve(vertexCount);
+
+  for (size_t i = 0; i < vertexCount; ++i)
+  {
+    const auto u = reader.readFloat<float>();
+    const auto v = reader.readFloat<float>();
+    uv.emplace_back(u, v);
+  }
+
+  return uv;
+}
+
+auto parseTriangles(Reader reader, const size_t triangleCount)
+{
+  auto triangles = std::vector<Md3Triangle>{};
+  triangles.reserve(triangleCount);
+
+  for (size_t i = 0; i < triangleCount; ++i)
+  {
+    const auto i1 = reader.readSize<int32_t>();
+    const auto i2 = reader.readSize<int32_t>();
+    const auto i3 = reader.readSize<int32_t>();
+    triangles.push_back(Md3Triangle{i1, i2, i3});
+  }
+
+  return triangles;
+}
+
+Result<std::vector<Md3Surface>> parseSurfaces(
   Reader reader,
   const size_t surfaceCount,
   const size_t frameCount,
   Assets::EntityModelData& model,
   const LoadMaterialFunc& loadMaterial)
 {
+  auto surfaces = std::vector<Md3Surface>{};
+  surfaces.reserve(surfaceCount);
+
   for (size_t i = 0; i < surfaceCount; ++i)
   {
     const auto ident = reader.readInt<int32_t>();
@@ -112,15 +187,15 @@ Result<void> parseSurfaces(
 
     const auto surfaceName = reader.readString(Md3Layout::SurfaceNameLength);
     /* const auto flags = */ reader.readInt<int32_t>();
-    /* const auto frameCount = */ reader.readSize<int32_t>();
+    const auto surfaceFrameCount = reader.readSize<int32_t>();
     const auto shaderCount = reader.readSize<int32_t>();
-    /* const auto vertexCount = */ reader.readSize<int32_t>();
-    /* const auto triangleCount = */ reader.readSize<int32_t>();
+    const auto vertexCount = reader.readSize<int32_t>();
+    const auto triangleCount = reader.readSize<int32_t>();
 
-    /* const auto triangleOffset = */ reader.readSize<int32_t>();
+    const auto triangleOffset = reader.readSize<int32_t>();
     const auto shaderOffset = reader.readSize<int32_t>();
-    /* const auto uvOffset = */ reader.readSize<int32_t>();
-    /* const auto vertexOffset = */ reader.readSize<int32_t>();
+    const auto uvCoordOffset = reader.readSize<int32_t>();
+    const auto vertexOffset = reader.readSize<int32_t>();
     const auto endOffset = reader.readSize<int32_t>();
 
     const auto shaders = parseShaders(
@@ -130,53 +205,67 @@ Result<void> parseSurfaces(
     auto& surface = model.addSurface(surfaceName, frameCount);
     loadSurfaceMaterials(surface, shaders, loadMaterial);
 
+    if (surfaceFrameCount > 0)
+    {
+      // triangles and UV coordinates are the same for every frame, so we parse them once
+      auto triangles = parseTriangles(
+        reader.subReaderFromBegin(
+          triangleOffset, triangleCount * Md3Layout::TriangleLength),
+        triangleCount);
+      auto uvCoords = parseUV(
+        reader.subReaderFromBegin(uvCoordOffset, vertexCount * Md3Layout::UVLength),
+        vertexCount);
+
+      surfaces.push_back(Md3Surface{
+        surfaceFrameCount,
+        vertexCount,
+        reader.subReaderFromBegin(vertexOffset),
+        std::make_shared<const std::vector<Md3Triangle>>(std::move(triangles)),
+        std::make_shared<const std::vector<vm::vec2f>>(std::move(uvCoords)),
+      });
+    }
+    else
+    {
+      surfaces.push_back(
+        Md3Surface{0, 0, reader.subReaderFromBegin(endOffset), nullptr, nullptr});
+    }
+
     reader = reader.subReaderFromBegin(endOffset);
   }
 
-  return Result<void>{};
+  return surfaces;
 }
 
-auto& parseFrame(Reader reader, Assets::EntityModelData& model)
+auto parseFrame(Reader reader)
 {
   const auto minBounds = reader.readVec<float, 3>();
   const auto maxBounds = reader.readVec<float, 3>();
   /* const auto localOrigin = */ reader.readVec<float, 3>();
   /* const auto radius = */ reader.readFloat<float>();
-  const auto frameName = reader.readString(Md3Layout::FrameNameLength);
-
-  return model.addFrame(frameName, vm::bbox3f{minBounds, maxBounds});
-}
+  auto frameName = reader.readString(Md3Layout::FrameNameLength);
 
-auto parseVertexPositions(Reader reader, const size_t vertexCount)
-{
-  auto positions = std::vector<vm::vec3f>{};
-  positions.reserve(vertexCount);
-
-  for (size_t i = 0; i < vertexCount; ++i)
-  {
-    const auto x = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-    const auto y = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-    const auto z = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
-    /* const auto n = */ reader.readInt<int16_t>();
-    positions.emplace_back(x, y, z);
-  }
-
-  return positions;
+  return std::tuple{std::move(frameName), vm::bbox3f{minBounds, maxBounds}};
 }
 
-auto parseUV(Reader reader, const size_t vertexCount)
+auto parseFrameSurfaces(const std::vector<Md3Surface>& surfaces, const size_t frameIndex)
 {
-  auto uv = std::vector<vm::vec2f>{};
-  uv.reserve(vertexCount);
-
-  for (size_t i = 0; i < vertexCount; ++i)
+  auto frameSurfaces = std::vector<Md3FrameSurface>{};
+  for (size_t i = 0; i < surfaces.size(); ++i)
   {
-    const auto u = reader.readFloat<float>();
-    const auto v = reader.readFloat<float>();
-    uv.emplace_back(u, v);
+    const auto& surface = surfaces[i];
+    if (surface.frameCount > 0)
+    {
+      const auto frameVertexLength = surface.vertexCount * Md3Layout::VertexLength;
+      auto positions = parseVertexPositions(
+        surface.vertexReader.subReaderFromBegin(
+          frameIndex * frameVertexLength, frameVertexLength),
+        surface.vertexCount);
+
+      frameSurfaces.push_back(
+        Md3FrameSurface{i, std::move(positions), surface.triangles, surface.uvCoords});
+    }
   }
-
-  return uv;
+  return frameSurfaces;
 }
 
 auto buildVertices(
@@ -197,22 +286,6 @@ auto buildVertices(
   return vertices;
 }
 
-auto parseTriangles(Reader reader, const size_t triangleCount)
-{
-  auto triangles = std::vector<Md3Triangle>{};
-  triangles.reserve(triangleCount);
-
-  for (size_t i = 0; i < triangleCount; ++i)
-  {
-    const auto i1 = reader.readSize<int32_t>();
-    const auto i2 = reader.readSize<int32_t>();
-    const auto i3 = reader.readSize<int32_t>();
-    triangles.push_back(Md3Triangle{i1, i2, i3});
-  }
-
-  return triangles;
-}
-
 void buildFrameSurface(
   Assets::EntityModelFrame& frame,
   Assets::EntityModelSurface& surface,
@@ -247,56 +320,17 @@ void buildFrameSurface(
   surface.addMesh(frame, std::move(frameVertices), std::move(rangeMap));
 }
 
-Result<void> parseFrameSurfaces(
-  Reader reader, Assets::EntityModelFrame& frame, Assets::EntityModelData& model)
+void buildFrameSurfaces(
+  Assets::EntityModelData& model,
+  Assets::EntityModelFrame& frame,
+  const std::vector<Md3FrameSurface>& frameSurfaces)
 {
-  for (size_t i = 0; i < model.surfaceCount(); ++i)
+  for (const auto& frameSurface : frameSurfaces)
   {
-    const auto ident = reader.readInt<int32_t>();
-
-    if (ident != Md3Layout::Ident)
-    {
-      return Error{fmt::format("Unknown MD3 model surface ident: {}", ident)};
-    }
-
-    /* const auto surfaceName = */ reader.readString(Md3Layout::SurfaceNameLength);
-    /* const auto flags = */ reader.readInt<int32_t>();
-    const auto frameCount = reader.readSize<int32_t>();
-    /* const auto shaderCount = */ reader.readSize<int32_t>();
-    const auto vertexCount = reader.readSize<int32_t>();
-    const auto triangleCount = reader.readSize<int32_t>();
-
-    const auto triangleOffset = reader.readSize<int32_t>();
-    /* const auto shaderOffset = */ reader.readSize<int32_t>();
-    const auto uvCoordOffset = reader.readSize<int32_t>();
-    const auto vertexOffset = reader.readSize<int32_t>();
-    const auto endOffset = reader.readSize<int32_t>();
-
-    if (frameCount > 0)
-    {
-      const auto frameVertexLength = vertexCount * Md3Layout::VertexLength;
-      const auto frameVertexOffset = vertexOffset + frame.index() * frameVertexLength;
-
-      const auto vertexPositions = parseVertexPositions(
-        reader.subReaderFromBegin(frameVertexOffset, frameVertexLength), vertexCount);
-      const auto uvCoords = parseUV(
-        reader.subReaderFromBegin(uvCoordOffset, vertexCount * Md3Layout::UVLength),
-        vertexCount);
-      const auto vertices = buildVertices(vertexPositions, uvCoords);
-
-      const auto triangles = parseTriangles(
-        reader.subReaderFromBegin(
-          triangleOffset, triangleCount * Md3Layout::TriangleLength),
-        triangleCount);
-
-      auto& surface = model.surface(i);
-      buildFrameSurface(frame, surface, triangles, vertices);
-    }
-
-    reader = reader.subReaderFromBegin(endOffset);
+    const auto vertices = buildVertices(frameSurface.positions, *frameSurface.uvCoords);
+    buildFrameSurface(
+      frame, model.surface(frameSurface.surfaceIndex), *frameSurface.triangles, vertices);
   }
-
-  return Result<void>{};
 }
 
 } // namespace
@@ -362,19 +396,33 @@ Result<Assets::EntityModelData> Md3Loader::load(Logger&)
              frameCount,
              data,
              m_loadMaterial)
-           | kdl::and_then([&]() {
-               return kdl::vec_transform(
-                        std::views::iota(0u, frameCount),
-                        [&](const auto i) {
-                          auto& frame = parseFrame(
-                            reader.subReaderFromBegin(
-                              frameOffset + i * Md3Layout::FrameLength,
-                              Md3Layout::FrameLength),
-                            data);
-                          return parseFrameSurfaces(
-                            reader.subReaderFromBegin(surfaceOffset), frame, data);
-                        })
-                      | kdl::fold | kdl::transform([&]() { return std::move(data); });
+           | kdl::transform([&](const auto& surfaces) {
+               for (size_t i = 0; i < frameCount; ++i)
+               {
+                 auto [frameName, frameBounds] = parseFrame(reader.subReaderFromBegin(
+                   frameOffset + i * Md3Layout::FrameLength, Md3Layout::FrameLength));
+                 auto frameSurfaces = parseFrameSurfaces(surfaces, i);
+
+                 if (!Assets::shouldDecodeFrameOnDemand(i))
+                 {
+                   auto& frame = data.addFrame(std::move(frameName), frameBounds);
+                   buildFrameSurfaces(data, frame, frameSurfaces);
+                 }
+                 else
+                 {
+                   // only keep the vertex positions, the meshes are built when the
+                   // frame is loaded
+                   data.addFrame(
+                     std::move(frameName),
+                     frameBounds,
+                     [frameSurfaces = std::move(frameSurfaces)](
+                       Assets::EntityModelData& modelData,
+                       Assets::EntityModelFrame& frame) {
+                       buildFrameSurfaces(modelData, frame, frameSurfaces);
+                     });
+                 }
+               }
+               return std::move(data);
              });
   }
   catch (const ReaderException& e)
@@ -36,6 +36,7 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -302,25 +303,15 @@ auto makeFrameTriangles(
   return frameTriangles;
 }
 
-void doParseFrame(
-  Reader reader,
-  Assets::EntityModelData& model,
+void addFrameMesh(
   Assets::EntityModelSurface& surface,
+  Assets::EntityModelFrame& frame,
   const std::vector<MdlSkinTriangle>& triangles,
   const std::vector<MdlSkinVertex>& vertices,
+  const std::vector<vm::vec3f>& positions,
   const size_t skinWidth,
-  const size_t skinHeight,
-  const vm::vec3f& origin,
-  const vm::vec3f& scale)
+  const size_t skinHeight)
 {
-  reader.seekForward(MdlLayout::SimpleFrameName);
-  auto name = reader.readString(MdlLayout::SimpleFrameLength);
-
-  const auto positions = parseFrameVertices(reader, vertices, origin, scale);
-
-  auto bounds = vm::bbox3f::builder{};
-  bounds.add(positions.begin(), positions.end());
-
   const auto frameTriangles =
     makeFrameTriangles(triangles, vertices, positions, skinWidth, skinHeight);
 
@@ -331,23 +322,78 @@ void doParseFrame(
     frameTriangles.size() * 3, size};
   builder.addTriangles(frameTriangles);
 
-  auto& frame = model.addFrame(std::move(name), bounds.bounds());
   surface.addMesh(frame, std::move(builder.vertices()), std::move(builder.indices()));
 }
 
+using SharedTriangles = std::shared_ptr<const std::vector<MdlSkinTriangle>>;
+using SharedVertices = std::shared_ptr<const std::vector<MdlSkinVertex>>;
+
+void doParseFrame(
+  Reader reader,
+  Assets::EntityModelData& model,
+  const size_t surfaceIndex,
+  const SharedTriangles& triangles,
+  const SharedVertices& vertices,
+  const size_t skinWidth,
+  const size_t skinHeight,
+  const vm::vec3f& origin,
+  const vm::vec3f& scale,
+  const bool deferMesh)
+{
+  reader.seekForward(MdlLayout::SimpleFrameName);
+  auto name = reader.readString(MdlLayout::SimpleFrameLength);
+
+  auto positions = parseFrameVertices(reader, *vertices, origin, scale);
+
+  auto bounds = vm::bbox3f::builder{};
+  bounds.add(positions.begin(), positions.end());
+
+  if (deferMesh)
+  {
+    // only keep the unpacked positions, the mesh is built when the frame is loaded
+    model.addFrame(
+      std::move(name),
+      bounds.bounds(),
+      [=, positions = std::move(positions)](
+        Assets::EntityModelData& modelData, Assets::EntityModelFrame& frame) {
+        addFrameMesh(
+          modelData.surface(surfaceIndex),
+          frame,
+          *triangles,
+          *vertices,
+          positions,
+          skinWidth,
+          skinHeight);
+      });
+  }
+  else
+  {
+    auto& frame = model.addFrame(std::move(name), bounds.bounds());
+    addFrameMesh(
+      model.surface(surfaceIndex),
+      frame,
+      *triangles,
+      *vertices,
+      positions,
+      skinWidth,
+      skinHeight);
+  }
+}
+
 void parseFrame(
   Reader& reader,
   Assets::EntityModelData& model,
-  Assets::EntityModelSurface& surface,
-  const std::vector<MdlSkinTriangle>& triangles,
-  const std::vector<MdlSkinVertex>& vertices,
+  const size_t surfaceIndex,
+  const SharedTriangles& triangles,
+  const SharedVertices& vertices,
   size_t skinWidth,
   size_t skinHeight,
   const vm::vec3f& origin,
-  const vm::vec3f& scale)
+  const vm::vec3f& scale,
+  const bool deferMesh)
 {
   const auto frameLength =
-    MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertices.size() * 4;
+    MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertices->size() * 4;
 
   const auto type = reader.readInt<int32_t>();
   if (type == 0)
@@ -355,13 +401,14 @@ void parseFrame(
     doParseFrame(
       reader.subReaderFromCurrent(frameLength),
       model,
-      surface,
+      surfaceIndex,
       triangles,
       vertices,
       skinWidth,
       skinHeight,
       origin,
-      scale);
+      scale,
+      deferMesh);
     reader.seekForward(frameLength);
   }
   else
@@ -374,13 +421,14 @@ void parseFrame(
     doParseFrame(
       reader.subReaderFromCurrent(frameTimeLength, frameLength),
       model,
-      surface,
+      surfaceIndex,
       triangles,
       vertices,
       skinWidth,
       skinHeight,
       origin,
-      scale);
+      scale,
+      deferMesh);
 
     reader.seekForward(frameTimeLength + groupFrameCount * frameLength);
   }
@@ -552,19 +600,32 @@ Result<Assets::EntityModelData> MdlLoader::load(Logger& /* logger */)
 
     auto data = Assets::EntityModelData{
       Assets::PitchType::MdlInverted, Assets::Orientation::Oriented};
+    const auto surfaceIndex = data.surfaceCount();
     auto& surface = data.addSurface(m_name, frameCount);
 
     reader.seekFromBegin(MdlLayout::Skins);
     parseSkins(
       reader, surface, skinCount, skinWidth, skinHeight, flags, m_name, m_palette);
 
-    const auto vertices = parseVertices(reader, vertexCount);
-    const auto triangles = parseTriangles(reader, triangleCount);
+    const auto vertices = std::make_shared<const std::vector<MdlSkinVertex>>(
+      parseVertices(reader, vertexCount));
+    const auto triangles = std::make_shared<const std::vector<MdlSkinTriangle>>(
+      parseTriangles(reader, triangleCount));
 
     for (size_t i = 0; i < frameCount; ++i)
     {
+      const auto deferMesh = Assets::shouldDecodeFrameOnDemand(i);
       parseFrame(
-        reader, data, surface, triangles, vertices, skinWidth, skinHeight, origin, scale);
+        reader,
+        data,
+        surfaceIndex,
+        triangles,
+        vertices,
+        skinWidth,
+        skinHeight,
+        origin,
+        scale,
+        deferMesh);
     }
 
     return data;
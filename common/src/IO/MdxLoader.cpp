@@ -35,6 +35,7 @@
 
 #include <fmt/core.h>
 
+#include <memory>
 #include <string>
 
 namespace TrenchBroom::IO
@@ -360,50 +361,83 @@ auto getVertices(const MdxFrame& frame, const std::vector<MdxMeshVertex>& meshVe
   return vertices;
 }
 
-void buildFrame(
-  Assets::EntityModelData& model,
+auto getFrameBounds(const MdxFrame& frame, const std::vector<MdxMesh>& meshes)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& mesh : meshes)
+  {
+    for (const auto& meshVertex : mesh.vertices)
+    {
+      bounds.add(frame.vertex(meshVertex.vertexIndex));
+    }
+  }
+  return bounds.bounds();
+}
+
+void addFrameMesh(
   Assets::EntityModelSurface& surface,
+  Assets::EntityModelFrame& modelFrame,
   const MdxFrame& frame,
   const std::vector<MdxMesh>& meshes)
 {
   size_t vertexCount = 0;
   auto size = Renderer::IndexRangeMap::Size{};
-  for (const auto& md2Mesh : meshes)
+  for (const auto& mesh : meshes)
   {
-    vertexCount += md2Mesh.vertices.size();
-    size.inc(md2Mesh.type);
+    vertexCount += mesh.vertices.size();
+    size.inc(mesh.type);
   }
 
-  auto bounds = vm::bbox3f::builder{};
-
   auto builder =
     Renderer::IndexRangeMapBuilder<Assets::EntityModelVertex::Type>{vertexCount, size};
-  for (const auto& md2Mesh : meshes)
+  for (const auto& mesh : meshes)
   {
-    if (!md2Mesh.vertices.empty())
+    if (!mesh.vertices.empty())
     {
-      vertexCount += md2Mesh.vertices.size();
-      const auto vertices = getVertices(frame, md2Mesh.vertices);
-
-      bounds.add(
-        std::begin(vertices), std::end(vertices), Renderer::GetVertexComponent<0>());
-
-      if (md2Mesh.type == Renderer::PrimType::TriangleFan)
+      const auto vertices = getVertices(frame, mesh.vertices);
+      if (mesh.type == Renderer::PrimType::TriangleFan)
       {
         builder.addTriangleFan(vertices);
       }
-      else if (md2Mesh.type == Renderer::PrimType::TriangleStrip)
+      else if (mesh.type == Renderer::PrimType::TriangleStrip)
       {
         builder.addTriangleStrip(vertices);
       }
     }
   }
 
-  auto& modelFrame = model.addFrame(frame.name, bounds.bounds());
   surface.addMesh(
     modelFrame, std::move(builder.vertices()), std::move(builder.indices()));
 }
 
+void buildFrame(
+  Assets::EntityModelData& model,
+  const size_t surfaceIndex,
+  MdxFrame frame,
+  const std::shared_ptr<const std::vector<MdxMesh>>& meshes,
+  const bool deferMesh)
+{
+  const auto bounds = getFrameBounds(frame, *meshes);
+  auto name = frame.name;
+
+  if (deferMesh)
+  {
+    // keep the packed frame vertices, the mesh is built when the frame is loaded
+    model.addFrame(
+      std::move(name),
+      bounds,
+      [=, frame = std::move(frame)](
+        Assets::EntityModelData& modelData, Assets::EntityModelFrame& modelFrame) {
+        addFrameMesh(modelData.surface(surfaceIndex), modelFrame, frame, *meshes);
+      });
+  }
+  else
+  {
+    auto& modelFrame = model.addFrame(std::move(name), bounds);
+    addFrameMesh(model.surface(surfaceIndex), modelFrame, frame, *meshes);
+  }
+}
+
 } // namespace
 
 MdxLoader::MdxLoader(std::string name, const Reader& reader, const FileSystem& fs)
@@ -468,23 +502,25 @@ Result<Assets::EntityModelData> MdxLoader::load(Logger& logger)
 
     auto data =
       Assets::EntityModelData{Assets::PitchType::Normal, Assets::Orientation::Oriented};
+    const auto surfaceIndex = data.surfaceCount();
     auto& surface = data.addSurface(m_name, frameCount);
 
     loadSkins(surface, skins, m_fs, logger);
 
     const auto frameSize =
       6 * sizeof(float) + MdxLayout::FrameNameLength + vertexCount * 4;
-    const auto meshes = parseMeshes(
-      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount);
+    const auto meshes = std::make_shared<const std::vector<MdxMesh>>(parseMeshes(
+      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount));
 
     for (size_t i = 0; i < frameCount; ++i)
     {
-      const auto frame = parseFrame(
+      auto frame = parseFrame(
         reader.subReaderFromBegin(frameOffset + i * frameSize, frameSize),
         i,
         vertexCount);
 
-      buildFrame(data, surface, frame, meshes);
+      const auto deferMesh = Assets::shouldDecodeFrameOnDemand(i);
+      buildFrame(data, surfaceIndex, std::move(frame), meshes, deferMesh);
     }
 
     return data;
@@ -21,111 +21,173 @@
 
 #include "Assets/Material.h"
 #include "Ensure.h"
+#include "IO/BufferedWriter.h"
 #include "IO/ExportOptions.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
 #include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
 
 #include "kdl/overload.h"
+#include "kdl/parallel.h"
 
-#include <fmt/format.h>
-
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
 namespace TrenchBroom::IO
 {
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::IndexedVertex& vertex)
+namespace
 {
-  str << " " << (vertex.vertex + 1u) << "/" << (vertex.uvCoords + 1u) << "/"
-      << (vertex.normal + 1u);
-  return str;
-}
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::BrushObject& object)
+template <typename V>
+class LocalIndexMap
 {
-  str << "o entity" << object.entityNo << "_brush" << object.brushNo << "\n";
-  for (const auto& face : object.faces)
+private:
+  std::map<V, size_t> m_map;
+  std::vector<V> m_list;
+
+public:
+  std::vector<V>& list() { return m_list; }
+
+  size_t index(const V& v)
   {
-    str << "usemtl " << face.materialName << "\n";
-    str << "f";
-    for (const auto& vertex : face.verts)
+    const auto it = m_map.emplace(v, m_list.size()).first;
+    const size_t index = it->second;
+    if (index == m_list.size())
     {
-      str << " " << vertex;
+      m_list.push_back(v);
     }
-    str << "\n";
+    return index;
   }
-  return str;
-}
+};
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::PatchObject& object)
+ObjSerializer::Mesh makeBrushMesh(
+  const Model::BrushNode* brushNode, const size_t entityNo, const size_t brushNo)
 {
-  str << "o entity" << object.entityNo << "_patch" << object.patchNo << "\n";
-  str << "usemtl " << object.materialName << "\n";
-  for (const auto& quad : object.quads)
+  const auto& brush = brushNode->brush();
+
+  auto vertices = LocalIndexMap<vm::vec3>{};
+  auto uvCoords = LocalIndexMap<vm::vec2f>{};
+  auto normals = LocalIndexMap<vm::vec3>{};
+
+  auto brushObject = ObjSerializer::BrushObject{entityNo, brushNo, {}};
+  brushObject.faces.reserve(brush.faceCount());
+
+  for (const auto& face : brush.faces())
   {
-    str << "f";
-    for (const auto& vertex : quad.verts)
+    const auto normalIndex = normals.index(face.boundary().normal);
+
+    auto indexedVertices = std::vector<ObjSerializer::IndexedVertex>{};
+    indexedVertices.reserve(face.vertexCount());
+
+    for (const auto* vertex : face.vertices())
     {
-      str << " " << vertex;
+      const auto& position = vertex->position();
+      indexedVertices.push_back(ObjSerializer::IndexedVertex{
+        vertices.index(position), uvCoords.index(face.uvCoords(position)), normalIndex});
     }
-    str << "\n";
+
+    brushObject.faces.push_back(ObjSerializer::BrushFace{
+      std::move(indexedVertices), face.attributes().materialName(), face.material()});
   }
-  return str;
+
+  return {
+    std::move(brushObject),
+    std::move(vertices.list()),
+    std::move(uvCoords.list()),
+    std::move(normals.list())};
 }
 
-std::ostream& operator<<(std::ostream& str, const ObjSerializer::Object& object)
+ObjSerializer::Mesh makePatchMesh(
+  const Model::PatchNode* patchNode, const size_t entityNo, const size_t patchNo)
 {
-  std::visit(
-    kdl::overload(
-      [&](const ObjSerializer::BrushObject& brushObject) { str << brushObject; },
-      [&](const ObjSerializer::PatchObject& patchObject) { str << patchObject; }),
-    object);
-  return str;
+  const auto& patch = patchNode->patch();
+
+  auto vertices = LocalIndexMap<vm::vec3>{};
+  auto uvCoords = LocalIndexMap<vm::vec2f>{};
+  auto normals = LocalIndexMap<vm::vec3>{};
+
+  auto patchObject = ObjSerializer::PatchObject{
+    entityNo, patchNo, {}, patch.materialName(), patch.material()};
+
+  const auto& patchGrid = patchNode->grid();
+  patchObject.quads.reserve(patchGrid.quadRowCount() * patchGrid.quadColumnCount());
+
+  const auto makeIndexedVertex = [&](const auto& p) {
+    return ObjSerializer::IndexedVertex{
+      vertices.index(p.position),
+      uvCoords.index(vm::vec2f{p.uvCoords}),
+      normals.index(p.normal)};
+  };
+
+  for (size_t row = 0u; row < patchGrid.pointRowCount - 1u; ++row)
+  {
+    for (size_t col = 0u; col < patchGrid.pointColumnCount - 1u; ++col)
+    {
+      // counter clockwise order
+      patchObject.quads.push_back(ObjSerializer::PatchQuad{{
+        makeIndexedVertex(patchGrid.point(row, col)),
+        makeIndexedVertex(patchGrid.point(row + 1u, col)),
+        makeIndexedVertex(patchGrid.point(row + 1u, col + 1u)),
+        makeIndexedVertex(patchGrid.point(row, col + 1u)),
+      }});
+    }
+  }
+
+  return {
+    std::move(patchObject),
+    std::move(vertices.list()),
+    std::move(uvCoords.list()),
+    std::move(normals.list())};
 }
 
-ObjSerializer::ObjSerializer(
-  std::ostream& objStream,
-  std::ostream& mtlStream,
-  std::string mtlFilename,
-  IO::ObjExportOptions options)
-  : m_objStream{objStream}
-  , m_mtlStream{mtlStream}
-  , m_mtlFilename{std::move(mtlFilename)}
-  , m_options{std::move(options)}
+void writeIndexedVertex(
+  BufferedWriter& writer, const ObjSerializer::IndexedVertex& vertex)
 {
-  ensure(m_objStream.good(), "obj stream is good");
-  ensure(m_mtlStream.good(), "mtl stream is good");
+  writer.format(
+    "  {}/{}/{}", vertex.vertex + 1u, vertex.uvCoords + 1u, vertex.normal + 1u);
 }
 
-void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& /* rootNodes */) {}
-
-static void writeMtlFile(
-  std::ostream& str,
-  const std::vector<ObjSerializer::Object>& objects,
-  const IO::ObjExportOptions& options)
+void writeObject(BufferedWriter& writer, const ObjSerializer::BrushObject& object)
 {
-  auto usedMaterials = std::map<std::string, const Assets::Material*>{};
+  for (const auto& face : object.faces)
+  {
+    writer.format("usemtl {}\n", face.materialName);
+    writer.write("f");
+    for (const auto& vertex : face.verts)
+    {
+      writeIndexedVertex(writer, vertex);
+    }
+    writer.write("\n");
+  }
+}
 
-  for (const auto& object : objects)
+void writeObject(BufferedWriter& writer, const ObjSerializer::PatchObject& object)
+{
+  writer.format("usemtl {}\n", object.materialName);
+  for (const auto& quad : object.quads)
   {
-    std::visit(
-      kdl::overload(
-        [&](const ObjSerializer::BrushObject& brushObject) {
-          for (const auto& face : brushObject.faces)
-          {
-            usedMaterials[face.materialName] = face.material;
-          }
-        },
-        [&](const ObjSerializer::PatchObject& patchObject) {
-          usedMaterials[patchObject.materialName] = patchObject.material;
-        }),
-      object);
+    writer.write("f");
+    for (const auto& vertex : quad.verts)
+    {
+      writeIndexedVertex(writer, vertex);
+    }
+    writer.write("\n");
   }
+}
 
+void writeMtlFile(
+  std::ostream& str,
+  const std::map<std::string, const Assets::Material*>& usedMaterials,
+  const IO::ObjExportOptions& options)
+{
   const auto basePath = options.exportPath.parent_path();
   for (const auto& [materialName, material] : usedMaterials)
   {
@@ -151,159 +213,208 @@ static void writeMtlFile(
   }
 }
 
-static void writeVertices(std::ostream& str, const std::vector<vm::vec3>& vertices)
-{
-  str << "# vertices\n";
-  for (const auto& elem : vertices)
-  {
-    // no idea why I have to switch Y and Z
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "v {} {} {}\n", elem.x(), elem.z(), -elem.y());
-  }
-}
+} // namespace
 
-static void writeUVCoords(std::ostream& str, const std::vector<vm::vec2f>& uvCoords)
+ObjSerializer::ObjSerializer(
+  std::ostream& objStream,
+  std::ostream& mtlStream,
+  std::string mtlFilename,
+  IO::ObjExportOptions options)
+  : m_objWriter{std::make_unique<BufferedWriter>(objStream)}
+  , m_mtlStream{mtlStream}
+  , m_mtlFilename{std::move(mtlFilename)}
+  , m_options{std::move(options)}
 {
-  str << "# texture coordinates\n";
-  for (const auto& elem : uvCoords)
-  {
-    // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
-    // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str), "vt {} {}\n", elem.x(), -elem.y());
-  }
+  ensure(objStream.good(), "obj stream is good");
+  ensure(m_mtlStream.good(), "mtl stream is good");
 }
 
-static void writeNormals(std::ostream& str, const std::vector<vm::vec3>& normals)
+ObjSerializer::~ObjSerializer() = default;
+
+void ObjSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
 {
-  str << "# normals\n";
-  for (const auto& elem : normals)
-  {
-    // no idea why I have to switch Y and Z
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(str),
-      "vn {} {} {}\n",
-      elem.x(),
-      elem.z(),
-      -elem.y());
-  }
+  // count the brushes and patches to report the progress
+  Model::Node::visitAll(
+    rootNodes,
+    kdl::overload(
+      [](auto&& thisLambda, const Model::WorldNode* world) {
+        world->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::LayerNode* layer) {
+        layer->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::GroupNode* group) {
+        group->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::EntityNode* entity) {
+        entity->visitChildren(thisLambda);
+      },
+      [&](const Model::BrushNode*) { ++m_nodeCount; },
+      [&](const Model::PatchNode*) { ++m_nodeCount; }));
+
+  m_objWriter->format("mtllib {}\n\n", m_mtlFilename);
 }
 
-static void writeObjFile(
-  std::ostream& str,
-  const std::string mtlFilename,
-  const std::vector<vm::vec3>& vertices,
-  const std::vector<vm::vec2f>& uvCoords,
-  const std::vector<vm::vec3>& normals,
-  const std::vector<ObjSerializer::Object>& objects)
+void ObjSerializer::doEndFile()
 {
+  writePendingNodes();
+  m_objWriter->flush();
 
-  str << "mtllib " << mtlFilename << "\n";
-  writeVertices(str, vertices);
-  str << "\n";
-  writeUVCoords(str, uvCoords);
-  str << "\n";
-  writeNormals(str, normals);
-  str << "\n";
+  writeMtlFile(m_mtlStream, m_usedMaterials, m_options);
 
-  for (const auto& object : objects)
+  if (m_options.progress)
   {
-    str << object;
-    str << "\n";
+    m_options.progress(1.0);
   }
 }
 
-void ObjSerializer::doEndFile()
+void ObjSerializer::doBeginEntity(const Model::Node*) {}
+
+void ObjSerializer::doEndEntity(const Model::Node*)
 {
-  writeMtlFile(m_mtlStream, m_objects, m_options);
-  writeObjFile(
-    m_objStream,
-    m_mtlFilename,
-    m_vertices.list(),
-    m_uvCoords.list(),
-    m_normals.list(),
-    m_objects);
+  writePendingNodes();
 }
 
-void ObjSerializer::doBeginEntity(const Model::Node*) {}
-void ObjSerializer::doEndEntity(const Model::Node*) {}
 void ObjSerializer::doEntityProperty(const Model::EntityProperty&) {}
 
 void ObjSerializer::doBrush(const Model::BrushNode* brush)
 {
-  m_currentBrush = BrushObject{entityNo(), brushNo(), {}};
-  m_currentBrush->faces.reserve(brush->brush().faceCount());
-
-  // Vertex positions inserted from now on should get new indices
-  m_vertices.clearIndices();
-
-  for (const auto& face : brush->brush().faces())
+  m_pendingNodes.push_back(PendingNode{brush, entityNo(), brushNo()});
+  if (m_pendingNodes.size() >= BatchSize)
   {
-    doBrushFace(face);
+    writePendingNodes();
   }
-
-  m_objects.emplace_back(std::move(*m_currentBrush));
-  m_currentBrush = std::nullopt;
 }
 
-void ObjSerializer::doBrushFace(const Model::BrushFace& face)
+void ObjSerializer::doBrushFace(const Model::BrushFace&)
 {
-  const auto& normal = face.boundary().normal;
-  const auto normalIndex = m_normals.index(normal);
-
-  auto indexedVertices = std::vector<IndexedVertex>{};
-  indexedVertices.reserve(face.vertexCount());
+  // brush faces are written with their brushes
+}
 
-  for (const auto* vertex : face.vertices())
+void ObjSerializer::doPatch(const Model::PatchNode* patchNode)
+{
+  m_pendingNodes.push_back(PendingNode{patchNode, entityNo(), brushNo()});
+  if (m_pendingNodes.size() >= BatchSize)
   {
-    const auto& position = vertex->position();
-    const auto uvCoords = face.uvCoords(position);
+    writePendingNodes();
+  }
+}
 
-    const auto vertexIndex = m_vertices.index(position);
-    const auto uvCoordsIndex = m_uvCoords.index(uvCoords);
+void ObjSerializer::writePendingNodes()
+{
+  if (m_pendingNodes.empty())
+  {
+    return;
+  }
 
-    indexedVertices.push_back(IndexedVertex{vertexIndex, uvCoordsIndex, normalIndex});
+  const auto nodeCount = m_pendingNodes.size();
+
+  // compute the meshes in parallel, but write them in their original order
+  auto meshes =
+    kdl::vec_parallel_transform(std::move(m_pendingNodes), [](auto&& pendingNode) {
+      return std::visit(
+        kdl::overload(
+          [&](const Model::BrushNode* brushNode) {
+            return makeBrushMesh(brushNode, pendingNode.entityNo, pendingNode.objectNo);
+          },
+          [&](const Model::PatchNode* patchNode) {
+            return makePatchMesh(patchNode, pendingNode.entityNo, pendingNode.objectNo);
+          }),
+        pendingNode.node);
+    });
+  m_pendingNodes.clear();
+
+  for (auto& mesh : meshes)
+  {
+    writeMesh(std::move(mesh));
   }
 
-  m_currentBrush->faces.emplace_back(BrushFace{
-    std::move(indexedVertices), face.attributes().materialName(), face.material()});
+  m_writtenNodeCount += nodeCount;
+  if (m_options.progress && m_nodeCount > 0)
+  {
+    m_options.progress(std::min(double(m_writtenNodeCount) / double(m_nodeCount), 1.0));
+  }
 }
 
-void ObjSerializer::doPatch(const Model::PatchNode* patchNode)
+void ObjSerializer::writeMesh(Mesh mesh)
 {
-  const auto& patch = patchNode->patch();
-  auto patchObject =
-    PatchObject{entityNo(), brushNo(), {}, patch.materialName(), patch.material()};
-
-  const auto& patchGrid = patchNode->grid();
-  patchObject.quads.reserve(patchGrid.quadRowCount() * patchGrid.quadColumnCount());
-
-  // Vertex positions inserted from now on should get new indices
-  m_vertices.clearIndices();
+  auto& writer = *m_objWriter;
 
-  const auto makeIndexedVertex = [&](const auto& p) {
-    const auto positionIndex = m_vertices.index(p.position);
-    const auto uvCoordsIndex = m_uvCoords.index(vm::vec2f{p.uvCoords});
-    const auto normalIndex = m_normals.index(p.normal);
+  std::visit(
+    kdl::overload(
+      [&](const BrushObject& brushObject) {
+        writer.format("o entity{}_brush{}\n", brushObject.entityNo, brushObject.brushNo);
+      },
+      [&](const PatchObject& patchObject) {
+        writer.format("o entity{}_patch{}\n", patchObject.entityNo, patchObject.patchNo);
+      }),
+    mesh.object);
+
+  // no idea why I have to switch Y and Z
+  for (const auto& vertex : mesh.vertices)
+  {
+    writer.format("v {} {} {}\n", vertex.x(), vertex.z(), -vertex.y());
+  }
 
-    return IndexedVertex{positionIndex, uvCoordsIndex, normalIndex};
-  };
+  // map the object's UV coordinates and normals to their global indices and write the
+  // ones that are new
+  auto uvCoordsIndices = std::vector<size_t>{};
+  uvCoordsIndices.reserve(mesh.uvCoords.size());
+  for (const auto& uvCoords : mesh.uvCoords)
+  {
+    const auto count = m_uvCoords.size();
+    const auto index = m_uvCoords.index(uvCoords);
+    if (index == count)
+    {
+      // multiplying Y by -1 needed to get the UV's to appear correct in Blender and UE4
+      // (see: https://github.com/TrenchBroom/TrenchBroom/issues/2851 )
+      writer.format("vt {} {}\n", uvCoords.x(), -uvCoords.y());
+    }
+    uvCoordsIndices.push_back(index);
+  }
 
-  for (size_t row = 0u; row < patchGrid.pointRowCount - 1u; ++row)
+  auto normalIndices = std::vector<size_t>{};
+  normalIndices.reserve(mesh.normals.size());
+  for (const auto& normal : mesh.normals)
   {
-    for (size_t col = 0u; col < patchGrid.pointColumnCount - 1u; ++col)
+    const auto count = m_normals.size();
+    const auto index = m_normals.index(normal);
+    if (index == count)
     {
-      // counter clockwise order
-      patchObject.quads.push_back(PatchQuad{{
-        makeIndexedVertex(patchGrid.point(row, col)),
-        makeIndexedVertex(patchGrid.point(row + 1u, col)),
-        makeIndexedVertex(patchGrid.point(row + 1u, col + 1u)),
-        makeIndexedVertex(patchGrid.point(row, col + 1u)),
-      }});
+      // no idea why I have to switch Y and Z
+      writer.format("vn {} {} {}\n", normal.x(), normal.z(), -normal.y());
     }
+    normalIndices.push_back(index);
   }
 
-  m_objects.emplace_back(std::move(patchObject));
+  const auto remap = [&](IndexedVertex& vertex) {
+    vertex.vertex += m_vertexCount;
+    vertex.uvCoords = uvCoordsIndices[vertex.uvCoords];
+    vertex.normal = normalIndices[vertex.normal];
+  };
+
+  std::visit(
+    kdl::overload(
+      [&](BrushObject& brushObject) {
+        for (auto& face : brushObject.faces)
+        {
+          std::for_each(face.verts.begin(), face.verts.end(), remap);
+          m_usedMaterials[face.materialName] = face.material;
+        }
+        writeObject(writer, brushObject);
+      },
+      [&](PatchObject& patchObject) {
+        for (auto& quad : patchObject.quads)
+        {
+          std::for_each(quad.verts.begin(), quad.verts.end(), remap);
+        }
+        m_usedMaterials[patchObject.materialName] = patchObject.material;
+        writeObject(writer, patchObject);
+      }),
+    mesh.object);
+
+  writer.write("\n");
+  m_vertexCount += mesh.vertices.size();
 }
 
 } // namespace TrenchBroom::IO
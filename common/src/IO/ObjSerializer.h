@@ -23,13 +23,15 @@
 #include "IO/ExportOptions.h"
 #include "IO/NodeSerializer.h"
 
-#include "vm/forward.h"
+#include "vm/vec.h"
 
 #include <array>
+#include <functional>
 #include <iosfwd>
 #include <map>
-#include <optional>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -44,10 +46,22 @@ class BrushNode;
 class BrushFace;
 class EntityProperty;
 class Node;
+class PatchNode;
 } // namespace TrenchBroom::Model
 
 namespace TrenchBroom::IO
 {
+class BufferedWriter;
+
+/**
+ * Writes brushes and patches to a Wavefront OBJ file and their materials to an MTL file.
+ *
+ * The OBJ file is written while the map is being traversed. The brushes and patches are
+ * collected in batches, and the meshes of a batch are computed in parallel. Then the
+ * meshes are written one after another, each object being followed by its vertices and
+ * those UV coordinates and normals which have not been written before. Only the indices
+ * of the UV coordinates and normals and the used materials are kept until the end.
+ */
 class ObjSerializer : public NodeSerializer
 {
 public:
@@ -55,28 +69,31 @@ public:
   class IndexMap
   {
   private:
-    std::map<V, size_t> m_map;
-    std::vector<V> m_list;
-
-  public:
-    const std::vector<V>& list() const { return m_list; }
-
-    size_t index(const V& v)
+    struct Hash
     {
-      const auto it = m_map.emplace(v, m_list.size()).first;
-      const size_t index = it->second;
-      if (index == m_list.size())
+      size_t operator()(const V& v) const
       {
-        m_list.push_back(v);
+        auto result = size_t(0);
+        for (size_t i = 0; i < V::size; ++i)
+        {
+          // adding zero turns -0 into 0 so that values that compare equal hash equally
+          const auto component = v[i] + typename V::type(0);
+          result = result * 31u + std::hash<typename V::type>{}(component);
+        }
+        return result;
       }
-      return index;
-    }
+    };
+
+    std::unordered_map<V, size_t, Hash> m_map;
+
+  public:
+    size_t size() const { return m_map.size(); }
 
     /**
-     * Values inserted after this is called will not reuse indices from before this
-     * is called.
+     * Returns the index of the given value. If the value has not been inserted before, it
+     * is assigned the next index, which is equal to the previous size of this map.
      */
-    void clearIndices() { m_map.clear(); }
+    size_t index(const V& v) { return m_map.emplace(v, m_map.size()).first->second; }
   };
 
   struct IndexedVertex
@@ -116,25 +133,43 @@ public:
 
   using Object = std::variant<BrushObject, PatchObject>;
 
-  friend std::ostream& operator<<(std::ostream& str, const IndexedVertex& vertex);
-  friend std::ostream& operator<<(std::ostream& str, const BrushFace& face);
-  friend std::ostream& operator<<(std::ostream& str, const BrushObject& object);
-  friend std::ostream& operator<<(std::ostream& str, const PatchQuad& quad);
-  friend std::ostream& operator<<(std::ostream& str, const PatchObject& object);
-  friend std::ostream& operator<<(std::ostream& str, const Object& object);
+  /**
+   * An object together with its vertices, UV coordinates and normals. The indices of the
+   * object's vertices refer to these lists.
+   */
+  struct Mesh
+  {
+    Object object;
+    std::vector<vm::vec3> vertices;
+    std::vector<vm::vec2f> uvCoords;
+    std::vector<vm::vec3> normals;
+  };
 
 private:
-  std::ostream& m_objStream;
+  using NodeToWrite = std::variant<const Model::BrushNode*, const Model::PatchNode*>;
+
+  struct PendingNode
+  {
+    NodeToWrite node;
+    size_t entityNo;
+    size_t objectNo;
+  };
+
+  static constexpr size_t BatchSize = 4096;
+
+  std::unique_ptr<BufferedWriter> m_objWriter;
   std::ostream& m_mtlStream;
   std::string m_mtlFilename;
   ObjExportOptions m_options;
 
-  IndexMap<vm::vec3> m_vertices;
+  size_t m_vertexCount = 0;
   IndexMap<vm::vec2f> m_uvCoords;
   IndexMap<vm::vec3> m_normals;
+  std::map<std::string, const Assets::Material*> m_usedMaterials;
 
-  std::optional<BrushObject> m_currentBrush;
-  std::vector<Object> m_objects;
+  std::vector<PendingNode> m_pendingNodes;
+  size_t m_nodeCount = 0;
+  size_t m_writtenNodeCount = 0;
 
 public:
   ObjSerializer(
@@ -142,6 +177,7 @@ public:
     std::ostream& mtlStream,
     std::string mtlFilename,
     ObjExportOptions options);
+  ~ObjSerializer() override;
 
 private:
   void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
@@ -155,6 +191,9 @@ private:
   void doBrushFace(const Model::BrushFace& face) override;
 
   void doPatch(const Model::PatchNode* patchNode) override;
+
+  void writePendingNodes();
+  void writeMesh(Mesh mesh);
 };
 
 } // namespace TrenchBroom::IO
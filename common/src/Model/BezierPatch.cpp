@@ -25,9 +25,13 @@
 #include "kdl/reflection_impl.h"
 
 #include "vm/bbox_io.h"
-#include "vm/bezier_surface.h"
+#include "vm/constants.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
 #include "vm/vec_io.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 namespace TrenchBroom::Model
@@ -221,28 +225,103 @@ static std::vector<SurfaceControlPoints> collectAllSurfaceControlPoints(
   return result;
 }
 
-template <typename O>
-void evaluateSurface(
-  const SurfaceControlPoints& surfaceControlPoints,
-  const size_t subdivisionsPerSurface,
-  const bool isLastCol,
-  const bool isLastRow,
-  O out)
+namespace
+{
+using BernsteinWeights = std::array<FloatType, 3u>;
+
+/**
+ * Returns the values of the quadratic Bernstein basis polynomials at t = i / quadCount
+ * for i = 0, ..., quadCount.
+ */
+std::vector<BernsteinWeights> makeBernsteinTable(const size_t quadCount)
 {
-  const auto maxRow = isLastRow ? subdivisionsPerSurface + 1u : subdivisionsPerSurface;
-  const auto maxCol = isLastCol ? subdivisionsPerSurface + 1u : subdivisionsPerSurface;
+  auto result = std::vector<BernsteinWeights>{};
+  result.reserve(quadCount + 1u);
 
-  for (size_t row = 0u; row < maxRow; ++row)
+  for (size_t i = 0u; i <= quadCount; ++i)
   {
-    const auto v =
-      static_cast<FloatType>(row) / static_cast<FloatType>(subdivisionsPerSurface);
-    for (size_t col = 0u; col < maxCol; ++col)
+    const auto t = static_cast<FloatType>(i) / static_cast<FloatType>(quadCount);
+    const auto s = static_cast<FloatType>(1) - t;
+    result.push_back({s * s, static_cast<FloatType>(2) * s * t, t * t});
+  }
+
+  return result;
+}
+
+BezierPatch::Point interpolate(
+  const BernsteinWeights& weights,
+  const BezierPatch::Point& p0,
+  const BezierPatch::Point& p1,
+  const BezierPatch::Point& p2)
+{
+  return weights[0] * p0 + weights[1] * p1 + weights[2] * p2;
+}
+
+/**
+ * Returns an upper bound for the distance between the given surface and a grid that
+ * samples it at its corners only, considering only the S components of the control
+ * points starting at the given offset.
+ *
+ * The bound is derived from the second differences of the control points, which bound
+ * the second derivatives of the surface. Halving the grid spacing divides the bound by 4.
+ */
+template <size_t S>
+FloatType linearizationError(
+  const SurfaceControlPoints& surfaceControlPoints, const size_t offset)
+{
+  const auto p = [&](const size_t row, const size_t col) {
+    return vm::slice<S>(surfaceControlPoints[row][col], offset);
+  };
+
+  auto uu = FloatType(0);
+  auto vv = FloatType(0);
+  for (size_t i = 0u; i < 3u; ++i)
+  {
+    uu = std::max(uu, vm::length(p(i, 0) - FloatType(2) * p(i, 1) + p(i, 2)));
+    vv = std::max(vv, vm::length(p(0, i) - FloatType(2) * p(1, i) + p(2, i)));
+  }
+
+  auto uv = FloatType(0);
+  for (size_t row = 0u; row < 2u; ++row)
+  {
+    for (size_t col = 0u; col < 2u; ++col)
     {
-      const auto u =
-        static_cast<FloatType>(col) / static_cast<FloatType>(subdivisionsPerSurface);
-      out = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
+      const auto twist =
+        p(row, col) - p(row, col + 1) - p(row + 1, col) + p(row + 1, col + 1);
+      uv = std::max(uv, vm::length(twist));
     }
   }
+
+  return (uu + FloatType(4) * uv + vv) / FloatType(4);
+}
+} // namespace
+
+size_t BezierPatch::requiredSubdivisionsPerSurface(
+  const FloatType maxError, const size_t maxSubdivisionsPerSurface) const
+{
+  auto positionError = FloatType(0);
+  auto uvError = FloatType(0);
+  for (const auto& surfaceControlPoints : collectAllSurfaceControlPoints(
+         m_controlPoints, m_pointRowCount, m_pointColumnCount))
+  {
+    positionError =
+      std::max(positionError, linearizationError<3>(surfaceControlPoints, 0));
+    uvError = std::max(uvError, linearizationError<2>(surfaceControlPoints, 3));
+  }
+
+  // a coarser grid would distort the texture
+  if (!vm::is_zero(uvError, vm::constants<FloatType>::almost_zero()))
+  {
+    return maxSubdivisionsPerSurface;
+  }
+
+  auto subdivisionsPerSurface = size_t(0);
+  while (subdivisionsPerSurface < maxSubdivisionsPerSurface && positionError > maxError)
+  {
+    positionError /= FloatType(4);
+    ++subdivisionsPerSurface;
+  }
+  return subdivisionsPerSurface;
 }
 
 std::vector<BezierPatch::Point> BezierPatch::evaluate(
@@ -261,6 +340,9 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   auto grid = std::vector<BezierPatch::Point>{};
   grid.reserve(gridPointRowCount * gridPointColumnCount);
 
+  // the basis polynomials are the same for every surface, so they are only evaluated once
+  const auto bernsteinTable = makeBernsteinTable(quadsPerSurfaceSide);
+
   /*
   Next we sample the surfaces to compute each point in the grid.
 
@@ -307,27 +389,44 @@ std::vector<BezierPatch::Point> BezierPatch::evaluate(
   |    surface row index
   |
   value of v
+
+  The surfaces are evaluated separably: For each grid row, we first interpolate the
+  control points of each surface column at v, which yields the control points of a
+  quadratic curve per surface. Then we evaluate these curves at u for each grid point in
+  the row.
   */
 
+  // the curves at the current grid row, one per surface column
+  auto rowCurves = std::vector<std::array<BezierPatch::Point, 3u>>(surfaceColumnCount());
+
   for (size_t gridRow = 0u; gridRow < gridPointRowCount; ++gridRow)
   {
     const size_t surfaceRow =
       (gridRow > 0u ? gridRow - 1u : gridRow) / quadsPerSurfaceSide;
-    const FloatType v = static_cast<FloatType>(gridRow - surfaceRow * quadsPerSurfaceSide)
-                        / static_cast<FloatType>(quadsPerSurfaceSide);
+    const auto& vWeights = bernsteinTable[gridRow - surfaceRow * quadsPerSurfaceSide];
+
+    for (size_t surfaceCol = 0u; surfaceCol < surfaceColumnCount(); ++surfaceCol)
+    {
+      const auto& surfaceControlPoints =
+        allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
+      for (size_t i = 0u; i < 3u; ++i)
+      {
+        rowCurves[surfaceCol][i] = interpolate(
+          vWeights,
+          surfaceControlPoints[0][i],
+          surfaceControlPoints[1][i],
+          surfaceControlPoints[2][i]);
+      }
+    }
 
     for (size_t gridCol = 0u; gridCol < gridPointColumnCount; ++gridCol)
     {
       const size_t surfaceCol =
         (gridCol > 0u ? gridCol - 1u : gridCol) / quadsPerSurfaceSide;
-      const FloatType u =
-        static_cast<FloatType>(gridCol - surfaceCol * quadsPerSurfaceSide)
-        / static_cast<FloatType>(quadsPerSurfaceSide);
+      const auto& uWeights = bernsteinTable[gridCol - surfaceCol * quadsPerSurfaceSide];
 
-      const auto& surfaceControlPoints =
-        allSurfaceControlPoints[surfaceRow * surfaceColumnCount() + surfaceCol];
-      auto point = vm::evaluate_quadratic_bezier_surface(surfaceControlPoints, u, v);
-      grid.push_back(std::move(point));
+      const auto& curve = rowCurves[surfaceCol];
+      grid.push_back(interpolate(uWeights, curve[0], curve[1], curve[2]));
     }
   }
 
@@ -99,6 +99,18 @@ public: // control points:
 
   void transform(const vm::mat4x4& transformation);
 
+  /**
+   * Returns the smallest number of subdivisions per surface, but at most
+   * maxSubdivisionsPerSurface, at which the grid returned by evaluate() deviates from
+   * this patch by no more than maxError. Flat patches need fewer subdivisions than
+   * curved ones.
+   *
+   * If the texture coordinates of the control points are not linear, then the maximum is
+   * returned since a coarser grid would distort the texture.
+   */
+  size_t requiredSubdivisionsPerSurface(
+    FloatType maxError, size_t maxSubdivisionsPerSurface) const;
+
   std::vector<Point> evaluate(size_t subdivisionsPerSurface) const;
 };
 
@@ -44,6 +44,7 @@
 #include "vm/vec.h"
 #include "vm/vec_ext.h"
 
+#include <algorithm>
 #include <iterator>
 #include <set>
 #include <string>
@@ -69,22 +70,10 @@ Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
 {
-  if (m_geometry)
-  {
-    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
-    {
-      if (const auto faceIndex = faceGeometry->payload())
-      {
-        BrushFace& face = m_faces[*faceIndex];
-        face.setGeometry(faceGeometry);
-      }
-    }
-  }
+  // copied faces don't refer to any geometry
+  linkFaceGeometries();
 }
 
 Brush::Brush(Brush&& other) noexcept = default;
@@ -166,12 +155,83 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds)
   return kdl::void_success;
 }
 
+void Brush::detachGeometry()
+{
+  if (m_geometry && m_geometry.use_count() > 1)
+  {
+    m_geometry = std::make_shared<BrushGeometry>(*m_geometry, CopyCallback{});
+    linkFaceGeometries();
+  }
+}
+
+void Brush::linkFaceGeometries()
+{
+  if (m_geometry)
+  {
+    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
+    {
+      if (const auto faceIndex = faceGeometry->payload())
+      {
+        m_faces[*faceIndex].setGeometry(faceGeometry);
+      }
+    }
+  }
+}
+
+bool Brush::transformGeometry(
+  const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
+{
+  if (!m_geometry)
+  {
+    return false;
+  }
+
+  detachGeometry();
+  if (
+    !m_geometry->transform(transformation)
+    || !worldBounds.contains(m_geometry->bounds()))
+  {
+    return false;
+  }
+
+  // the vertices must still lie on the planes of the transformed faces
+  for (const BrushFaceGeometry* faceGeometry : m_geometry->faces())
+  {
+    const auto& boundary = m_faces[*faceGeometry->payload()].boundary();
+    for (const BrushHalfEdge* halfEdge : faceGeometry->boundary())
+    {
+      if (
+        boundary.point_status(halfEdge->origin()->position())
+        != vm::plane_status::inside)
+      {
+        return false;
+      }
+    }
+  }
+
+  // keep the faces in the same order as updateGeometryFromFaces does
+  BrushFace::sortFaces(m_faces);
+  for (size_t i = 0u; i < m_faces.size(); ++i)
+  {
+    m_faces[i].geometry()->setPayload(i);
+  }
+
+  assert(checkFaceLinks());
+
+  return true;
+}
+
 const vm::bbox3& Brush::bounds() const
 {
   ensure(m_geometry != nullptr, "geometry is null");
   return m_geometry->bounds();
 }
 
+bool Brush::sharesGeometryWith(const Brush& other) const
+{
+  return m_geometry != nullptr && m_geometry == other.m_geometry;
+}
+
 std::optional<size_t> Brush::findFace(const std::string& materialName) const
 {
   return kdl::vec_index_of(m_faces, [&](const BrushFace& face) {
@@ -570,6 +630,76 @@ Result<void> Brush::moveVertices(
   return doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
 }
 
+/**
+ * Returns the convex hull of the vertices of the given geometry without the vertices at
+ * the given positions.
+ *
+ * The vertices are removed from a copy of the given geometry so that the faces which are
+ * not incident to any of them are kept. Removing a vertex requires computing the convex
+ * hull of its adjacent vertices, so this is only done if the removed vertices have few
+ * adjacent vertices compared to the number of remaining vertices. Otherwise, or if
+ * removing the vertices fails, e.g. because the remaining vertices don't form a
+ * polyhedron, the convex hull of the remaining vertices is computed from scratch.
+ */
+static BrushGeometry removeVerticesFromGeometry(
+  const BrushGeometry& geometry, const std::vector<vm::vec3>& vertexPositions)
+{
+  std::vector<vm::vec3> points;
+  points.reserve(geometry.vertexCount());
+
+  std::vector<vm::vec3> removedPoints;
+  removedPoints.reserve(vertexPositions.size());
+
+  size_t adjacentVertexCount = 0u;
+  for (const auto* vertex : geometry.vertices())
+  {
+    const auto& position = vertex->position();
+    if (!kdl::vec_contains(vertexPositions, position))
+    {
+      points.push_back(position);
+    }
+    else
+    {
+      removedPoints.push_back(position);
+
+      const auto* firstEdge = vertex->leaving();
+      const auto* currentEdge = firstEdge;
+      do
+      {
+        ++adjacentVertexCount;
+        currentEdge = currentEdge->nextIncident();
+      } while (currentEdge != firstEdge);
+    }
+  }
+
+  if (2u * adjacentVertexCount <= points.size())
+  {
+    BrushGeometry result = geometry;
+    if (std::all_of(
+          std::begin(removedPoints), std::end(removedPoints), [&](const auto& position) {
+            return result.removeVertex(position);
+          }))
+    {
+      return result;
+    }
+  }
+
+  return BrushGeometry(points);
+}
+
+/**
+ * Returns the convex hull of the vertices of the given geometry and the given points.
+ *
+ * The points are added to a copy of the given geometry so that the faces which are not
+ * visible from any of them are kept.
+ */
+static BrushGeometry addVerticesToGeometry(
+  BrushGeometry geometry, std::vector<vm::vec3> points)
+{
+  geometry.addPoints(std::move(points));
+  return geometry;
+}
+
 bool Brush::canAddVertex(const vm::bbox3& worldBounds, const vm::vec3& position) const
 {
   ensure(m_geometry != nullptr, "geometry is null");
@@ -578,8 +708,7 @@ bool Brush::canAddVertex(const vm::bbox3& worldBounds, const vm::vec3& position)
     return false;
   }
 
-  BrushGeometry newGeometry(
-    kdl::vec_concat(m_geometry->vertexPositions(), std::vector<vm::vec3>({position})));
+  const BrushGeometry newGeometry = addVerticesToGeometry(*m_geometry, {position});
   return newGeometry.hasVertex(position);
 }
 
@@ -587,30 +716,11 @@ Result<void> Brush::addVertex(const vm::bbox3& worldBounds, const vm::vec3& posi
 {
   assert(canAddVertex(worldBounds, position));
 
-  BrushGeometry newGeometry(
-    kdl::vec_concat(m_geometry->vertexPositions(), std::vector<vm::vec3>({position})));
+  const BrushGeometry newGeometry = addVerticesToGeometry(*m_geometry, {position});
   const PolyhedronMatcher<BrushGeometry> matcher(*m_geometry, newGeometry);
   return updateFacesFromGeometry(worldBounds, matcher, newGeometry);
 }
 
-static BrushGeometry removeVerticesFromGeometry(
-  const BrushGeometry& geometry, const std::vector<vm::vec3>& vertexPositions)
-{
-  std::vector<vm::vec3> points;
-  points.reserve(geometry.vertexCount());
-
-  for (const auto* vertex : geometry.vertices())
-  {
-    const auto& position = vertex->position();
-    if (!kdl::vec_contains(vertexPositions, position))
-    {
-      points.push_back(position);
-    }
-  }
-
-  return BrushGeometry(points);
-}
-
 bool Brush::canRemoveVertices(
   const vm::bbox3& /* worldBounds */, const std::vector<vm::vec3>& vertexPositions) const
 {
@@ -833,35 +943,27 @@ Brush::CanMoveVerticesResult Brush::doCanMoveVertices(
   const auto vertexSet =
     std::set<vm::vec3>(std::begin(vertexPositions), std::end(vertexPositions));
 
-  std::vector<vm::vec3> remainingPoints;
-  remainingPoints.reserve(vertexCount());
-
   std::vector<vm::vec3> movingPoints;
   movingPoints.reserve(vertexCount());
 
-  std::vector<vm::vec3> resultPoints;
-  resultPoints.reserve(vertexCount());
+  std::vector<vm::vec3> movedPoints;
+  movedPoints.reserve(vertexCount());
 
   for (const auto* vertex : m_geometry->vertices())
   {
     const auto& position = vertex->position();
-    if (!vertexSet.count(position))
-    {
-      // the vertex is not moving
-      remainingPoints.push_back(position);
-      resultPoints.push_back(position);
-    }
-    else
+    if (vertexSet.count(position))
     {
       // the vertex is moving
       movingPoints.push_back(position);
-      resultPoints.push_back(position + delta);
+      movedPoints.push_back(position + delta);
     }
   }
 
-  BrushGeometry remaining(remainingPoints);
+  // Where possible, only the faces incident to the moving vertices are recomputed.
+  BrushGeometry remaining = removeVerticesFromGeometry(*m_geometry, movingPoints);
   BrushGeometry moving(movingPoints);
-  BrushGeometry result(resultPoints);
+  BrushGeometry result = addVerticesToGeometry(remaining, std::move(movedPoints));
 
   // Will the result go out of world bounds?
   if (!worldBounds.contains(result.bounds()))
@@ -946,23 +1048,20 @@ Result<void> Brush::doMoveVertices(
   ensure(!vertexPositions.empty(), "no vertex positions");
   assert(canMoveVertices(worldBounds, vertexPositions, delta));
 
-  std::vector<vm::vec3> newVertices;
-  newVertices.reserve(vertexCount());
+  std::vector<vm::vec3> movedPoints;
+  movedPoints.reserve(vertexCount());
 
   for (const auto* vertex : m_geometry->vertices())
   {
     const auto& position = vertex->position();
     if (kdl::vec_contains(vertexPositions, position))
     {
-      newVertices.push_back(position + delta);
-    }
-    else
-    {
-      newVertices.push_back(position);
+      movedPoints.push_back(position + delta);
     }
   }
 
-  BrushGeometry newGeometry(newVertices);
+  const BrushGeometry newGeometry = addVerticesToGeometry(
+    removeVerticesFromGeometry(*m_geometry, vertexPositions), std::move(movedPoints));
 
   using VecMap = std::map<vm::vec3, vm::vec3>;
   VecMap vertexMapping;
@@ -1140,8 +1239,16 @@ std::vector<Result<Brush>> Brush::subtract(
 
     for (const BrushGeometry& fragment : result)
     {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      // avoid the cost of clipping the subtrahend if the fragment cannot intersect it
+      if (fragment.bounds().intersects(subtrahend->bounds()))
+      {
+        auto subFragments = fragment.subtract(*subtrahend->m_geometry);
+        nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      }
+      else
+      {
+        nextResults.push_back(fragment);
+      }
     }
 
     result = std::move(nextResults);
@@ -1182,6 +1289,11 @@ Result<void> Brush::transform(
     }
   }
 
+  if (transformGeometry(worldBounds, transformation))
+  {
+    return kdl::void_success;
+  }
+
   return updateGeometryFromFaces(worldBounds);
 }
 
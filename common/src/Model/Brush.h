@@ -56,7 +56,14 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is shared between a brush and its copies and is only copied when one of
+   * them modifies it, see detachGeometry(). The faces of all of these brushes refer to
+   * the shared geometry. Copies may be read on other threads, so a shared geometry must
+   * not be modified at all, including the payloads of its vertices and faces.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
 
   kdl_reflect_decl(Brush, m_faces);
 
@@ -78,9 +85,33 @@ private:
 
   Result<void> updateGeometryFromFaces(const vm::bbox3& worldBounds);
 
+  /**
+   * Copies the geometry of this brush if it is shared with other brushes so that it can
+   * be modified.
+   */
+  void detachGeometry();
+
+  /**
+   * Sets the geometry of every face to the corresponding face of this brush's geometry.
+   */
+  void linkFaceGeometries();
+
+  /**
+   * Applies the given transformation to the geometry of this brush instead of rebuilding
+   * the geometry from the faces, which must already have been transformed. Returns false
+   * if the result does not match the faces, in which case the geometry must be rebuilt.
+   */
+  bool transformGeometry(const vm::bbox3& worldBounds, const vm::mat4x4& transformation);
+
 public:
   const vm::bbox3& bounds() const;
 
+  /**
+   * Indicates whether this brush shares its geometry with the given brush, which is the
+   * case if one of them is a copy of the other and neither geometry has been modified.
+   */
+  bool sharesGeometryWith(const Brush& other) const;
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& materialName) const;
   std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -318,6 +349,10 @@ public:
   /**
    * Applies the given transformation to this brush.
    *
+   * If the transformation preserves the orientation of the faces, such as translations
+   * and rotations do, the vertices are transformed directly. Otherwise, the geometry is
+   * rebuilt from the transformed faces.
+   *
    * If the brush becomes invalid, an error is returned.
    *
    * @param worldBounds the world bounds
@@ -26,6 +26,7 @@
 #include "Polyhedron.h"
 #include "Renderer/RenderUtils.h"
 
+#include "kdl/parallel.h"
 #include "kdl/range_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
@@ -36,8 +37,11 @@
 #include "vm/mat_ext.h"
 
 #include <cassert>
+#include <map>
+#include <mutex>
 #include <ranges>
 #include <string>
+#include <tuple>
 #include <utility>
 
 namespace TrenchBroom::Model
@@ -235,6 +239,63 @@ auto makeUnitCylinder(const size_t numSides, const RadiusMode radiusMode)
   }
   return vertices;
 }
+
+auto makeUnitCone(const size_t numSides, const RadiusMode radiusMode)
+{
+  auto vertices = std::vector<vm::vec3>{};
+  for (const auto& v : makeUnitCircle(numSides, radiusMode))
+  {
+    vertices.emplace_back(v.x(), v.y(), -1.0);
+  }
+  vertices.emplace_back(0.0, 0.0, 1.0);
+  return vertices;
+}
+
+enum class UnitShape
+{
+  Cylinder,
+  Cone,
+};
+
+/**
+ * Returns the convex hull of the given unit shape.
+ *
+ * Computing the convex hull of a shape with many sides is expensive, and the draw shape
+ * tool creates the same shape with different bounds whenever the mouse moves, so the
+ * convex hulls are cached and transformed by the callers.
+ */
+Polyhedron3 getUnitShape(
+  const UnitShape shape, const size_t numSides, const RadiusMode radiusMode)
+{
+  // the number of sides is chosen by the user, so the cache must be bounded
+  static constexpr auto MaxCachedShapes = size_t(32);
+
+  static auto mutex = std::mutex{};
+  static auto cache = std::map<std::tuple<UnitShape, size_t, RadiusMode>, Polyhedron3>{};
+
+  const auto key = std::tuple{shape, numSides, radiusMode};
+
+  {
+    const auto lock = std::lock_guard{mutex};
+    if (const auto it = cache.find(key); it != cache.end())
+    {
+      return it->second;
+    }
+  }
+
+  auto polyhedron = Polyhedron3{
+    shape == UnitShape::Cylinder ? makeUnitCylinder(numSides, radiusMode)
+                                 : makeUnitCone(numSides, radiusMode)};
+
+  const auto lock = std::lock_guard{mutex};
+  if (cache.size() >= MaxCachedShapes)
+  {
+    cache.clear();
+  }
+  cache.emplace(key, polyhedron);
+
+  return polyhedron;
+}
 } // namespace
 
 Result<Brush> BrushBuilder::createCylinder(
@@ -252,9 +313,16 @@ Result<Brush> BrushBuilder::createCylinder(
                          * vm::scaling_matrix(vm::vec3{0.5, 0.5, 0.5})
                          * vm::rotation_matrix(vm::vec3::pos_z(), vm::vec3::axis(axis));
 
-  const auto cylinder = makeUnitCylinder(numSides, radiusMode);
+  auto cylinder = getUnitShape(UnitShape::Cylinder, numSides, radiusMode);
+  if (cylinder.transform(transform))
+  {
+    return createBrush(cylinder, textureName);
+  }
+
+  // the transformation is degenerate, so the convex hull must be computed
   const auto vertices =
-    cylinder | std::views::transform([&](const auto& v) { return transform * v; })
+    makeUnitCylinder(numSides, radiusMode)
+    | std::views::transform([&](const auto& v) { return transform * v; })
     | kdl::to<std::vector<vm::vec3>>();
 
   return createBrush(vertices, textureName);
@@ -363,40 +431,31 @@ Result<std::vector<Brush>> BrushBuilder::createHollowCylinder(
       const auto transform =
         vm::translation_matrix(bounds.min + bounds.size() / 2.0) * rotation;
 
-      auto brushes = std::vector<Result<Brush>>{};
-      brushes.reserve(numSides);
+      auto fragments = std::vector<std::vector<vm::vec3>>{};
+      fragments.reserve(numSides);
 
       const auto sz = rotatedSize.z() / 2.0;
       for (size_t i = 0; i < numSides; ++i)
       {
         const auto fragmentVertices =
           makeHollowCylinderFragmentVertices(outerCircle, innerCircle, i, sz);
-        const auto transformedBrushVertices =
+        fragments.push_back(
           fragmentVertices
           | std::views::transform([&](const auto& v) { return transform * v; })
-          | kdl::to<std::vector<vm::vec3>>();
-
-        brushes.push_back(createBrush(transformedBrushVertices, textureName));
+          | kdl::to<std::vector<vm::vec3>>());
       }
 
-      return brushes | kdl::fold;
+      // the fragments are independent of each other, so their convex hulls are computed
+      // in parallel
+      return kdl::vec_parallel_transform(
+               std::move(fragments),
+               [&](const auto& fragmentVertices) {
+                 return createBrush(fragmentVertices, textureName);
+               })
+             | kdl::fold;
     });
 }
 
-namespace
-{
-auto makeUnitCone(const size_t numSides, const RadiusMode radiusMode)
-{
-  auto vertices = std::vector<vm::vec3>{};
-  for (const auto& v : makeUnitCircle(numSides, radiusMode))
-  {
-    vertices.emplace_back(v.x(), v.y(), -1.0);
-  }
-  vertices.emplace_back(0.0, 0.0, 1.0);
-  return vertices;
-}
-} // namespace
-
 Result<Brush> BrushBuilder::createCone(
   const vm::bbox3& bounds,
   const size_t numSides,
@@ -412,9 +471,16 @@ Result<Brush> BrushBuilder::createCone(
                          * vm::scaling_matrix(vm::vec3{0.5, 0.5, 0.5})
                          * vm::rotation_matrix(vm::vec3::pos_z(), vm::vec3::axis(axis));
 
-  const auto cone = makeUnitCone(numSides, radiusMode);
+  auto cone = getUnitShape(UnitShape::Cone, numSides, radiusMode);
+  if (cone.transform(transform))
+  {
+    return createBrush(cone, textureName);
+  }
+
+  // the transformation is degenerate, so the convex hull must be computed
   const auto vertices =
-    cone | std::views::transform([&](const auto& v) { return transform * v; })
+    makeUnitCone(numSides, radiusMode)
+    | std::views::transform([&](const auto& v) { return transform * v; })
     | kdl::to<std::vector<vm::vec3>>();
 
   return createBrush(vertices, textureName);
@@ -109,6 +109,38 @@ const Brush& BrushNode::brush() const
   return m_brush;
 }
 
+/**
+ * Indicates whether the given brushes have the same geometry and differ at most in the UV
+ * coordinates of their faces.
+ */
+static bool differOnlyInUVCoords(const Brush& lhs, const Brush& rhs)
+{
+  if (!lhs.sharesGeometryWith(rhs))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.faceCount(); ++i)
+  {
+    const auto& lhsFace = lhs.face(i);
+    const auto& rhsFace = rhs.face(i);
+
+    auto lhsAttributes = lhsFace.attributes();
+    lhsAttributes.setOffset(rhsFace.attributes().offset());
+    lhsAttributes.setScale(rhsFace.attributes().scale());
+    lhsAttributes.setRotation(rhsFace.attributes().rotation());
+
+    if (
+      lhsFace.material() != rhsFace.material() || lhsAttributes != rhsFace.attributes()
+      || lhsFace.selected() != rhsFace.selected())
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 Brush BrushNode::setBrush(Brush brush)
 {
   const auto nodeChange = NotifyNodeChange{*this};
@@ -119,7 +151,14 @@ Brush BrushNode::setBrush(Brush brush)
 
   updateSelectedFaceCount();
   invalidateIssues();
-  invalidateVertexCache();
+  if (differOnlyInUVCoords(m_brush, brush))
+  {
+    m_brushRendererBrushCache->invalidateUVCoords();
+  }
+  else
+  {
+    invalidateVertexCache();
+  }
 
   return brush;
 }
@@ -148,7 +187,11 @@ void BrushNode::updateFaceTags(const size_t faceIndex, TagManager& tagManager)
 
 void BrushNode::setFaceMaterial(const size_t faceIndex, Assets::Material* material)
 {
-  m_brush.face(faceIndex).setMaterial(material);
+  if (m_brush.face(faceIndex).setMaterial(material))
+  {
+    // the serialized surface attributes are resolved against the material
+    invalidateCachedSerialization();
+  }
 
   invalidateIssues();
   invalidateVertexCache();
@@ -413,6 +456,11 @@ GroupNode* BrushNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void BrushNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void BrushNode::invalidateVertexCache()
 {
   m_brushRendererBrushCache->invalidateVertexCache();
@@ -270,6 +270,11 @@ GroupNode* EntityNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void EntityNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void EntityNode::invalidateBounds()
 {
   m_cachedBounds = std::nullopt;
@@ -111,6 +111,7 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdDidChange(const std::string& oldLinkId) override;
 
 private:
   void invalidateBounds();
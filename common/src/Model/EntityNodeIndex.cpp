@@ -19,16 +19,22 @@
 
 #include "EntityNodeIndex.h"
 
+#include "Error.h"
 #include "Macros.h"
 #include "Model/Entity.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
 
 #include "kdl/compact_trie.h"
+#include "kdl/result.h"
+#include "kdl/string_compare.h"
+#include "kdl/trigram_index.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <iterator>
 #include <list>
+#include <regex>
 #include <string>
 #include <vector>
 
@@ -36,6 +42,11 @@ namespace TrenchBroom
 {
 namespace Model
 {
+struct EntityNodeIndexQuery::Regex
+{
+  std::regex regex;
+};
+
 EntityNodeIndexQuery EntityNodeIndexQuery::exact(const std::string& pattern)
 {
   return EntityNodeIndexQuery(Type_Exact, pattern);
@@ -51,13 +62,64 @@ EntityNodeIndexQuery EntityNodeIndexQuery::numbered(const std::string& pattern)
   return EntityNodeIndexQuery(Type_Numbered, pattern);
 }
 
+EntityNodeIndexQuery EntityNodeIndexQuery::substring(const std::string& pattern)
+{
+  return EntityNodeIndexQuery(Type_Substring, pattern);
+}
+
+EntityNodeIndexQuery EntityNodeIndexQuery::glob(const std::string& pattern)
+{
+  return EntityNodeIndexQuery(Type_Glob, pattern);
+}
+
+Result<EntityNodeIndexQuery> EntityNodeIndexQuery::regex(const std::string& pattern)
+{
+  try
+  {
+    auto query = EntityNodeIndexQuery(Type_Regex, pattern);
+    query.m_regex = std::make_shared<const Regex>(Regex{std::regex{pattern}});
+    return query;
+  }
+  catch (const std::regex_error& e)
+  {
+    return Error{"Invalid regular expression '" + pattern + "': " + e.what()};
+  }
+}
+
 EntityNodeIndexQuery EntityNodeIndexQuery::any()
 {
   return EntityNodeIndexQuery(Type_Any);
 }
 
+EntityNodeIndexQuery::Type EntityNodeIndexQuery::type() const
+{
+  return m_type;
+}
+
+bool EntityNodeIndexQuery::matches(const std::string_view str) const
+{
+  switch (m_type)
+  {
+  case Type_Exact:
+    return str == m_pattern;
+  case Type_Prefix:
+    return kdl::cs::str_is_prefix(str, m_pattern);
+  case Type_Numbered:
+    return isNumberedProperty(m_pattern, str);
+  case Type_Substring:
+    return kdl::cs::str_contains(str, m_pattern);
+  case Type_Glob:
+    return kdl::cs::str_matches_glob(str, m_pattern);
+  case Type_Regex:
+    return std::regex_search(str.begin(), str.end(), m_regex->regex);
+  case Type_Any:
+    return true;
+    switchDefault();
+  }
+}
+
 std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
-  const EntityNodeStringIndex& index) const
+  const EntityNodeStringIndex& index, const EntityNodeTrigramIndex& trigramIndex) const
 {
   std::set<EntityNodeBase*> result;
   switch (m_type)
@@ -71,6 +133,16 @@ std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
   case Type_Numbered:
     index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
     break;
+  case Type_Substring:
+  case Type_Glob:
+  case Type_Regex: {
+    const auto substrings = requiredSubstrings();
+    trigramIndex.find_matches(
+      std::vector<std::string_view>{substrings.begin(), substrings.end()},
+      [&](const std::string_view str) { return matches(str); },
+      std::inserter(result, std::end(result)));
+    break;
+  }
   case Type_Any:
     break;
     switchDefault();
@@ -89,6 +161,15 @@ bool EntityNodeIndexQuery::execute(
     return node->entity().hasPropertyWithPrefix(m_pattern, value);
   case Type_Numbered:
     return node->entity().hasNumberedProperty(m_pattern, value);
+  case Type_Substring:
+  case Type_Glob:
+  case Type_Regex:
+    return std::any_of(
+      node->entity().properties().begin(),
+      node->entity().properties().end(),
+      [&](const auto& property) {
+        return property.value() == value && matches(property.key());
+      });
   case Type_Any:
     return true;
     switchDefault();
@@ -107,6 +188,12 @@ std::vector<Model::EntityProperty> EntityNodeIndexQuery::execute(
     return entity.propertiesWithPrefix(m_pattern);
   case Type_Numbered:
     return entity.numberedProperties(m_pattern);
+  case Type_Substring:
+  case Type_Glob:
+  case Type_Regex:
+    return kdl::vec_filter(entity.properties(), [&](const auto& property) {
+      return matches(property.key());
+    });
   case Type_Any:
     return entity.properties();
     switchDefault();
@@ -119,9 +206,98 @@ EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, const std::string& p
 {
 }
 
+namespace
+{
+std::vector<std::string> globLiterals(const std::string& pattern)
+{
+  auto result = std::vector<std::string>{};
+  auto current = std::string{};
+  for (size_t i = 0; i < pattern.size(); ++i)
+  {
+    const auto c = pattern[i];
+    if (c == '\\' && i + 1 < pattern.size())
+    {
+      current.push_back(pattern[++i]);
+    }
+    else if (c == '*' || c == '?' || c == '%')
+    {
+      result.push_back(std::move(current));
+      current.clear();
+    }
+    else
+    {
+      current.push_back(c);
+    }
+  }
+  result.push_back(std::move(current));
+  return result;
+}
+
+/**
+ * Only handles regular expressions without alternatives, groups, character classes,
+ * bounded repetitions and escapes. For all others, no literals are returned, and every
+ * string is a candidate.
+ */
+std::vector<std::string> regexLiterals(const std::string& pattern)
+{
+  if (pattern.find_first_of("|()[]{}\\") != std::string::npos)
+  {
+    return {};
+  }
+
+  auto result = std::vector<std::string>{};
+  auto current = std::string{};
+  for (const auto c : pattern)
+  {
+    if (c == '*' || c == '?')
+    {
+      // the preceding character is optional
+      if (!current.empty())
+      {
+        current.pop_back();
+      }
+      result.push_back(std::move(current));
+      current.clear();
+    }
+    else if (c == '.' || c == '^' || c == '$' || c == '+')
+    {
+      result.push_back(std::move(current));
+      current.clear();
+    }
+    else
+    {
+      current.push_back(c);
+    }
+  }
+  result.push_back(std::move(current));
+  return result;
+}
+} // namespace
+
+std::vector<std::string> EntityNodeIndexQuery::requiredSubstrings() const
+{
+  switch (m_type)
+  {
+  case Type_Exact:
+  case Type_Prefix:
+  case Type_Numbered:
+  case Type_Substring:
+    return {m_pattern};
+  case Type_Glob:
+    return globLiterals(m_pattern);
+  case Type_Regex:
+    return regexLiterals(m_pattern);
+  case Type_Any:
+    return {};
+    switchDefault();
+  }
+}
+
 EntityNodeIndex::EntityNodeIndex()
   : m_keyIndex(std::make_unique<EntityNodeStringIndex>())
   , m_valueIndex(std::make_unique<EntityNodeStringIndex>())
+  , m_keyTrigramIndex(std::make_unique<EntityNodeTrigramIndex>())
+  , m_valueTrigramIndex(std::make_unique<EntityNodeTrigramIndex>())
 {
 }
 
@@ -144,6 +320,8 @@ void EntityNodeIndex::addProperty(
 {
   m_keyIndex->insert(key, node);
   m_valueIndex->insert(value, node);
+  m_keyTrigramIndex->insert(key, node);
+  m_valueTrigramIndex->insert(value, node);
 }
 
 void EntityNodeIndex::removeProperty(
@@ -151,6 +329,8 @@ void EntityNodeIndex::removeProperty(
 {
   m_keyIndex->remove(key, node);
   m_valueIndex->remove(value, node);
+  m_keyTrigramIndex->remove(key, node);
+  m_valueTrigramIndex->remove(value, node);
 }
 
 std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
@@ -180,6 +360,28 @@ std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
   return result;
 }
 
+std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
+  const EntityNodeIndexQuery& keyQuery, const EntityNodeIndexQuery& valueQuery) const
+{
+  // select candidates using the more specific query, then match them exactly
+  const auto candidates = valueQuery.type() == EntityNodeIndexQuery::Type_Any
+                            ? keyQuery.execute(*m_keyIndex, *m_keyTrigramIndex)
+                            : valueQuery.execute(*m_valueIndex, *m_valueTrigramIndex);
+
+  auto result = std::vector<EntityNodeBase*>{};
+  std::copy_if(
+    candidates.begin(),
+    candidates.end(),
+    std::back_inserter(result),
+    [&](const auto* node) {
+      const auto& properties = node->entity().properties();
+      return std::any_of(properties.begin(), properties.end(), [&](const auto& property) {
+        return keyQuery.matches(property.key()) && valueQuery.matches(property.value());
+      });
+    });
+  return result;
+}
+
 std::vector<std::string> EntityNodeIndex::allKeys() const
 {
   std::vector<std::string> result;
@@ -192,7 +394,8 @@ std::vector<std::string> EntityNodeIndex::allValuesForKeys(
 {
   std::vector<std::string> result;
 
-  const std::set<EntityNodeBase*> nameResult = keyQuery.execute(*m_keyIndex);
+  const std::set<EntityNodeBase*> nameResult =
+    keyQuery.execute(*m_keyIndex, *m_keyTrigramIndex);
   for (const auto node : nameResult)
   {
     const auto matchingProperties = keyQuery.execute(node);
@@ -19,11 +19,15 @@
 
 #pragma once
 
+#include "Result.h"
+
 #include "kdl/compact_trie_forward.h"
+#include "kdl/trigram_index_forward.h"
 
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom
@@ -34,6 +38,7 @@ class EntityNodeBase;
 class EntityProperty;
 
 using EntityNodeStringIndex = kdl::compact_trie<EntityNodeBase*>;
+using EntityNodeTrigramIndex = kdl::trigram_index<EntityNodeBase*>;
 
 class EntityNodeIndexQuery
 {
@@ -43,25 +48,50 @@ public:
     Type_Exact,
     Type_Prefix,
     Type_Numbered,
+    Type_Substring,
+    Type_Glob,
+    Type_Regex,
     Type_Any
   } Type;
 
 private:
+  // defined in the implementation file so that this header does not depend on <regex>
+  struct Regex;
+
   Type m_type;
   std::string m_pattern;
+  std::shared_ptr<const Regex> m_regex;
 
 public:
   static EntityNodeIndexQuery exact(const std::string& pattern);
   static EntityNodeIndexQuery prefix(const std::string& pattern);
   static EntityNodeIndexQuery numbered(const std::string& pattern);
+  static EntityNodeIndexQuery substring(const std::string& pattern);
+  static EntityNodeIndexQuery glob(const std::string& pattern);
+  static Result<EntityNodeIndexQuery> regex(const std::string& pattern);
   static EntityNodeIndexQuery any();
 
-  std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
+  Type type() const;
+
+  /**
+   * Indicates whether the given string matches this query. Substring, glob and regex
+   * queries are case sensitive.
+   */
+  bool matches(std::string_view str) const;
+
+  std::set<EntityNodeBase*> execute(
+    const EntityNodeStringIndex& index, const EntityNodeTrigramIndex& trigramIndex) const;
   bool execute(const EntityNodeBase* node, const std::string& value) const;
   std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
 
 private:
   explicit EntityNodeIndexQuery(Type type, const std::string& pattern = "");
+
+  /**
+   * Returns substrings that every string matching this query must contain. Used to select
+   * candidates from a trigram index.
+   */
+  std::vector<std::string> requiredSubstrings() const;
 };
 
 class EntityNodeIndex
@@ -69,6 +99,8 @@ class EntityNodeIndex
 private:
   std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
   std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+  std::unique_ptr<EntityNodeTrigramIndex> m_keyTrigramIndex;
+  std::unique_ptr<EntityNodeTrigramIndex> m_valueTrigramIndex;
 
 public:
   EntityNodeIndex();
@@ -84,6 +116,13 @@ public:
 
   std::vector<EntityNodeBase*> findEntityNodes(
     const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
+
+  /**
+   * Finds the entity nodes that have a property whose key matches the given key query and
+   * whose value matches the given value query.
+   */
+  std::vector<EntityNodeBase*> findEntityNodes(
+    const EntityNodeIndexQuery& keyQuery, const EntityNodeIndexQuery& valueQuery) const;
   std::vector<std::string> allKeys() const;
   std::vector<std::string> allValuesForKeys(const EntityNodeIndexQuery& keyQuery) const;
 };
@@ -308,6 +308,11 @@ GroupNode* GroupNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void GroupNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void GroupNode::invalidateBounds()
 {
   m_boundsValid = false;
@@ -33,7 +33,10 @@
 #include "kdl/result_fold.h"
 #include "kdl/zip_iterator.h"
 
+#include <algorithm>
+#include <optional>
 #include <string_view>
+#include <typeinfo>
 #include <unordered_map>
 
 namespace TrenchBroom::Model
@@ -42,22 +45,37 @@ namespace TrenchBroom::Model
 std::vector<Node*> collectNodesWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
-  return collectNodesAndDescendants(
-    nodes,
-    kdl::overload(
-      [&](const GroupNode* groupNode) { return groupNode->linkId() == linkId; },
-      [&](const EntityNode* entityNode) { return entityNode->linkId() == linkId; },
-      [&](const BrushNode* brushNode) { return brushNode->linkId() == linkId; },
-      [&](const PatchNode* patchNode) { return patchNode->linkId() == linkId; }));
+  auto result = std::vector<Node*>{};
+  for (auto* node : nodes)
+  {
+    if (const auto* worldNode = dynamic_cast<const WorldNode*>(node))
+    {
+      // avoid traversing the entire world
+      result = kdl::vec_concat(std::move(result), worldNode->findNodesWithLinkId(linkId));
+    }
+    else
+    {
+      result = kdl::vec_concat(
+        std::move(result),
+        collectNodesAndDescendants(
+          std::vector<Node*>{node},
+          kdl::overload(
+            [&](const GroupNode* groupNode) { return groupNode->linkId() == linkId; },
+            [&](const EntityNode* entityNode) { return entityNode->linkId() == linkId; },
+            [&](const BrushNode* brushNode) { return brushNode->linkId() == linkId; },
+            [&](const PatchNode* patchNode) { return patchNode->linkId() == linkId; })));
+    }
+  }
+  return result;
 }
 
 std::vector<GroupNode*> collectGroupsWithLinkId(
   const std::vector<Node*>& nodes, const std::string& linkId)
 {
   return kdl::vec_static_cast<GroupNode*>(
-    collectNodesAndDescendants(nodes, kdl::overload([&](const GroupNode* groupNode) {
-                                 return groupNode->linkId() == linkId;
-                               })));
+    kdl::vec_filter(collectNodesWithLinkId(nodes, linkId), [](const auto* node) {
+      return dynamic_cast<const GroupNode*>(node) != nullptr;
+    }));
 }
 
 std::vector<std::string> collectLinkedGroupIds(const std::vector<Node*>& nodes)
@@ -403,19 +421,15 @@ void preserveGroupNames(
       [](const PatchNode*) {}));
 }
 
-void preserveEntityProperties(
-  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+void preserveEntityProperties(Entity& clonedEntity, const Entity& correspondingEntity)
 {
   if (
-    clonedEntityNode.entity().protectedProperties().empty()
-    && correspondingEntityNode.entity().protectedProperties().empty())
+    clonedEntity.protectedProperties().empty()
+    && correspondingEntity.protectedProperties().empty())
   {
     return;
   }
 
-  auto clonedEntity = clonedEntityNode.entity();
-  const auto& correspondingEntity = correspondingEntityNode.entity();
-
   const auto allProtectedProperties = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
     clonedEntity.protectedProperties(), correspondingEntity.protectedProperties()));
 
@@ -430,7 +444,20 @@ void preserveEntityProperties(
       clonedEntity.addOrUpdateProperty(propertyKey, *propertyValue);
     }
   }
+}
+
+void preserveEntityProperties(
+  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+{
+  if (
+    clonedEntityNode.entity().protectedProperties().empty()
+    && correspondingEntityNode.entity().protectedProperties().empty())
+  {
+    return;
+  }
 
+  auto clonedEntity = clonedEntityNode.entity();
+  preserveEntityProperties(clonedEntity, correspondingEntityNode.entity());
   clonedEntityNode.setEntity(std::move(clonedEntity));
 }
 
@@ -464,6 +491,222 @@ void preserveEntityProperties(
 }
 } // namespace
 
+namespace
+{
+
+Result<std::pair<Node*, std::vector<std::unique_ptr<Node>>>> updateLinkedGroup(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const vm::mat4x4& transformation,
+  const vm::bbox3& worldBounds)
+{
+  return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
+         | kdl::transform([&](auto newChildren) {
+             const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetGroupNode.children());
+             preserveGroupNames(newChildren, linkIdToNodeMap);
+             preserveEntityProperties(newChildren, linkIdToNodeMap);
+             return std::pair{
+               static_cast<Node*>(&targetGroupNode), std::move(newChildren)};
+           });
+}
+
+/**
+ * Collects the pairs of corresponding descendants of the given source and target nodes.
+ * Two nodes correspond if they have the same type, the same link ID and the same
+ * position among the children of their corresponding parents.
+ *
+ * Returns false if the structure of the target node's subtree differs from the source
+ * node's subtree.
+ */
+bool collectCorrespondingNodes(
+  const Node& sourceNode,
+  Node& targetNode,
+  std::vector<std::pair<const Node*, Node*>>& correspondingNodes)
+{
+  if (sourceNode.childCount() != targetNode.childCount())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < sourceNode.childCount(); ++i)
+  {
+    const auto* sourceChild = sourceNode.children()[i];
+    auto* targetChild = targetNode.children()[i];
+
+    const auto* sourceObject = dynamic_cast<const Object*>(sourceChild);
+    const auto* targetObject = dynamic_cast<const Object*>(targetChild);
+    if (
+      !sourceObject || !targetObject || typeid(*sourceChild) != typeid(*targetChild)
+      || sourceObject->linkId() != targetObject->linkId())
+    {
+      return false;
+    }
+
+    correspondingNodes.emplace_back(sourceChild, targetChild);
+    if (!collectCorrespondingNodes(*sourceChild, *targetChild, correspondingNodes))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Indicates whether transforming the given source brush by the given transformation
+ * yields the given target brush. Only the faces are transformed, which is much cheaper
+ * than transforming the entire brush since its geometry need not be rebuilt.
+ */
+bool isTransformedBrush(
+  const Brush& sourceBrush, const Brush& targetBrush, const vm::mat4x4& transformation)
+{
+  if (sourceBrush.faceCount() != targetBrush.faceCount())
+  {
+    return false;
+  }
+
+  // the faces must be transformed with their geometry, just like Brush::transform does
+  auto brush = sourceBrush;
+  for (auto& face : brush.faces())
+  {
+    if (!face.transform(transformation, true).is_success())
+    {
+      return false;
+    }
+
+    // the faces of the target brush may have been reordered; the UV axes are not
+    // considered by BrushFace's equality operator
+    const auto& targetFaces = targetBrush.faces();
+    if (std::none_of(targetFaces.begin(), targetFaces.end(), [&](const auto& targetFace) {
+          return targetFace == face && targetFace.uAxis() == face.uAxis()
+                 && targetFace.vAxis() == face.vAxis();
+        }))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Result<std::optional<NodeContents>> checkWorldBounds(
+  NodeContents contents, const vm::bbox3& bounds, const vm::bbox3& worldBounds)
+{
+  if (!worldBounds.contains(bounds))
+  {
+    return Error{"Updating a linked node would exceed world bounds"};
+  }
+  return std::optional<NodeContents>{std::move(contents)};
+}
+
+/**
+ * Computes the new contents of the given target node from its corresponding source node.
+ * Returns an empty optional if the target node is up to date.
+ */
+Result<std::optional<NodeContents>> updateCorrespondingNode(
+  const Node& sourceNode,
+  const Node& targetNode,
+  const vm::mat4x4& transformation,
+  const vm::bbox3& worldBounds)
+{
+  using UpdateResult = Result<std::optional<NodeContents>>;
+
+  return sourceNode.accept(kdl::overload(
+    [](const WorldNode*) -> UpdateResult {
+      ensure(false, "Linked group structure is valid");
+    },
+    [](const LayerNode*) -> UpdateResult {
+      ensure(false, "Linked group structure is valid");
+    },
+    [&](const GroupNode* sourceGroupNode) -> UpdateResult {
+      const auto& targetGroup = static_cast<const GroupNode&>(targetNode).group();
+
+      auto group = sourceGroupNode->group();
+      group.transform(transformation);
+      group.setName(targetGroup.name());
+      if (group == targetGroup)
+      {
+        return std::optional<NodeContents>{};
+      }
+      return std::optional<NodeContents>{NodeContents{std::move(group)}};
+    },
+    [&](const EntityNode* sourceEntityNode) -> UpdateResult {
+      const auto& targetEntity = static_cast<const EntityNode&>(targetNode).entity();
+
+      const auto updateAngleProperty =
+        sourceEntityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
+      auto entity = sourceEntityNode->entity();
+      entity.transform(transformation, updateAngleProperty);
+      preserveEntityProperties(entity, targetEntity);
+      if (entity == targetEntity)
+      {
+        return std::optional<NodeContents>{};
+      }
+
+      const auto bounds = EntityNode{entity}.logicalBounds();
+      return checkWorldBounds(NodeContents{std::move(entity)}, bounds, worldBounds);
+    },
+    [&](const BrushNode* sourceBrushNode) -> UpdateResult {
+      const auto& targetBrush = static_cast<const BrushNode&>(targetNode).brush();
+      if (isTransformedBrush(sourceBrushNode->brush(), targetBrush, transformation))
+      {
+        return std::optional<NodeContents>{};
+      }
+
+      auto brush = sourceBrushNode->brush();
+      return brush.transform(worldBounds, transformation, true)
+             | kdl::or_else([](const auto&) -> Result<void> {
+                 return Error{"Failed to transform a linked node"};
+               })
+             | kdl::and_then([&]() {
+                 const auto bounds = brush.bounds();
+                 return checkWorldBounds(
+                   NodeContents{std::move(brush)}, bounds, worldBounds);
+               });
+    },
+    [&](const PatchNode* sourcePatchNode) -> UpdateResult {
+      const auto& targetPatch = static_cast<const PatchNode&>(targetNode).patch();
+
+      auto patch = sourcePatchNode->patch();
+      patch.transform(transformation);
+      if (patch == targetPatch)
+      {
+        return std::optional<NodeContents>{};
+      }
+
+      const auto bounds = patch.bounds();
+      return checkWorldBounds(NodeContents{std::move(patch)}, bounds, worldBounds);
+    }));
+}
+
+Result<std::vector<std::pair<Node*, NodeContents>>> updateCorrespondingNodes(
+  const std::vector<std::pair<const Node*, Node*>>& correspondingNodes,
+  const vm::mat4x4& transformation,
+  const vm::bbox3& worldBounds)
+{
+  auto updateResults =
+    kdl::vec_parallel_transform(correspondingNodes, [&](const auto& nodePair) {
+      return updateCorrespondingNode(
+        *nodePair.first, *nodePair.second, transformation, worldBounds);
+    });
+
+  return std::move(updateResults) | kdl::fold
+         | kdl::transform([&](auto newContents) {
+             auto result = std::vector<std::pair<Node*, NodeContents>>{};
+             for (size_t i = 0; i < newContents.size(); ++i)
+             {
+               if (newContents[i])
+               {
+                 result.emplace_back(
+                   correspondingNodes[i].second, std::move(*newContents[i]));
+               }
+             }
+             return result;
+           });
+}
+
+} // namespace
+
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const GroupNode& sourceGroupNode,
   const std::vector<GroupNode*>& targetGroupNodes,
@@ -483,20 +726,65 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
            [&](auto* targetGroupNode) {
              const auto transformation =
                targetGroupNode->group().transformation() * *invertedSourceTransformation;
-             return cloneAndTransformChildren(
-                      sourceGroupNode, worldBounds, transformation)
-                    | kdl::transform([&](auto newChildren) {
-                        const auto linkIdToNodeMap =
-                          makeLinkIdToNodeMap(targetGroupNode->children());
-                        preserveGroupNames(newChildren, linkIdToNodeMap);
-                        preserveEntityProperties(newChildren, linkIdToNodeMap);
-                        return std::pair{
-                          static_cast<Node*>(targetGroupNode), std::move(newChildren)};
-                      });
+             return updateLinkedGroup(
+               sourceGroupNode, *targetGroupNode, transformation, worldBounds);
            })
          | kdl::fold;
 }
 
+Result<LinkedNodeUpdates> updateLinkedNodes(
+  const GroupNode& sourceGroupNode,
+  const std::vector<GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds)
+{
+  const auto& sourceGroup = sourceGroupNode.group();
+  const auto invertedSourceTransformation = vm::invert(sourceGroup.transformation());
+  if (!invertedSourceTransformation)
+  {
+    return Error{"Group transformation is not invertible"};
+  }
+
+  const auto targetGroupNodesToUpdate =
+    kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
+  return kdl::vec_transform(
+           targetGroupNodesToUpdate,
+           [&](auto* targetGroupNode) -> Result<LinkedNodeUpdates> {
+             const auto transformation =
+               targetGroupNode->group().transformation() * *invertedSourceTransformation;
+
+             auto correspondingNodes = std::vector<std::pair<const Node*, Node*>>{};
+             if (collectCorrespondingNodes(
+                   sourceGroupNode, *targetGroupNode, correspondingNodes))
+             {
+               return updateCorrespondingNodes(
+                        correspondingNodes, transformation, worldBounds)
+                      | kdl::transform([](auto contentsToSwap) {
+                          return LinkedNodeUpdates{{}, std::move(contentsToSwap)};
+                        });
+             }
+
+             return updateLinkedGroup(
+                      sourceGroupNode, *targetGroupNode, transformation, worldBounds)
+                    | kdl::transform([](auto childrenToReplace) {
+                        auto result = LinkedNodeUpdates{};
+                        result.childrenToReplace.push_back(std::move(childrenToReplace));
+                        return result;
+                      });
+           })
+         | kdl::fold | kdl::transform([](auto updatesPerTargetGroup) {
+             auto result = LinkedNodeUpdates{};
+             for (auto& updates : updatesPerTargetGroup)
+             {
+               result.childrenToReplace = kdl::vec_concat(
+                 std::move(result.childrenToReplace),
+                 std::move(updates.childrenToReplace));
+               result.contentsToSwap = kdl::vec_concat(
+                 std::move(result.contentsToSwap), std::move(updates.contentsToSwap));
+             }
+             return result;
+           });
+}
+
 namespace
 {
 
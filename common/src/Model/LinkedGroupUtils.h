@@ -25,6 +25,7 @@
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/NodeContents.h"
 #include "Model/NodeVisitor.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
@@ -137,6 +138,45 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const std::vector<Model::GroupNode*>& targetGroupNodes,
   const vm::bbox3& worldBounds);
 
+/**
+ * The changes that update a set of linked groups, see updateLinkedNodes.
+ */
+struct LinkedNodeUpdates
+{
+  /**
+   * Pairs of target group nodes and the new children that should replace their children.
+   */
+  UpdateLinkedGroupsResult childrenToReplace;
+
+  /**
+   * Pairs of nodes in the target groups and the new contents that should replace their
+   * contents.
+   */
+  std::vector<std::pair<Node*, NodeContents>> contentsToSwap;
+};
+
+/**
+ * Updates the given target group nodes from the given source group node, but only
+ * replaces what has changed.
+ *
+ * If the descendants of a target group node correspond to the descendants of the source
+ * group node, i.e. they have the same types, link IDs and positions in the tree, then
+ * only those target nodes whose corresponding source node has changed receive new
+ * contents. A source node has changed if transforming it into the target group yields
+ * different contents than those of its corresponding node. The other target nodes are
+ * left untouched.
+ *
+ * If the structure of a target group node differs from that of the source group node,
+ * e.g. because a node was added to the source group, then its children are replaced as
+ * in updateLinkedGroups.
+ *
+ * This operation fails under the same conditions as updateLinkedGroups.
+ */
+Result<LinkedNodeUpdates> updateLinkedNodes(
+  const GroupNode& sourceGroupNode,
+  const std::vector<Model::GroupNode*>& targetGroupNodes,
+  const vm::bbox3& worldBounds);
+
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes);
 
 /**
@@ -123,6 +123,7 @@ void Node::cloneAttributes(Node& node) const
 {
   node.setVisibilityState(m_visibilityState);
   node.setLockState(m_lockState);
+  node.setCachedSerialization(m_cachedSerialization);
 }
 
 std::vector<Node*> Node::clone(
@@ -473,6 +474,7 @@ void Node::nodeWillChange()
     m_parent->childWillChange(this);
   }
   invalidateIssues();
+  invalidateCachedSerialization();
 }
 
 void Node::nodeDidChange()
@@ -806,6 +808,22 @@ bool Node::containsLine(const size_t lineNumber) const
   return lineNumber >= m_lineNumber && lineNumber < m_lineNumber + m_lineCount;
 }
 
+const std::shared_ptr<const NodeSerialization>& Node::cachedSerialization() const
+{
+  return m_cachedSerialization;
+}
+
+void Node::setCachedSerialization(
+  std::shared_ptr<const NodeSerialization> serialization) const
+{
+  m_cachedSerialization = std::move(serialization);
+}
+
+void Node::invalidateCachedSerialization() const
+{
+  m_cachedSerialization.reset();
+}
+
 std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& validators)
 {
   validateIssues(validators);
@@ -881,6 +899,12 @@ void Node::removeFromIndex(
   doRemoveFromIndex(node, key, value);
 }
 
+void Node::updateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  doUpdateLinkIdIndex(node, oldLinkId, newLinkId);
+}
+
 Node* Node::doCloneRecursively(const vm::bbox3& worldBounds) const
 {
   auto* clone = Node::clone(worldBounds);
@@ -969,4 +993,13 @@ void Node::doRemoveFromIndex(
   }
 }
 
+void Node::doUpdateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  if (m_parent)
+  {
+    m_parent->updateLinkIdIndex(node, oldLinkId, newLinkId);
+  }
+}
+
 } // namespace TrenchBroom::Model
@@ -22,6 +22,7 @@
 #include "FloatType.h"
 #include "Model/IssueType.h"
 #include "Model/LockState.h"
+#include "Model/MapFormat.h"
 #include "Model/NodeVisitor.h"
 #include "Model/Tag.h"
 #include "Model/VisibilityState.h"
@@ -56,6 +57,16 @@ struct NodePath
   kdl_reflect_decl(NodePath, indices);
 };
 
+/**
+ * The text that a map file serializer has written for a node in the given map format.
+ */
+struct NodeSerialization
+{
+  MapFormat format;
+  std::string string;
+  size_t lineCount;
+};
+
 class Node : public Taggable
 {
 private:
@@ -74,6 +85,8 @@ private:
   mutable size_t m_lineNumber = 0;
   mutable size_t m_lineCount = 0;
 
+  mutable std::shared_ptr<const NodeSerialization> m_cachedSerialization;
+
   mutable std::vector<std::unique_ptr<Issue>> m_issues;
   mutable bool m_issuesValid = false;
   IssueType m_hiddenIssues = 0;
@@ -348,6 +361,18 @@ public: // file position
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
+public: // serialization cache
+  /**
+   * Returns the text that was cached when this node was last serialized, or null if this
+   * node has changed since then. Clones share the cached text of the original node.
+   */
+  const std::shared_ptr<const NodeSerialization>& cachedSerialization() const;
+  void setCachedSerialization(
+    std::shared_ptr<const NodeSerialization> serialization) const;
+
+protected:
+  void invalidateCachedSerialization() const;
+
 public: // issue management
   std::vector<const Issue*> issues(const std::vector<const Validator*>& validators);
 
@@ -502,6 +527,9 @@ protected: // index management
   void removeFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
 
+  void updateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId);
+
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
   virtual const vm::bbox3& doGetLogicalBounds() const = 0;
@@ -567,6 +595,9 @@ private: // subclassing interface
     EntityNodeBase* node, const std::string& key, const std::string& value);
   virtual void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value);
+
+  virtual void doUpdateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId);
 };
 
 } // namespace TrenchBroom::Model
@@ -22,6 +22,8 @@
 #include "Model/GroupNode.h"
 #include "Uuid.h"
 
+#include <utility>
+
 namespace TrenchBroom::Model
 {
 
@@ -39,7 +41,11 @@ const std::string& Object::linkId() const
 
 void Object::setLinkId(std::string linkId)
 {
-  m_linkId = std::move(linkId);
+  if (linkId != m_linkId)
+  {
+    const auto oldLinkId = std::exchange(m_linkId, std::move(linkId));
+    doLinkIdDidChange(oldLinkId);
+  }
 }
 
 void Object::cloneLinkId(Object& object) const
@@ -37,6 +37,7 @@
 #include "kdl/zip_iterator.h"
 
 #include "vm/bbox_io.h"
+#include "vm/constants.h"
 #include "vm/intersection.h"
 #include "vm/vec_io.h"
 
@@ -47,7 +48,12 @@
 namespace TrenchBroom::Model
 {
 
-constexpr static size_t DefaultSubdivisionsPerSurface = 3u;
+constexpr static size_t MaxSubdivisionsPerSurface = 3u;
+
+// Only flat patches are tessellated with fewer subdivisions. A fixed world space error
+// bound would flatten large, gently curved patches, so any curvature requires the full
+// number of subdivisions.
+constexpr static FloatType MaxGridError = vm::constants<FloatType>::almost_zero();
 
 kdl_reflect_impl(PatchGrid::Point);
 
@@ -293,11 +299,34 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
     gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
 }
 
+namespace
+{
+PatchGrid makeAdaptivePatchGrid(const BezierPatch& patch)
+{
+  return makePatchGrid(
+    patch,
+    patch.requiredSubdivisionsPerSurface(MaxGridError, MaxSubdivisionsPerSurface));
+}
+
+bool hasSameControlPoints(const BezierPatch& lhs, const BezierPatch& rhs)
+{
+  return lhs.pointRowCount() == rhs.pointRowCount()
+         && lhs.pointColumnCount() == rhs.pointColumnCount()
+         && lhs.controlPoints() == rhs.controlPoints();
+}
+} // namespace
+
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
   : m_patch{std::move(patch)}
-  , m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)}
+  , m_grid{makeAdaptivePatchGrid(m_patch)}
+{
+}
+
+PatchNode::PatchNode(BezierPatch patch, PatchGrid grid)
+  : m_patch{std::move(patch)}
+  , m_grid{std::move(grid)}
 {
 }
 
@@ -338,7 +367,13 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
   const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
-  m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+
+  // the grid only depends on the control points, so it is kept if only the material
+  // changed
+  if (!hasSameControlPoints(m_patch, previousPatch))
+  {
+    m_grid = makeAdaptivePatchGrid(m_patch);
+  }
   return previousPatch;
 }
 
@@ -387,7 +422,8 @@ FloatType PatchNode::doGetProjectedArea(const vm::axis::type axis) const
 
 Node* PatchNode::doClone(const vm::bbox3&) const
 {
-  auto result = std::make_unique<PatchNode>(m_patch);
+  // the clone shares the control points, so there is no need to tessellate it again
+  auto result = std::unique_ptr<PatchNode>{new PatchNode{m_patch, m_grid}};
   cloneLinkId(*result);
   return result.release();
 }
@@ -478,6 +514,11 @@ GroupNode* PatchNode::doGetContainingGroup()
   return findContainingGroup(this);
 }
 
+void PatchNode::doLinkIdDidChange(const std::string& oldLinkId)
+{
+  updateLinkIdIndex(this, oldLinkId, linkId());
+}
+
 void PatchNode::doAcceptTagVisitor(TagVisitor& visitor)
 {
   visitor.visit(*this);
@@ -73,6 +73,10 @@ std::vector<vm::vec3> computeGridNormals(
 // public for testing
 PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
 
+/**
+ * The grid of a patch node is tessellated adaptively: flat patches are subdivided less
+ * than curved ones. The grid is kept until the control points of the patch change.
+ */
 class PatchNode : public Node, public Object
 {
 public:
@@ -85,6 +89,10 @@ private:
 public:
   explicit PatchNode(BezierPatch patch);
 
+private:
+  PatchNode(BezierPatch patch, PatchGrid grid);
+
+public:
   EntityNodeBase* entity();
   const EntityNodeBase* entity() const;
 
@@ -125,6 +133,7 @@ private: // implement Object interface
   Node* doGetContainer() override;
   LayerNode* doGetContainingLayer() override;
   GroupNode* doGetContainingGroup() override;
+  void doLinkIdDidChange(const std::string& oldLinkId) override;
 
 private: // implement Taggable interface
   void doAcceptTagVisitor(TagVisitor& visitor) override;
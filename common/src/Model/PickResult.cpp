@@ -31,6 +31,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
 
 namespace TrenchBroom
 {
@@ -54,11 +56,13 @@ public:
 
 PickResult::PickResult(std::shared_ptr<CompareHits> compare)
   : m_compare(std::move(compare))
+  , m_filter(HitFilters::any())
+  , m_limit(std::numeric_limits<size_t>::max())
 {
 }
 
 PickResult::PickResult()
-  : m_compare(std::make_shared<CompareHitsByDistance>())
+  : PickResult(std::make_shared<CompareHitsByDistance>())
 {
 }
 
@@ -75,6 +79,22 @@ PickResult PickResult::bySize(const vm::axis::type axis)
   return PickResult(std::make_shared<CompareHitsBySize>(axis));
 }
 
+PickResult PickResult::query(HitFilter filter, const size_t limit)
+{
+  assert(limit > 0);
+
+  auto result = byDistance();
+  result.m_filter = std::move(filter);
+  result.m_limit = std::max(limit, size_t(1));
+  return result;
+}
+
+bool PickResult::isComplete(const FloatType distance) const
+{
+  return m_hits.size() >= m_limit
+         && distance > m_hits[m_limit - 1].distance() + vm::C::almost_zero();
+}
+
 bool PickResult::empty() const
 {
   return m_hits.empty();
@@ -93,10 +113,24 @@ void PickResult::addHit(const Hit& hit)
   {
     return;
   }
+  if (!m_filter(hit) || isComplete(hit.distance()))
+  {
+    return;
+  }
   ensure(m_compare.get() != nullptr, "compare is null");
   auto pos = std::upper_bound(
     std::begin(m_hits), std::end(m_hits), hit, CompareWrapper(m_compare.get()));
   m_hits.insert(pos, hit);
+
+  if (m_hits.size() > m_limit)
+  {
+    const auto maxDistance = m_hits[m_limit - 1].distance() + vm::C::almost_zero();
+    const auto end = std::find_if(
+      std::next(std::begin(m_hits), long(m_limit)),
+      std::end(m_hits),
+      [&](const auto& h) { return h.distance() > maxDistance; });
+    m_hits.erase(end, std::end(m_hits));
+  }
 }
 
 const std::vector<Hit>& PickResult::all() const
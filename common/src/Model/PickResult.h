@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "FloatType.h"
 #include "Macros.h"
 #include "Model/Hit.h"
 #include "Model/HitFilter.h"
@@ -40,6 +41,8 @@ class PickResult
 private:
   std::vector<Hit> m_hits;
   std::shared_ptr<CompareHits> m_compare;
+  HitFilter m_filter;
+  size_t m_limit;
   class CompareWrapper;
 
 public:
@@ -53,6 +56,23 @@ public:
   static PickResult byDistance();
   static PickResult bySize(vm::axis::type axis);
 
+  /**
+   * Creates a pick result that orders its hits by distance and only retains the given
+   * number of closest hits that match the given filter. Hits that do not match the
+   * filter are discarded when they are added.
+   *
+   * Hits that are as close as the last retained hit are kept as well so that first()
+   * can still choose among them by their error.
+   */
+  static PickResult query(HitFilter filter, size_t limit = 1);
+
+  /**
+   * Indicates whether adding hits at the given distance or further away cannot change
+   * this pick result anymore. This is only ever the case for a pick result created by
+   * query() which already contains the requested number of hits.
+   */
+  bool isComplete(FloatType distance) const;
+
   bool empty() const;
   size_t size() const;
 
@@ -22,6 +22,8 @@
 #include "Ensure.h"
 #include "Error.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
 
 #include "kdl/reflection_impl.h"
 #include "kdl/result.h"
@@ -32,7 +34,6 @@
 #include "vm/vec_io.h"
 
 #include <cassert>
-#include <istream>
 
 namespace TrenchBroom::Model
 {
@@ -167,10 +168,8 @@ std::vector<vm::vec3f> segmentizePoints(const std::vector<vm::vec3f>& points)
 
 kdl_reflect_impl(PointTrace);
 
-Result<PointTrace> loadPointFile(std::istream& stream)
+Result<PointTrace> loadPointFile(const std::string_view str)
 {
-  const auto str = std::string{std::istreambuf_iterator<char>{stream}, {}};
-
   auto points = std::vector<vm::vec3f>{};
   vm::parse_all<float, 3>(str, std::back_inserter(points));
 
@@ -189,4 +188,12 @@ Result<PointTrace> loadPointFile(std::istream& stream)
   return PointTrace{std::move(points)};
 }
 
+Result<PointTrace> loadPointFile(const std::filesystem::path& path)
+{
+  return IO::Disk::openFile(path) | kdl::and_then([](const auto& file) {
+           const auto reader = file->reader().buffer();
+           return loadPointFile(reader.stringView());
+         });
+}
+
 } // namespace TrenchBroom::Model
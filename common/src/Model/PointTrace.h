@@ -26,7 +26,8 @@
 #include "vm/forward.h"
 #include "vm/vec.h"
 
-#include <iosfwd>
+#include <filesystem>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom::Model
@@ -53,5 +54,6 @@ public:
   kdl_reflect_decl(PointTrace, m_points, m_current);
 };
 
-Result<PointTrace> loadPointFile(std::istream& stream);
+Result<PointTrace> loadPointFile(std::string_view str);
+Result<PointTrace> loadPointFile(const std::filesystem::path& path);
 } // namespace TrenchBroom::Model
@@ -1554,6 +1554,23 @@ private:
    */
   void updateBounds();
 
+public: // Transformation
+  /**
+   * Transforms the position of every vertex by the given affine transformation, then
+   * corrects the vertex positions as in correctVertexPositions and updates the bounds of
+   * this polyhedron.
+   *
+   * The topology of this polyhedron is not changed, so this is only possible if the
+   * transformation preserves the orientation of the faces, i.e., if the determinant of
+   * its linear part is positive. If that is not the case, this polyhedron is not
+   * modified and false is returned. If the transformation makes an edge shorter than the
+   * minimum edge length, false is returned, too, and this polyhedron must be discarded.
+   *
+   * @param transformation the transformation to apply
+   * @return true if the transformation was applied and this polyhedron is still valid
+   */
+  bool transform(const vm::mat<T, 4, 4>& transformation);
+
 public: // Vertex correction and edge healing
   /**
    * Rounds each component of position of every vertex to the nearest integer if the
@@ -1681,7 +1698,7 @@ public:
 
   /* ====================== Implementation in Polyhedron_ConvexHull.h
    * ====================== */
-private: // Convex hull; adding and removing points
+public: // Convex hull; adding and removing points
   /**
    * Adds the given points to this polyhedron. The effect of adding the given points to a
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
@@ -1692,9 +1709,33 @@ private: // Convex hull; adding and removing points
    * Therefore, the result of calling this method is different from the result of
    * repeatedly calling addPoint() for every point in the given vector.
    *
+   * Only the faces that are visible from the given points are modified.
+   *
    * @param points the points to add to this polyhedron
    */
   void addPoints(std::vector<vm::vec<T, 3>> points);
+
+  /**
+   * Removes the vertex at the given position from this polyhedron. The effect of removing
+   * a vertex is that the resulting polyhedron is the convex hull of the remaining
+   * vertices.
+   *
+   * The new faces of the convex hull only have vertices that are adjacent to the removed
+   * vertex. Therefore, the vertex is removed by clipping this polyhedron with those faces
+   * of the convex hull of its adjacent vertices that separate it from the remaining
+   * vertices. Only the faces incident to the removed vertex are modified.
+   *
+   * The vertex is not removed if this polyhedron is not a convex volume, if the remaining
+   * vertices do not form a convex volume, or if one of the new faces would be coplanar
+   * with an existing face. In that case, this polyhedron remains unchanged, and the
+   * caller should compute the convex hull of the remaining vertices instead.
+   *
+   * @param position the position of the vertex to remove
+   * @return true if the vertex was removed and false otherwise
+   */
+  bool removeVertex(const vm::vec<T, 3>& position);
+
+private:
   /**
    * Adds the given point to this polyhedron. The effect of adding the given point to a
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
@@ -30,6 +30,7 @@
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
 #include <list>
 #include <unordered_set>
 #include <vector>
@@ -58,7 +59,10 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
   {
     points = kdl::vec_sort_and_remove_duplicates(std::move(points));
 
-    const auto planeEpsilon = computePlaneEpsilon(points);
+    // when adding to a non empty polyhedron, use the same epsilon as if the polyhedron
+    // had been created from its vertices and the given points
+    const auto planeEpsilon = computePlaneEpsilon(
+      empty() ? points : kdl::vec_concat(vertexPositions(), points));
     for (const auto& point : points)
     {
       addPoint(point, planeEpsilon);
@@ -108,6 +112,115 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPoint(
   return result;
 }
 
+template <typename T, typename FP, typename VP>
+bool Polyhedron<T, FP, VP>::removeVertex(const vm::vec<T, 3>& position)
+{
+  assert(checkInvariant());
+
+  if (!polyhedron())
+  {
+    return false;
+  }
+
+  const Vertex* vertex = findVertexByPosition(position);
+  if (vertex == nullptr)
+  {
+    return false;
+  }
+
+  std::vector<vm::vec<T, 3>> adjacentPositions;
+  const HalfEdge* firstEdge = vertex->leaving();
+  const HalfEdge* currentEdge = firstEdge;
+  do
+  {
+    adjacentPositions.push_back(currentEdge->destination()->position());
+    currentEdge = currentEdge->nextIncident();
+  } while (currentEdge != firstEdge);
+
+  const auto epsilon = vm::constants<T>::point_status_epsilon();
+  const auto anyRemainingVertex = [&](const auto& pred) {
+    return std::any_of(m_vertices.begin(), m_vertices.end(), [&](const Vertex* v) {
+      return v != vertex && pred(v->position());
+    });
+  };
+
+  // The new faces are those faces of the convex hull of the adjacent vertices which have
+  // the removed vertex above them and no remaining vertex above them. Since the convex
+  // hull of the adjacent vertices may be a polygon, both orientations of its faces are
+  // considered. If the adjacent vertices are coplanar, which is always the case if there
+  // are only three of them, their plane is the only candidate and computing their convex
+  // hull is not necessary.
+  std::vector<vm::plane<T, 3>> candidates;
+  const auto adjacentPlane =
+    vm::from_points(adjacentPositions.begin(), adjacentPositions.end());
+  if (
+    adjacentPlane
+    && std::all_of(
+      adjacentPositions.begin(), adjacentPositions.end(), [&](const auto& p) {
+        return adjacentPlane->point_status(p, epsilon) == vm::plane_status::inside;
+      }))
+  {
+    candidates = {*adjacentPlane, adjacentPlane->flip()};
+  }
+  else
+  {
+    const Polyhedron adjacentHull(std::move(adjacentPositions));
+    for (const Face* face : adjacentHull.faces())
+    {
+      candidates.push_back(face->plane());
+      candidates.push_back(face->plane().flip());
+    }
+  }
+
+  std::vector<vm::plane<T, 3>> planes;
+  for (const auto& plane : candidates)
+  {
+    if (
+      plane.point_status(position, epsilon) != vm::plane_status::above
+      || anyRemainingVertex([&](const auto& p) {
+           return plane.point_status(p, epsilon) == vm::plane_status::above;
+         }))
+    {
+      continue;
+    }
+
+    // the remaining vertices must not be coplanar
+    if (!anyRemainingVertex([&](const auto& p) {
+          return plane.point_status(p, epsilon) == vm::plane_status::below;
+        }))
+    {
+      return false;
+    }
+
+    // the new face would have to be merged with a coplanar face
+    if (std::any_of(m_faces.begin(), m_faces.end(), [&](const Face* f) {
+          return !vertex->incident(f) && f->verticesOnPlane(plane, epsilon);
+        }))
+    {
+      return false;
+    }
+
+    planes.push_back(plane);
+  }
+
+  if (planes.empty())
+  {
+    return false;
+  }
+
+  for (const auto& plane : planes)
+  {
+    // once the vertex has been cut off, clipping with the remaining planes may have no
+    // effect
+    const auto result = clip(plane);
+    unused(result);
+    assert(result.success() || result.unchanged());
+  }
+
+  assert(!hasVertex(position));
+  return true;
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addFirstPoint(
   const vm::vec<T, 3>& position)
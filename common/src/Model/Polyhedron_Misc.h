@@ -24,6 +24,8 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/scalar.h"
@@ -801,6 +803,23 @@ void Polyhedron<T, FP, VP>::updateBounds()
   }
 }
 
+template <typename T, typename FP, typename VP>
+bool Polyhedron<T, FP, VP>::transform(const vm::mat<T, 4, 4>& transformation)
+{
+  if (vm::compute_determinant(vm::strip_translation(transformation)) <= T(0))
+  {
+    return false;
+  }
+
+  for (auto* vertex : m_vertices)
+  {
+    vertex->setPosition(transformation * vertex->position());
+  }
+  correctVertexPositions();
+
+  return checkEdgeLengths();
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::correctVertexPositions(const size_t decimals, const T epsilon)
 {
@@ -19,30 +19,55 @@
 
 #include "PortalFile.h"
 
+#include "Ensure.h"
 #include "Error.h"
 #include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
 
 #include "kdl/result.h"
-#include "kdl/string_format.h"
 #include "kdl/string_utils.h"
 
 #include "vm/forward.h"
 #include "vm/polygon.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <optional>
 #include <string>
 
 namespace TrenchBroom::Model
 {
 
-PortalFile::PortalFile(std::vector<vm::polygon3f> portals)
-  : m_portals{std::move(portals)}
+PortalFile::PortalFile(std::vector<vm::vec3f> vertices, std::vector<size_t> offsets)
+  : m_vertices{std::move(vertices)}
+  , m_offsets{std::move(offsets)}
 {
+  ensure(!m_offsets.empty(), "offsets must not be empty");
+  ensure(m_offsets.back() == m_vertices.size(), "last offset must be vertex count");
 }
 
-const std::vector<vm::polygon3f>& PortalFile::portals() const
+size_t PortalFile::portalCount() const
 {
-  return m_portals;
+  return m_offsets.size() - 1;
+}
+
+std::span<const vm::vec3f> PortalFile::portalVertices(const size_t index) const
+{
+  return std::span{m_vertices}.subspan(
+    m_offsets[index], m_offsets[index + 1] - m_offsets[index]);
+}
+
+std::vector<vm::polygon3f> PortalFile::portals() const
+{
+  auto result = std::vector<vm::polygon3f>{};
+  result.reserve(portalCount());
+  for (size_t i = 0; i < portalCount(); ++i)
+  {
+    const auto vertices = portalVertices(i);
+    result.emplace_back(std::vector<vm::vec3f>{vertices.begin(), vertices.end()});
+  }
+  return result;
 }
 
 bool canLoadPortalFile(const std::filesystem::path& path)
@@ -52,97 +77,143 @@ bool canLoadPortalFile(const std::filesystem::path& path)
          | kdl::transform_error([](const auto&) { return false; }) | kdl::value();
 }
 
-Result<PortalFile> loadPortalFile(std::istream& stream)
+namespace
+{
+
+constexpr auto TokenDelimiters = "() \t\r";
+
+std::string_view nextLine(std::string_view& str)
+{
+  const auto end = std::min(str.find('\n'), str.size());
+  const auto line = str.substr(0, end);
+  str.remove_prefix(std::min(end + 1, str.size()));
+  return line;
+}
+
+std::string_view nextToken(std::string_view& line)
+{
+  return kdl::str_next_token(line, TokenDelimiters);
+}
+
+std::optional<size_t> parseCount(std::string_view line)
+{
+  return kdl::str_to_size(nextToken(line));
+}
+
+std::optional<vm::vec3f> parseVertex(std::string_view& line)
 {
-  static const auto lineSplitter = "() \n\t\r";
+  const auto x = kdl::str_to_float(nextToken(line));
+  const auto y = kdl::str_to_float(nextToken(line));
+  const auto z = kdl::str_to_float(nextToken(line));
+  return x && y && z ? std::optional{vm::vec3f{*x, *y, *z}} : std::nullopt;
+}
+
+} // namespace
 
-  auto line = std::string{};
-  auto numPortals = 0ul;
+Result<PortalFile> loadPortalFile(std::string_view str)
+{
+  auto numPortals = std::optional<size_t>{};
   auto prt1ForQ3 = false;
 
   // read header
-  std::getline(stream, line);
-  const auto formatCode = kdl::str_trim(line); // trim off any trailing \r
+  auto formatLine = nextLine(str);
+  const auto formatCode = nextToken(formatLine);
 
   if (formatCode == "PRT1")
   {
-    std::getline(stream, line); // number of leafs (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
-    const auto mark = stream.tellg();
-    std::getline(stream, line);
-    // If this line contains a single value, it is Q3-style PRT1 (value is
-    // number of solid faces -- will ignore). Otherwise is Q1/Q2 style and we
-    // will rewind the stream to process this line accordingly.
-    const auto componentsCheck = kdl::str_split(line, lineSplitter);
-    if (componentsCheck.size() == 1)
+    nextLine(str); // number of leafs (ignored)
+    numPortals = parseCount(nextLine(str));
+
+    // If the next line contains a single value, it is Q3-style PRT1 (value is number of
+    // solid faces -- will ignore). Otherwise is Q1/Q2 style and we will process this line
+    // as a portal.
+    auto next = str;
+    auto line = nextLine(next);
+    nextToken(line);
+    if (nextToken(line).empty())
     {
       prt1ForQ3 = true;
-    }
-    else
-    {
-      stream.seekg(mark);
+      str = next;
     }
   }
   else if (formatCode == "PRT2")
   {
-    std::getline(stream, line); // number of leafs (ignored)
-    std::getline(stream, line); // number of clusters (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
+    nextLine(str); // number of leafs (ignored)
+    nextLine(str); // number of clusters (ignored)
+    numPortals = parseCount(nextLine(str));
   }
   else if (formatCode == "PRT1-AM")
   {
-    std::getline(stream, line); // number of clusters (ignored)
-    std::getline(stream, line); // number of portals
-    numPortals = std::stoul(line);
-    std::getline(stream, line); // number of leafs (ignored)
+    nextLine(str); // number of clusters (ignored)
+    numPortals = parseCount(nextLine(str));
+    nextLine(str); // number of leafs (ignored)
   }
   else
   {
-    return Error{"Unknown portal format: " + formatCode};
+    return Error{"Unknown portal format: " + std::string{formatCode}};
   }
 
-  if (!stream.good())
+  if (!numPortals)
   {
     return Error{"Error reading header"};
   }
 
   // read portals
-  auto portals = std::vector<vm::polygon3f>{};
-  portals.reserve(numPortals);
+  auto vertices = std::vector<vm::vec3f>{};
+  vertices.reserve(*numPortals * 4);
+
+  auto offsets = std::vector<size_t>{};
+  offsets.reserve(*numPortals + 1);
+  offsets.push_back(0);
+
+  // the portal's leafs or clusters, and the Q3 hint flag
+  const auto numIgnoredTokens = prt1ForQ3 ? 3u : 2u;
 
-  for (size_t i = 0; i < numPortals; ++i)
+  for (size_t i = 0; i < *numPortals; ++i)
   {
-    std::getline(stream, line);
-    const auto components = kdl::str_split(line, lineSplitter);
+    if (str.empty())
+    {
+      return Error{"Error reading portal"};
+    }
 
-    if (!stream.good() || components.size() < 3)
+    auto line = nextLine(str);
+    const auto numPoints = kdl::str_to_size(nextToken(line));
+    if (!numPoints)
     {
       return Error{"Error reading portal"};
     }
 
-    auto verts = std::vector<vm::vec3f>{};
-    auto ptr = prt1ForQ3 ? 4u : 3u;
-    const int numPoints = std::stoi(components.at(0));
-    for (int j = 0; j < numPoints; ++j)
+    for (size_t j = 0; j < numIgnoredTokens; ++j)
     {
-      if (ptr + 2 >= components.size())
+      if (nextToken(line).empty())
       {
         return Error{"Error reading portal"};
       }
+    }
 
-      verts.emplace_back(
-        std::stof(components.at(ptr)),
-        std::stof(components.at(ptr + 1)),
-        std::stof(components.at(ptr + 2)));
-      ptr += 3;
+    for (size_t j = 0; j < *numPoints; ++j)
+    {
+      const auto vertex = parseVertex(line);
+      if (!vertex)
+      {
+        return Error{"Error reading portal"};
+      }
+      vertices.push_back(*vertex);
     }
 
-    portals.emplace_back(std::move(verts));
+    offsets.push_back(vertices.size());
   }
-  return PortalFile{std::move(portals)};
+
+  return PortalFile{std::move(vertices), std::move(offsets)};
 }
 
+Result<PortalFile> loadPortalFile(const std::filesystem::path& path)
+{
+  return IO::Disk::openFile(path) | kdl::and_then([](const auto& file) {
+           // read the file into a single buffer and parse it in place
+           const auto reader = file->reader().buffer();
+           return loadPortalFile(reader.stringView());
+         });
+}
 
 } // namespace TrenchBroom::Model
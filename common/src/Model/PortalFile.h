@@ -22,26 +22,51 @@
 #include "Result.h"
 
 #include "vm/forward.h"
+#include "vm/vec.h"
 
 #include <filesystem>
-#include <iosfwd>
+#include <span>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom::Model
 {
 
+/**
+ * The portals of a compiled map. The vertices of all portals are stored in a single
+ * buffer, and each portal is represented by the offset of its first vertex.
+ */
 class PortalFile
 {
 private:
-  std::vector<vm::polygon3f> m_portals;
+  std::vector<vm::vec3f> m_vertices;
+  std::vector<size_t> m_offsets;
 
 public:
-  explicit PortalFile(std::vector<vm::polygon3f> portals);
+  /**
+   * Creates a portal file with the given vertices. The vertices of the portal with index
+   * i are stored in the range [offsets[i], offsets[i + 1]), so the given offsets must
+   * contain one more element than there are portals, and the last offset must be the
+   * number of vertices.
+   */
+  PortalFile(std::vector<vm::vec3f> vertices, std::vector<size_t> offsets);
+
+  size_t portalCount() const;
+
+  /**
+   * Returns the vertices of the portal with the given index as a view into the vertex
+   * buffer.
+   */
+  std::span<const vm::vec3f> portalVertices(size_t index) const;
 
-  const std::vector<vm::polygon3f>& portals() const;
+  /**
+   * Creates a polygon for each portal.
+   */
+  std::vector<vm::polygon3f> portals() const;
 };
 
 bool canLoadPortalFile(const std::filesystem::path& path);
-Result<PortalFile> loadPortalFile(std::istream& stream);
+Result<PortalFile> loadPortalFile(std::string_view str);
+Result<PortalFile> loadPortalFile(const std::filesystem::path& path);
 
 } // namespace TrenchBroom::Model
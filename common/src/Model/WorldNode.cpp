@@ -27,6 +27,7 @@
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/TagVisitor.h"
 #include "Model/Validator.h"
 #include "Model/ValidatorRegistry.h"
@@ -38,6 +39,7 @@
 
 #include "vm/bbox_io.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -183,6 +185,33 @@ const EntityNodeIndex& WorldNode::entityNodeIndex() const
   return *m_entityNodeIndex;
 }
 
+std::vector<Node*> WorldNode::findNodesWithLinkId(const std::string& linkId) const
+{
+  const auto it = m_linkIdIndex.find(linkId);
+  return it != m_linkIdIndex.end() ? it->second : std::vector<Node*>{};
+}
+
+void WorldNode::addToLinkIdIndex(Node* node, const std::string& linkId)
+{
+  m_linkIdIndex[linkId].push_back(node);
+}
+
+void WorldNode::removeFromLinkIdIndex(Node* node, const std::string& linkId)
+{
+  auto it = m_linkIdIndex.find(linkId);
+  ensure(it != m_linkIdIndex.end(), "link ID is indexed");
+
+  auto& nodes = it->second;
+  const auto nodeIt = std::find(nodes.begin(), nodes.end(), node);
+  ensure(nodeIt != nodes.end(), "node is indexed");
+
+  nodes.erase(nodeIt);
+  if (nodes.empty())
+  {
+    m_linkIdIndex.erase(it);
+  }
+}
+
 std::vector<const Validator*> WorldNode::registeredValidators() const
 {
   return m_validatorRegistry->registeredValidators();
@@ -388,10 +417,14 @@ void WorldNode::doDescendantWasAdded(Node* node, const size_t /* depth */)
     [&](auto&& thisLambda, GroupNode* group) {
       group->visitChildren(thisLambda);
       updatePersistentId(group);
+      addToLinkIdIndex(group, group->linkId());
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      addToLinkIdIndex(entity, entity->linkId());
     },
-    [&](EntityNode*) {},
-    [&](BrushNode*) {},
-    [&](PatchNode*) {}));
+    [&](BrushNode* brush) { addToLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { addToLinkIdIndex(patch, patch->linkId()); }));
 }
 
 void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
@@ -419,6 +452,20 @@ void WorldNode::doDescendantWillBeRemoved(Node* node, const size_t /* depth */)
       [&](BrushNode* brush) { doRemove(brush); },
       [&](PatchNode* patch) { doRemove(patch); }));
   }
+
+  node->accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [&](auto&& thisLambda, GroupNode* group) {
+      group->visitChildren(thisLambda);
+      removeFromLinkIdIndex(group, group->linkId());
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+      removeFromLinkIdIndex(entity, entity->linkId());
+    },
+    [&](BrushNode* brush) { removeFromLinkIdIndex(brush, brush->linkId()); },
+    [&](PatchNode* patch) { removeFromLinkIdIndex(patch, patch->linkId()); }));
 }
 
 void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node)
@@ -443,10 +490,17 @@ bool WorldNode::doSelectable() const
 void WorldNode::doPick(
   const EditorContext& editorContext, const vm::ray3& ray, PickResult& pickResult)
 {
-  for (auto* node : m_nodeTree->find_intersectors(ray))
-  {
-    node->pick(editorContext, ray, pickResult);
-  }
+  // the hits of a node cannot be closer than the distance at which the ray enters the
+  // node tree cell containing it, so we can stop once the pick result is complete
+  m_nodeTree->visit_intersectors_near_to_far(
+    ray, [&](Node* node, const FloatType distance) {
+      if (pickResult.isComplete(distance))
+      {
+        return false;
+      }
+      node->pick(editorContext, ray, pickResult);
+      return true;
+    });
 }
 
 void WorldNode::doFindNodesContaining(const vm::vec3& point, std::vector<Node*>& result)
@@ -504,6 +558,13 @@ void WorldNode::doRemoveFromIndex(
   m_entityNodeIndex->removeProperty(node, key, value);
 }
 
+void WorldNode::doUpdateLinkIdIndex(
+  Node* node, const std::string& oldLinkId, const std::string& newLinkId)
+{
+  removeFromLinkIdIndex(node, oldLinkId);
+  addToLinkIdIndex(node, newLinkId);
+}
+
 void WorldNode::doPropertiesDidChange(const vm::bbox3& /* oldBounds */) {}
 
 vm::vec3 WorldNode::doGetLinkSourceAnchor() const
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -54,6 +55,7 @@ private:
   MapFormat m_mapFormat;
   LayerNode* m_defaultLayer;
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
+  std::unordered_map<std::string, std::vector<Node*>> m_linkIdIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
   using NodeTree = octree<FloatType, Node*>;
@@ -131,6 +133,17 @@ private:
 public: // index
   const EntityNodeIndex& entityNodeIndex() const;
 
+  /**
+   * Returns the groups, entities, brushes and patches in this world that have the given
+   * link ID. The nodes are looked up in an index, so the cost of this function does not
+   * depend on the size of the world.
+   */
+  std::vector<Node*> findNodesWithLinkId(const std::string& linkId) const;
+
+private:
+  void addToLinkIdIndex(Node* node, const std::string& linkId);
+  void removeFromLinkIdIndex(Node* node, const std::string& linkId);
+
 public: // validator registration
   std::vector<const Validator*> registeredValidators() const;
   std::vector<const IssueQuickFix*> quickFixes(IssueType issueTypes) const;
@@ -181,6 +194,8 @@ private: // implement Node interface
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
   void doRemoveFromIndex(
     EntityNodeBase* node, const std::string& key, const std::string& value) override;
+  void doUpdateLinkIdIndex(
+    Node* node, const std::string& oldLinkId, const std::string& newLinkId) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3& oldBounds) override;
@@ -25,8 +25,13 @@
 #include "kdl/tuple_utils.h"
 
 #include <cassert>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom
@@ -45,12 +50,71 @@ private:
   virtual void disconnect(size_t id) = 0;
 };
 
+/**
+ * Controls how a notifier delivers its notifications while it is coalescing them.
+ */
+enum class CoalescingMode
+{
+  /**
+   * Observers are notified immediately, but only of those values they have not been
+   * notified of since coalescing started.
+   */
+  Immediate,
+  /**
+   * The values are collected and the observers are notified of them once when coalescing
+   * ends.
+   */
+  Deferred,
+};
+
+/**
+ * The time spent in an observer callback.
+ */
+struct ObserverTiming
+{
+  size_t notificationCount{0};
+  std::chrono::nanoseconds duration{0};
+};
+
+namespace detail
+{
+/**
+ * Determines the type of the values that a notifier can coalesce. Only notifiers whose
+ * single parameter is a vector of hashable values can coalesce their notifications.
+ */
+template <typename... A>
+struct CoalescedValue
+{
+  static constexpr bool canCoalesce = false;
+  using type = std::monostate;
+};
+
+template <typename T>
+struct CoalescedValue<const std::vector<T>&>
+{
+  static constexpr bool canCoalesce = std::is_default_constructible_v<std::hash<T>>;
+  using type = std::conditional_t<canCoalesce, T, std::monostate>;
+};
+
+template <typename T>
+struct CoalescingState
+{
+  CoalescingMode mode{CoalescingMode::Deferred};
+  size_t depth{0};
+  std::vector<T> values;
+  std::unordered_set<T> seenValues;
+};
+} // namespace detail
+
 /**
  * A notifier that multiple observers can connect to.
  *
  * Observers are notified in the order in which they were connected. The same observer can
  * be connected multiple times.
  *
+ * A notifier whose single parameter is a vector of hashable values can coalesce its
+ * notifications, see startCoalescing.
+ *
  * @tparam A the types of the parameters passed to the observer callbacks.
  */
 template <typename... A>
@@ -59,11 +123,15 @@ class Notifier
 private:
   using Callback = std::function<void(A...)>;
 
+  using CoalescedValue = typename detail::CoalescedValue<A...>::type;
+  static constexpr bool CanCoalesce = detail::CoalescedValue<A...>::canCoalesce;
+
   struct Observer
   {
     Callback callback;
     size_t id;
     bool pendingRemove;
+    ObserverTiming timing;
 
     Observer(Callback i_callback, const size_t i_id)
       : callback{std::move(i_callback)}
@@ -80,6 +148,7 @@ private:
     std::vector<Observer> m_observers;
     std::vector<Observer> m_toAdd;
     bool m_notifying{false};
+    bool m_timingEnabled{false};
 
   public:
     ~NotifierState() override = default;
@@ -119,11 +188,50 @@ private:
       processPendingObservers();
 
       const kdl::set_temp notifying(m_notifying);
-      for (const auto& observer : m_observers)
+      for (auto& observer : m_observers)
       {
         if (!observer.pendingRemove)
         {
-          observer.callback(std::forward<NA>(a)...);
+          if (m_timingEnabled)
+          {
+            const auto start = std::chrono::steady_clock::now();
+            observer.callback(std::forward<NA>(a)...);
+            observer.timing.duration += std::chrono::steady_clock::now() - start;
+            ++observer.timing.notificationCount;
+          }
+          else
+          {
+            observer.callback(std::forward<NA>(a)...);
+          }
+        }
+      }
+    }
+
+    void setTimingEnabled(const bool timingEnabled) { m_timingEnabled = timingEnabled; }
+
+    std::vector<ObserverTiming> observerTimings() const
+    {
+      auto result = std::vector<ObserverTiming>{};
+      for (const auto* observers : {&m_observers, &m_toAdd})
+      {
+        for (const auto& observer : *observers)
+        {
+          if (!observer.pendingRemove)
+          {
+            result.push_back(observer.timing);
+          }
+        }
+      }
+      return result;
+    }
+
+    void resetObserverTimings()
+    {
+      for (auto* observers : {&m_observers, &m_toAdd})
+      {
+        for (auto& observer : *observers)
+        {
+          observer.timing = ObserverTiming{};
         }
       }
     }
@@ -185,6 +293,11 @@ private:
   };
 
   std::shared_ptr<NotifierState> m_state{std::make_shared<NotifierState>()};
+  std::conditional_t<
+    CanCoalesce,
+    detail::CoalescingState<CoalescedValue>,
+    std::monostate>
+    m_coalescing;
 
 public:
   friend class NotifierConnection;
@@ -251,6 +364,15 @@ public:
   template <typename... NA>
   void notify(NA&&... a)
   {
+    if constexpr (CanCoalesce)
+    {
+      if (m_coalescing.depth > 0)
+      {
+        coalesce(std::forward<NA>(a)...);
+        return;
+      }
+    }
+
     m_state->notify(std::forward<NA>(a)...);
   }
 
@@ -264,6 +386,126 @@ public:
   {
     notify(std::forward<NA>(a)...);
   }
+
+  /**
+   * Starts coalescing the notifications of this notifier. While coalescing, every value
+   * is passed to the observers at most once, either immediately or when coalescing ends,
+   * depending on the given mode.
+   *
+   * Calls to this function can be nested. Coalescing ends when stopCoalescing has been
+   * called as often as this function. The mode of the outermost call applies.
+   */
+  void startCoalescing(const CoalescingMode mode)
+    requires CanCoalesce
+  {
+    if (m_coalescing.depth++ == 0)
+    {
+      m_coalescing.mode = mode;
+    }
+  }
+
+  /**
+   * Stops coalescing the notifications of this notifier. If this ends coalescing, then
+   * the observers are notified of any deferred values.
+   */
+  void stopCoalescing()
+    requires CanCoalesce
+  {
+    assert(m_coalescing.depth > 0);
+    if (--m_coalescing.depth == 0)
+    {
+      auto values = std::exchange(m_coalescing.values, {});
+      m_coalescing.seenValues.clear();
+
+      if (!values.empty())
+      {
+        m_state->notify(values);
+      }
+    }
+  }
+
+  /**
+   * Indicates whether this notifier is currently coalescing its notifications.
+   */
+  bool coalescing() const
+    requires CanCoalesce
+  {
+    return m_coalescing.depth > 0;
+  }
+
+  /**
+   * Forgets the given values if this notifier is coalescing. Deferred notifications will
+   * not contain these values, and observers will be notified of them again if they are
+   * passed to this notifier later. This is useful if the values become invalid.
+   */
+  void discardCoalescedValues(const std::vector<CoalescedValue>& values)
+    requires CanCoalesce
+  {
+    if (m_coalescing.depth > 0)
+    {
+      const auto discardedValues =
+        std::unordered_set<CoalescedValue>{values.begin(), values.end()};
+      for (const auto& value : discardedValues)
+      {
+        m_coalescing.seenValues.erase(value);
+      }
+      std::erase_if(m_coalescing.values, [&](const auto& value) {
+        return discardedValues.contains(value);
+      });
+    }
+  }
+
+  /**
+   * Enables or disables measuring the time spent in each observer callback. Disabling
+   * the measurement keeps the timings measured so far.
+   */
+  void setTimingEnabled(const bool timingEnabled)
+  {
+    m_state->setTimingEnabled(timingEnabled);
+  }
+
+  /**
+   * Returns the number of notifications and the total time spent in each observer
+   * callback while timing was enabled, in the order in which the observers were
+   * connected.
+   */
+  std::vector<ObserverTiming> observerTimings() const
+  {
+    return m_state->observerTimings();
+  }
+
+  /**
+   * Resets the timings of all observer callbacks.
+   */
+  void resetObserverTimings() { m_state->resetObserverTimings(); }
+
+private:
+  void coalesce(const std::vector<CoalescedValue>& values)
+  {
+    auto newValues = std::vector<CoalescedValue>{};
+    for (const auto& value : values)
+    {
+      if (m_coalescing.seenValues.insert(value).second)
+      {
+        newValues.push_back(value);
+      }
+    }
+
+    if (newValues.empty())
+    {
+      return;
+    }
+
+    if (m_coalescing.mode == CoalescingMode::Immediate)
+    {
+      m_state->notify(newValues);
+    }
+    else
+    {
+      m_coalescing.values.insert(
+        m_coalescing.values.end(), newValues.begin(), newValues.end());
+    }
+  }
 };
 
 /**
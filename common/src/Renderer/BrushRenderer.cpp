@@ -216,6 +216,20 @@ void BrushRenderer::invalidateBrush(const Model::BrushNode* brushNode)
     assert(m_invalidBrushes.find(brushNode) == std::end(m_invalidBrushes));
     return;
   }
+
+  // if only the UV coordinates have changed, the brush can remain in the VBO
+  if (auto it = m_brushInfo.find(brushNode); it != std::end(m_brushInfo))
+  {
+    auto& info = it->second;
+    const auto& brushCache = brushNode->brushRendererBrushCache();
+    if (brushCache.onlyUVCoordsChangedSince(info.uvCoordsVersion))
+    {
+      info.uvCoordsVersion = brushCache.uvCoordsVersion();
+      m_brushesWithInvalidUVCoords.insert(brushNode);
+      return;
+    }
+  }
+
   // if it's not in the invalid set, put it in
   if (m_invalidBrushes.insert(brushNode).second)
   {
@@ -225,7 +239,12 @@ void BrushRenderer::invalidateBrush(const Model::BrushNode* brushNode)
 
 bool BrushRenderer::valid() const
 {
-  return m_invalidBrushes.empty();
+  return m_invalidBrushes.empty() && m_brushesWithInvalidUVCoords.empty();
+}
+
+size_t BrushRenderer::vertexMemoryUsage() const
+{
+  return m_vertexArray->memoryUsage();
 }
 
 void BrushRenderer::clear()
@@ -233,6 +252,7 @@ void BrushRenderer::clear()
   m_brushInfo.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
+  m_brushesWithInvalidUVCoords.clear();
 
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_edgeIndices = std::make_shared<BrushIndexArray>();
@@ -388,6 +408,12 @@ void BrushRenderer::validate()
     validateBrush(*brushNode);
   }
   m_invalidBrushes.clear();
+
+  for (auto* brushNode : m_brushesWithInvalidUVCoords)
+  {
+    validateBrushUVCoords(*brushNode);
+  }
+  m_brushesWithInvalidUVCoords.clear();
   assert(valid());
 
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
@@ -542,6 +568,7 @@ void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
     m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
   std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
   info.vertexHolderKey = vertBlock;
+  info.uvCoordsVersion = brushCache.uvCoordsVersion();
 
   const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
 
@@ -673,6 +700,23 @@ void BrushRenderer::validateBrush(const Model::BrushNode& brushNode)
   }
 }
 
+void BrushRenderer::validateBrushUVCoords(const Model::BrushNode& brushNode)
+{
+  assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
+  assert(m_invalidBrushes.find(&brushNode) == std::end(m_invalidBrushes));
+
+  const auto& info = m_brushInfo.at(&brushNode);
+
+  // only the UV coordinates have changed, so the vertices can be overwritten in place
+  auto& brushCache = brushNode.brushRendererBrushCache();
+  brushCache.validateVertexCache(brushNode);
+  const auto& cachedVertices = brushCache.cachedVertices();
+  assert(cachedVertices.size() == info.vertexHolderKey->size);
+
+  auto* dest = m_vertexArray->getPointerToWriteVerticesWithKey(info.vertexHolderKey);
+  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+}
+
 void BrushRenderer::addBrush(const Model::BrushNode* brushNode)
 {
   // i.e. insert the brush as "invalid" if it's not already present.
@@ -701,6 +745,8 @@ void BrushRenderer::removeBrush(const Model::BrushNode* brushNode)
 
 void BrushRenderer::removeBrushFromVbo(const Model::BrushNode& brushNode)
 {
+  m_brushesWithInvalidUVCoords.erase(&brushNode);
+
   auto it = m_brushInfo.find(&brushNode);
 
   if (it == std::end(m_brushInfo))
@@ -127,6 +127,7 @@ private:
       opaqueFaceIndicesKeys;
     std::vector<std::pair<const Assets::Material*, AllocationTracker::Block*>>
       transparentFaceIndicesKeys;
+    size_t uvCoordsVersion;
   };
   /**
    * Tracks all brushes that are stored in the VBO, with the information necessary to
@@ -143,6 +144,12 @@ private:
   std::unordered_set<const Model::BrushNode*> m_allBrushes;
   std::unordered_set<const Model::BrushNode*> m_invalidBrushes;
 
+  /**
+   * Brushes that are in the VBO, but whose UV coordinates have changed. Only their
+   * vertices are updated in the VBO, their indices remain unchanged.
+   */
+  std::unordered_set<const Model::BrushNode*> m_brushesWithInvalidUVCoords;
+
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<BrushIndexArray> m_edgeIndices;
 
@@ -193,6 +200,10 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
+   * If only the UV coordinates of a brush's faces have changed since it was added to the
+   * VBO, as determined by its BrushRendererBrushCache, invalidateBrush() only marks its
+   * UV coordinates for updating, and the brush remains in the VBO.
+   *
    * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
    * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
    * lingering Material* pointers.
@@ -203,6 +214,12 @@ public:
   void invalidateMaterial(const Assets::Material& material);
   bool valid() const;
 
+  /**
+   * Returns the number of bytes used by the vertices of all brushes. The same amount of
+   * memory is used on the CPU and in the VBO.
+   */
+  size_t vertexMemoryUsage() const;
+
   /**
    * Sets the color to render faces with no material with.
    */
@@ -290,6 +307,7 @@ private:
   bool shouldDrawFaceInTransparentPass(
     const Model::BrushNode& brushNode, const Model::BrushFace& face) const;
   void validateBrush(const Model::BrushNode& brushNode);
+  void validateBrushUVCoords(const Model::BrushNode& brushNode);
 
 public:
   /**
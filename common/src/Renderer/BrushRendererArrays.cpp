@@ -223,6 +223,12 @@ std::pair<AllocationTracker::Block*, BrushVertexArray::Vertex*> BrushVertexArray
   return {block, dest};
 }
 
+BrushVertexArray::Vertex* BrushVertexArray::getPointerToWriteVerticesWithKey(
+  AllocationTracker::Block* key)
+{
+  return m_vertexHolder.getPointerToWriteElementsTo(key->pos, key->size);
+}
+
 void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
 {
   m_allocationTracker.free(key);
@@ -233,6 +239,11 @@ void BrushVertexArray::deleteVerticesWithKey(AllocationTracker::Block* key)
   // us to re-use the space later
 }
 
+size_t BrushVertexArray::memoryUsage() const
+{
+  return m_vertexHolder.memoryUsage();
+}
+
 bool BrushVertexArray::setupVertices()
 {
   return m_vertexHolder.setupVertices();
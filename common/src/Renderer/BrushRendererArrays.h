@@ -225,6 +225,12 @@ public:
 
   size_t size() const { return m_snapshot.size(); }
 
+  /**
+   * Returns the number of bytes used by the elements. The same amount of memory is used
+   * by the VBO once it is prepared.
+   */
+  size_t memoryUsage() const { return m_snapshot.size() * sizeof(T); }
+
   void bindBlock() { m_vbo->bind(); }
 
   void unbindBlock() { m_vbo->unbind(); }
@@ -372,8 +378,17 @@ public:
   std::pair<AllocationTracker::Block*, Vertex*> getPointerToInsertVerticesAt(
     size_t vertexCount);
 
+  /**
+   * Call this to overwrite the vertices that were previously inserted with the given key.
+   *
+   * Returns a Vertex pointer where the caller should write `key->size` Vertex objects.
+   */
+  Vertex* getPointerToWriteVerticesWithKey(AllocationTracker::Block* key);
+
   void deleteVerticesWithKey(AllocationTracker::Block* key);
 
+  size_t memoryUsage() const;
+
   // setting up GL attributes
   bool setupVertices();
   void cleanupVertices();
@@ -25,6 +25,8 @@
 #include "Model/Polyhedron.h"
 
 #include <algorithm>
+#include <iterator>
+#include <unordered_map>
 
 namespace TrenchBroom::Renderer
 {
@@ -52,6 +54,8 @@ BrushRendererBrushCache::CachedEdge::CachedEdge(
 
 BrushRendererBrushCache::BrushRendererBrushCache()
   : m_rendererCacheValid{false}
+  , m_uvCoordsValid{false}
+  , m_uvCoordsVersion{0}
 {
 }
 
@@ -63,10 +67,33 @@ void BrushRendererBrushCache::invalidateVertexCache()
   m_cachedFacesSortedByMaterial.clear();
 }
 
+void BrushRendererBrushCache::invalidateUVCoords()
+{
+  if (m_rendererCacheValid)
+  {
+    m_uvCoordsValid = false;
+    ++m_uvCoordsVersion;
+  }
+}
+
+bool BrushRendererBrushCache::onlyUVCoordsChangedSince(const size_t uvCoordsVersion) const
+{
+  return m_rendererCacheValid && m_uvCoordsVersion != uvCoordsVersion;
+}
+
+size_t BrushRendererBrushCache::uvCoordsVersion() const
+{
+  return m_uvCoordsVersion;
+}
+
 void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushNode)
 {
   if (m_rendererCacheValid)
   {
+    if (!m_uvCoordsValid)
+    {
+      validateUVCoords(brushNode);
+    }
     return;
   }
 
@@ -79,29 +106,27 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
   m_cachedFacesSortedByMaterial.clear();
   m_cachedFacesSortedByMaterial.reserve(brush.faceCount());
 
+  // Maps each vertex to its index, relative to the brush's first vertex being 0. This is
+  // used below when building the edge cache. NOTE: we'll overwrite the index as we visit
+  // the same vertex several times while visiting different faces, this is fine. The
+  // geometry may be shared with copies of this brush, so it must not be modified here.
+  auto vertexIndices = std::unordered_map<const Model::BrushVertex*, size_t>{};
+  vertexIndices.reserve(brush.vertexCount());
+
   for (const auto& face : brush.faces())
   {
     const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
     // The boundary is in CCW order, but the renderer expects CW order:
-    auto& boundary = face.geometry()->boundary();
+    const auto& boundary = face.geometry()->boundary();
     for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it)
     {
-      auto* currentHalfEdge = *it;
-      auto* vertex = currentHalfEdge->origin();
-
-      // Set the vertex payload to the index, relative to the brush's first vertex being
-      // 0. This is used below when building the edge cache. NOTE: we'll overwrite the
-      // payload as we visit the same vertex several times while visiting different faces,
-      // this is fine.
-      const auto currentIndex = m_cachedVertices.size();
-      vertex->setPayload(static_cast<GLuint>(currentIndex));
+      const auto* vertex = (*it)->origin();
+      vertexIndices[vertex] = m_cachedVertices.size();
 
       const auto& position = vertex->position();
       m_cachedVertices.emplace_back(
         vm::vec3f{position}, vm::vec3f{face.boundary().normal}, face.uvCoords(position));
-
-      currentHalfEdge = currentHalfEdge->previous();
     }
 
     // face cache
@@ -131,14 +156,64 @@ void BrushRendererBrushCache::validateVertexCache(const Model::BrushNode& brushN
     const auto& face1 = brush.face(*faceIndex1);
     const auto& face2 = brush.face(*faceIndex2);
 
-    const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-    const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
+    const auto vertexIndex1RelativeToBrush = vertexIndices.at(currentEdge->firstVertex());
+    const auto vertexIndex2RelativeToBrush = vertexIndices.at(currentEdge->secondVertex());
 
     m_cachedEdges.emplace_back(
       &face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
   }
 
   m_rendererCacheValid = true;
+  m_uvCoordsValid = true;
+}
+
+void BrushRendererBrushCache::validateUVCoords(const Model::BrushNode& brushNode)
+{
+  // The brush shares its geometry with the brush that the cache was built for, so its
+  // faces, vertices and edges are in the same order. Only the face objects and their UV
+  // coordinates have changed.
+  const auto& brush = brushNode.brush();
+
+  auto indexOfFirstVertexOfFace = std::vector<size_t>{};
+  indexOfFirstVertexOfFace.reserve(brush.faceCount());
+
+  auto currentIndex = size_t(0);
+  for (const auto& face : brush.faces())
+  {
+    indexOfFirstVertexOfFace.push_back(currentIndex);
+
+    const auto& boundary = face.geometry()->boundary();
+    for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it)
+    {
+      const auto& position = (*it)->origin()->position();
+      m_cachedVertices[currentIndex++] = Vertex{
+        vm::vec3f{position}, vm::vec3f{face.boundary().normal}, face.uvCoords(position)};
+    }
+  }
+  assert(currentIndex == m_cachedVertices.size());
+
+  for (auto& cachedFace : m_cachedFacesSortedByMaterial)
+  {
+    const auto it = std::lower_bound(
+      indexOfFirstVertexOfFace.begin(),
+      indexOfFirstVertexOfFace.end(),
+      cachedFace.indexOfFirstVertexRelativeToBrush);
+    const auto faceIndex = size_t(std::distance(indexOfFirstVertexOfFace.begin(), it));
+
+    cachedFace.face = &brush.face(faceIndex);
+    assert(cachedFace.material == cachedFace.face->material());
+  }
+
+  auto cachedEdgeIt = m_cachedEdges.begin();
+  for (const auto* edge : brush.edges())
+  {
+    cachedEdgeIt->face1 = &brush.face(*edge->firstFace()->payload());
+    cachedEdgeIt->face2 = &brush.face(*edge->secondFace()->payload());
+    ++cachedEdgeIt;
+  }
+  assert(cachedEdgeIt == m_cachedEdges.end());
+
+  m_uvCoordsValid = true;
 }
 
 const std::vector<BrushRendererBrushCache::Vertex>& BrushRendererBrushCache::
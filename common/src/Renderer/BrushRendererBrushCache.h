@@ -73,6 +73,8 @@ private:
   std::vector<CachedEdge> m_cachedEdges;
   std::vector<CachedFace> m_cachedFacesSortedByMaterial;
   bool m_rendererCacheValid;
+  bool m_uvCoordsValid;
+  size_t m_uvCoordsVersion;
 
 public:
   BrushRendererBrushCache();
@@ -81,6 +83,24 @@ public:
    * Only exposed to be called by BrushFace
    */
   void invalidateVertexCache();
+
+  /**
+   * Only exposed to be called by BrushNode when the brush was replaced by a brush that
+   * shares its geometry and differs only in the UV coordinates of its faces.
+   *
+   * Keeps the vertex positions, the face order and the edges, and only recomputes the UV
+   * coordinates when the cache is validated the next time. Increments the UV coordinates
+   * version so that a renderer can tell that it only needs to update the UV coordinates
+   * of the brush's vertices.
+   */
+  void invalidateUVCoords();
+
+  /**
+   * Indicates whether only the UV coordinates have been invalidated since the cache had
+   * the given UV coordinates version, and the cached vertex positions are still valid.
+   */
+  bool onlyUVCoordsChangedSince(size_t uvCoordsVersion) const;
+  size_t uvCoordsVersion() const;
   /**
    * Call this before cachedVertices()/cachedFacesSortedByMaterial()/cachedEdges()
    *
@@ -97,6 +117,9 @@ public:
   const std::vector<Vertex>& cachedVertices() const;
   const std::vector<CachedFace>& cachedFacesSortedByMaterial() const;
   const std::vector<CachedEdge>& cachedEdges() const;
+
+private:
+  void validateUVCoords(const Model::BrushNode& brushNode);
 };
 
 } // namespace TrenchBroom::Renderer
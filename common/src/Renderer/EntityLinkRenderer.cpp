@@ -36,6 +36,7 @@
 
 #include "vm/vec.h"
 
+#include <algorithm>
 #include <cassert>
 #include <unordered_set>
 
@@ -84,37 +85,6 @@ void addLink(
   links.emplace_back(vm::vec3f{target.linkTargetAnchor()}, targetColor);
 }
 
-struct CollectAllLinksVisitor
-{
-  const Model::EditorContext& editorContext;
-  Color defaultColor;
-  Color selectedColor;
-
-  void visit(
-    const Model::EntityNodeBase& node, std::vector<LinkRenderer::LineVertex>& links)
-  {
-    if (editorContext.visible(&node))
-    {
-      addTargets(node, node.linkTargets(), links);
-      addTargets(node, node.killTargets(), links);
-    }
-  }
-
-  void addTargets(
-    const Model::EntityNodeBase& source,
-    const std::vector<Model::EntityNodeBase*>& targets,
-    std::vector<LinkRenderer::LineVertex>& links)
-  {
-    for (const Model::EntityNodeBase* target : targets)
-    {
-      if (editorContext.visible(target))
-      {
-        addLink(source, *target, defaultColor, selectedColor, links);
-      }
-    }
-  }
-};
-
 struct CollectTransitiveSelectedLinksVisitor
 {
   const Model::EditorContext& editorContext;
@@ -241,17 +211,123 @@ auto collectSelectedLinks(const Model::NodeCollection& selectedNodes, Visitor vi
   return links;
 }
 
-auto getAllLinks(
+auto getTransitiveSelectedLinks(
   View::MapDocument& document, const Color& defaultColor, const Color& selectedColor)
 {
-  auto links = std::vector<LinkRenderer::LineVertex>{};
+  auto visitor = CollectTransitiveSelectedLinksVisitor{
+    document.editorContext(), defaultColor, selectedColor};
+  return collectSelectedLinks(document.selectedNodes(), visitor);
+}
 
-  if (document.world())
+auto getDirectSelectedLinks(
+  View::MapDocument& document, const Color& defaultColor, const Color& selectedColor)
+{
+  auto visitor = CollectDirectSelectedLinksVisitor{
+    document.editorContext(), defaultColor, selectedColor};
+  return collectSelectedLinks(document.selectedNodes(), visitor);
+}
+
+template <typename F>
+void visitEntityNodes(const std::vector<Model::Node*>& nodes, const F& f)
+{
+  for (auto* node : nodes)
+  {
+    node->accept(kdl::overload(
+      [](auto&& thisLambda, const Model::WorldNode* worldNode) {
+        worldNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::LayerNode* layerNode) {
+        layerNode->visitChildren(thisLambda);
+      },
+      [](auto&& thisLambda, const Model::GroupNode* groupNode) {
+        groupNode->visitChildren(thisLambda);
+      },
+      [&](const Model::EntityNode* entityNode) { f(*entityNode); },
+      [](const Model::BrushNode*) {},
+      [](const Model::PatchNode*) {}));
+  }
+}
+
+} // namespace
+
+void EntityLinkCache::invalidate()
+{
+  m_linksBySource.clear();
+  m_sourcesByTarget.clear();
+  m_invalidSources.clear();
+  m_valid = false;
+}
+
+void EntityLinkCache::invalidateNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (m_valid)
+  {
+    for (auto* node : nodes)
+    {
+      node->accept(kdl::overload(
+        [](const Model::WorldNode*) {},
+        [](const Model::LayerNode*) {},
+        [](const Model::GroupNode*) {},
+        [&](const Model::EntityNode* entityNode) { invalidateEntityNode(*entityNode); },
+        [](auto&& thisLambda, const Model::BrushNode* brushNode) {
+          brushNode->visitParent(thisLambda);
+        },
+        [](auto&& thisLambda, const Model::PatchNode* patchNode) {
+          patchNode->visitParent(thisLambda);
+        }));
+    }
+  }
+}
+
+void EntityLinkCache::addNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (m_valid)
+  {
+    visitEntityNodes(
+      nodes, [&](const Model::EntityNodeBase& node) { invalidateEntityNode(node); });
+  }
+}
+
+void EntityLinkCache::removeNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (m_valid)
   {
-    auto visitor =
-      CollectAllLinksVisitor{document.editorContext(), defaultColor, selectedColor};
+    auto removedNodes = std::vector<const Model::EntityNodeBase*>{};
+    visitEntityNodes(nodes, [&](const Model::EntityNodeBase& node) {
+      removedNodes.push_back(&node);
+    });
+
+    for (const auto* node : removedNodes)
+    {
+      removeSourceLinks(*node);
+    }
 
-    document.world()->accept(kdl::overload(
+    // the links of removed nodes have already been removed from the model, so their
+    // sources can only be found in the cache
+    for (const auto* node : removedNodes)
+    {
+      if (const auto it = m_sourcesByTarget.find(node); it != m_sourcesByTarget.end())
+      {
+        m_invalidSources.insert(it->second.begin(), it->second.end());
+      }
+    }
+
+    for (const auto* node : removedNodes)
+    {
+      m_invalidSources.erase(node);
+    }
+  }
+}
+
+std::vector<LinkRenderer::LineVertex> EntityLinkCache::getLinks(
+  const Model::WorldNode& world,
+  const Model::EditorContext& editorContext,
+  const Color& defaultColor,
+  const Color& selectedColor)
+{
+  if (!m_valid)
+  {
+    world.accept(kdl::overload(
       [](auto&& thisLambda, const Model::WorldNode* worldNode) {
         worldNode->visitChildren(thisLambda);
       },
@@ -261,54 +337,153 @@ auto getAllLinks(
       [](auto&& thisLambda, const Model::GroupNode* groupNode) {
         groupNode->visitChildren(thisLambda);
       },
-      [&](const Model::EntityNode* entityNode) { visitor.visit(*entityNode, links); },
+      [&](const Model::EntityNode* entityNode) {
+        updateSourceLinks(*entityNode, editorContext, defaultColor, selectedColor);
+      },
       [](const Model::BrushNode*) {},
       [](const Model::PatchNode*) {}));
+    m_valid = true;
+  }
+  else
+  {
+    for (const auto* source : m_invalidSources)
+    {
+      updateSourceLinks(*source, editorContext, defaultColor, selectedColor);
+    }
   }
+  m_invalidSources.clear();
 
+  auto vertexCount = size_t(0);
+  for (const auto& [source, sourceLinks] : m_linksBySource)
+  {
+    vertexCount += sourceLinks.vertices.size();
+  }
+
+  auto links = std::vector<LinkRenderer::LineVertex>{};
+  links.reserve(vertexCount);
+  for (const auto& [source, sourceLinks] : m_linksBySource)
+  {
+    links.insert(links.end(), sourceLinks.vertices.begin(), sourceLinks.vertices.end());
+  }
   return links;
 }
 
-auto getTransitiveSelectedLinks(
-  View::MapDocument& document, const Color& defaultColor, const Color& selectedColor)
+void EntityLinkCache::invalidateEntityNode(const Model::EntityNodeBase& node)
 {
-  auto visitor = CollectTransitiveSelectedLinksVisitor{
-    document.editorContext(), defaultColor, selectedColor};
-  return collectSelectedLinks(document.selectedNodes(), visitor);
+  // the links from the sources of the given node end at the node, so they must be updated
+  // too; sources that no longer link to the node are only known to the cache
+  m_invalidSources.insert(&node);
+  m_invalidSources.insert(node.linkSources().begin(), node.linkSources().end());
+  m_invalidSources.insert(node.killSources().begin(), node.killSources().end());
+  if (const auto it = m_sourcesByTarget.find(&node); it != m_sourcesByTarget.end())
+  {
+    m_invalidSources.insert(it->second.begin(), it->second.end());
+  }
 }
 
-auto getDirectSelectedLinks(
-  View::MapDocument& document, const Color& defaultColor, const Color& selectedColor)
+void EntityLinkCache::updateSourceLinks(
+  const Model::EntityNodeBase& source,
+  const Model::EditorContext& editorContext,
+  const Color& defaultColor,
+  const Color& selectedColor)
 {
-  auto visitor = CollectDirectSelectedLinksVisitor{
-    document.editorContext(), defaultColor, selectedColor};
-  return collectSelectedLinks(document.selectedNodes(), visitor);
+  removeSourceLinks(source);
+
+  if (editorContext.visible(&source))
+  {
+    auto sourceLinks = SourceLinks{};
+    const auto addTargets = [&](const auto& targets) {
+      for (const auto* target : targets)
+      {
+        if (editorContext.visible(target))
+        {
+          addLink(source, *target, defaultColor, selectedColor, sourceLinks.vertices);
+          sourceLinks.targets.push_back(target);
+          m_sourcesByTarget[target].push_back(&source);
+        }
+      }
+    };
+
+    addTargets(source.linkTargets());
+    addTargets(source.killTargets());
+
+    if (!sourceLinks.targets.empty())
+    {
+      m_linksBySource.emplace(&source, std::move(sourceLinks));
+    }
+  }
 }
 
-auto getLinks(
-  View::MapDocument& document, const Color& defaultColor, const Color& selectedColor)
+void EntityLinkCache::removeSourceLinks(const Model::EntityNodeBase& source)
+{
+  if (const auto it = m_linksBySource.find(&source); it != m_linksBySource.end())
+  {
+    for (const auto* target : it->second.targets)
+    {
+      const auto sourcesIt = m_sourcesByTarget.find(target);
+      assert(sourcesIt != m_sourcesByTarget.end());
+
+      auto& sources = sourcesIt->second;
+      sources.erase(std::find(sources.begin(), sources.end(), &source));
+      if (sources.empty())
+      {
+        m_sourcesByTarget.erase(sourcesIt);
+      }
+    }
+    m_linksBySource.erase(it);
+  }
+}
+
+void EntityLinkRenderer::invalidate()
+{
+  m_allLinks.invalidate();
+  LinkRenderer::invalidate();
+}
+
+void EntityLinkRenderer::invalidateNodes(const std::vector<Model::Node*>& nodes)
+{
+  m_allLinks.invalidateNodes(nodes);
+  LinkRenderer::invalidate();
+}
+
+void EntityLinkRenderer::addNodes(const std::vector<Model::Node*>& nodes)
+{
+  m_allLinks.addNodes(nodes);
+  LinkRenderer::invalidate();
+}
+
+void EntityLinkRenderer::removeNodes(const std::vector<Model::Node*>& nodes)
+{
+  m_allLinks.removeNodes(nodes);
+  LinkRenderer::invalidate();
+}
+
+std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
 {
+  auto document = kdl::mem_lock(m_document);
+
   const auto entityLinkMode = pref(Preferences::EntityLinkMode);
   if (entityLinkMode == Preferences::entityLinkModeAll())
   {
-    return getAllLinks(document, defaultColor, selectedColor);
+    if (!document->world())
+    {
+      return std::vector<LinkRenderer::LineVertex>{};
+    }
+    return m_allLinks.getLinks(
+      *document->world(), document->editorContext(), m_defaultColor, m_selectedColor);
   }
+
+  m_allLinks.invalidate();
   if (entityLinkMode == Preferences::entityLinkModeTransitive())
   {
-    return getTransitiveSelectedLinks(document, defaultColor, selectedColor);
+    return getTransitiveSelectedLinks(*document, m_defaultColor, m_selectedColor);
   }
   if (entityLinkMode == Preferences::entityLinkModeDirect())
   {
-    return getDirectSelectedLinks(document, defaultColor, selectedColor);
+    return getDirectSelectedLinks(*document, m_defaultColor, m_selectedColor);
   }
 
   return std::vector<LinkRenderer::LineVertex>{};
 }
-} // namespace
-
-std::vector<LinkRenderer::LineVertex> EntityLinkRenderer::getLinks()
-{
-  return Renderer::getLinks(*kdl::mem_lock(m_document), m_defaultColor, m_selectedColor);
-}
 
 } // namespace TrenchBroom::Renderer
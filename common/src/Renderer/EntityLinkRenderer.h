@@ -24,8 +24,18 @@
 #include "Renderer/LinkRenderer.h"
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+namespace TrenchBroom::Model
+{
+class EditorContext;
+class EntityNodeBase;
+class Node;
+class WorldNode;
+} // namespace TrenchBroom::Model
+
 namespace TrenchBroom::View
 {
 class MapDocument; // FIXME: Renderer should not depend on View
@@ -34,6 +44,67 @@ class MapDocument; // FIXME: Renderer should not depend on View
 namespace TrenchBroom::Renderer
 {
 
+/**
+ * Caches the link vertices of all visible entities. The vertices are stored per source
+ * entity, so that only the links from and to changed entities must be recomputed.
+ *
+ * Changes that affect the visibility of many entities, such as hiding a layer, or the
+ * colors of the links must invalidate the entire cache.
+ */
+class EntityLinkCache
+{
+private:
+  struct SourceLinks
+  {
+    std::vector<LinkRenderer::LineVertex> vertices;
+    std::vector<const Model::EntityNodeBase*> targets;
+  };
+
+  std::unordered_map<const Model::EntityNodeBase*, SourceLinks> m_linksBySource;
+  std::unordered_map<
+    const Model::EntityNodeBase*,
+    std::vector<const Model::EntityNodeBase*>>
+    m_sourcesByTarget;
+  std::unordered_set<const Model::EntityNodeBase*> m_invalidSources;
+  bool m_valid = false;
+
+public:
+  void invalidate();
+
+  /**
+   * Invalidates the links from and to the given entity nodes and to the entity nodes
+   * containing the given brush and patch nodes. Does not recurse into groups.
+   */
+  void invalidateNodes(const std::vector<Model::Node*>& nodes);
+
+  /**
+   * Invalidates the links from and to the given nodes and their descendants after they
+   * were added to the world.
+   */
+  void addNodes(const std::vector<Model::Node*>& nodes);
+
+  /**
+   * Removes the links from and to the given nodes and their descendants after they were
+   * removed from the world.
+   */
+  void removeNodes(const std::vector<Model::Node*>& nodes);
+
+  std::vector<LinkRenderer::LineVertex> getLinks(
+    const Model::WorldNode& world,
+    const Model::EditorContext& editorContext,
+    const Color& defaultColor,
+    const Color& selectedColor);
+
+private:
+  void invalidateEntityNode(const Model::EntityNodeBase& node);
+  void updateSourceLinks(
+    const Model::EntityNodeBase& source,
+    const Model::EditorContext& editorContext,
+    const Color& defaultColor,
+    const Color& selectedColor);
+  void removeSourceLinks(const Model::EntityNodeBase& source);
+};
+
 class EntityLinkRenderer : public LinkRenderer
 {
   std::weak_ptr<View::MapDocument> m_document;
@@ -41,12 +112,19 @@ class EntityLinkRenderer : public LinkRenderer
   Color m_defaultColor = {0.5f, 1.0f, 0.5f, 1.0f};
   Color m_selectedColor = {1.0f, 0.0f, 0.0f, 1.0f};
 
+  EntityLinkCache m_allLinks;
+
 public:
   explicit EntityLinkRenderer(std::weak_ptr<View::MapDocument> document);
 
   void setDefaultColor(const Color& color);
   void setSelectedColor(const Color& color);
 
+  void invalidate() override;
+  void invalidateNodes(const std::vector<Model::Node*>& nodes);
+  void addNodes(const std::vector<Model::Node*>& nodes);
+  void removeNodes(const std::vector<Model::Node*>& nodes);
+
 private:
   std::vector<LinkRenderer::LineVertex> getLinks() override;
 
@@ -38,15 +38,48 @@
 #include "Renderer/RenderUtils.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
-#include "Renderer/Transformation.h"
 
 #include "vm/mat.h"
 
+#include <numeric>
 #include <vector>
 
 namespace TrenchBroom::Renderer
 {
 
+std::vector<EntityModelInstances> buildEntityModelInstances(
+  const std::unordered_map<const Model::EntityNode*, MaterialRenderer*>& entities)
+{
+  auto result = std::vector<EntityModelInstances>{};
+  auto rendererToIndex = std::unordered_map<const MaterialRenderer*, size_t>{};
+
+  for (const auto& [entityNode, renderer] : entities)
+  {
+    const auto* model = entityNode->entity().model();
+    const auto* modelData = model ? model->data() : nullptr;
+    if (!modelData)
+    {
+      continue;
+    }
+
+    const auto [it, inserted] = rendererToIndex.emplace(renderer, result.size());
+    if (inserted)
+    {
+      result.push_back(EntityModelInstances{renderer, modelData->orientation(), {}, {}});
+    }
+
+    const auto& defaultModelScaleExpression =
+      entityNode->entityPropertyConfig().defaultModelScaleExpression;
+
+    auto& instances = result[it->second];
+    instances.entityNodes.push_back(entityNode);
+    instances.transformations.emplace_back(
+      entityNode->entity().modelTransformation(defaultModelScaleExpression));
+  }
+
+  return result;
+}
+
 EntityModelRenderer::EntityModelRenderer(
   Logger& logger,
   Assets::EntityModelManager& entityModelManager,
@@ -73,12 +106,16 @@ void EntityModelRenderer::addEntity(const Model::EntityNode* entityNode)
   if (renderer != nullptr)
   {
     m_entities.emplace(entityNode, renderer);
+    m_instancesValid = false;
   }
 }
 
 void EntityModelRenderer::removeEntity(const Model::EntityNode* entityNode)
 {
-  m_entities.erase(entityNode);
+  if (m_entities.erase(entityNode) > 0)
+  {
+    m_instancesValid = false;
+  }
 }
 
 void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
@@ -96,6 +133,9 @@ void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
     return;
   }
 
+  // the model transformation may have changed even if the renderer is the same
+  m_instancesValid = false;
+
   if (it == std::end(m_entities))
   {
     m_entities.emplace(entityNode, renderer);
@@ -116,6 +156,8 @@ void EntityModelRenderer::updateEntity(const Model::EntityNode* entityNode)
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  m_instances.clear();
+  m_instancesValid = false;
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -153,6 +195,21 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
   renderBatch.add(this);
 }
 
+void EntityModelRenderer::validateInstances()
+{
+  if (!m_instancesValid)
+  {
+    m_instances = buildEntityModelInstances(m_entities);
+
+    // entities whose model data is still being loaded are picked up on the next render
+    const auto instanceCount = std::accumulate(
+      m_instances.begin(), m_instances.end(), size_t(0), [](auto count, const auto& i) {
+        return count + i.entityNodes.size();
+      });
+    m_instancesValid = instanceCount == m_entities.size();
+  }
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
@@ -190,35 +247,33 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
     shader.set("CameraUp", renderContext.camera().up());
     shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+    validateInstances();
 
-    for (const auto& [entityNode, renderer] : m_entities)
+    auto visibleTransformations = std::vector<vm::mat4x4f>{};
+    for (const auto& instances : m_instances)
     {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+      visibleTransformations.clear();
+      for (size_t i = 0; i < instances.entityNodes.size(); ++i)
       {
-        continue;
+        if (m_showHiddenEntities || m_editorContext.visible(instances.entityNodes[i]))
+        {
+          visibleTransformations.push_back(instances.transformations[i]);
+        }
       }
 
-      const auto* model = entityNode->entity().model();
-      const auto* modelData = model ? model->data() : nullptr;
-      if (!modelData)
+      if (visibleTransformations.empty())
       {
         continue;
       }
 
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
-
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
-      const auto multMatrix =
-        MultiplyModelMatrix{renderContext.transformation(), transformation};
-
-      shader.set("ModelMatrix", transformation);
+      shader.set("Orientation", static_cast<int>(instances.orientation));
 
       auto renderFunc = DefaultMaterialRenderFunc{
         renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
+      instances.renderer->renderInstances(
+        renderFunc, visibleTransformations.size(), [&](const size_t i) {
+          shader.set("ModelMatrix", visibleTransformations[i]);
+        });
     }
   }
 }
@@ -19,10 +19,14 @@
 
 #pragma once
 
+#include "Assets/EntityModel.h"
 #include "Color.h"
 #include "Renderer/Renderable.h"
 
+#include "vm/mat.h"
+
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -46,6 +50,25 @@ class RenderBatch;
 class ShaderConfig;
 class MaterialRenderer;
 
+/**
+ * The entities that share a model renderer, i.e., that show the same frame of the same
+ * model with the same skin, together with their model transformations.
+ */
+struct EntityModelInstances
+{
+  MaterialRenderer* renderer;
+  Assets::Orientation orientation;
+  std::vector<const Model::EntityNode*> entityNodes;
+  std::vector<vm::mat4x4f> transformations;
+};
+
+/**
+ * Groups the given entities by their model renderers. Entities whose model data is not
+ * available are omitted.
+ */
+std::vector<EntityModelInstances> buildEntityModelInstances(
+  const std::unordered_map<const Model::EntityNode*, MaterialRenderer*>& entities);
+
 class EntityModelRenderer : public DirectRenderable
 {
 private:
@@ -56,6 +79,10 @@ private:
 
   std::unordered_map<const Model::EntityNode*, MaterialRenderer*> m_entities;
 
+  // Rebuilt when an entity is added, removed or updated, or when it is incomplete
+  std::vector<EntityModelInstances> m_instances;
+  bool m_instancesValid = false;
+
   bool m_applyTinting = false;
   Color m_tintColor;
 
@@ -111,6 +138,8 @@ public:
   void render(RenderBatch& renderBatch);
 
 private:
+  void validateInstances();
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
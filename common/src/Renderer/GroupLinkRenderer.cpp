@@ -19,27 +19,87 @@
 
 #include "GroupLinkRenderer.h"
 
+#include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
+#include "Model/EntityNode.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
 #include "Model/LinkedGroupUtils.h"
 #include "Model/ModelUtils.h"
+#include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "View/MapDocument.h"
 
 #include "kdl/memory_utils.h"
+#include "kdl/overload.h"
+#include "kdl/vector_utils.h"
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
+void GroupLinkCache::invalidate()
+{
+  m_valid = false;
+}
+
+void GroupLinkCache::invalidateNodes(const std::vector<Model::Node*>& nodes)
+{
+  if (m_valid)
+  {
+    for (auto* node : nodes)
+    {
+      node->accept(kdl::overload(
+        [](const Model::WorldNode*) {},
+        [](const Model::LayerNode*) {},
+        [&](const Model::GroupNode* groupNode) {
+          const auto isCached = kdl::vec_contains(m_linkedGroupNodes, groupNode);
+          const auto isLinked = groupNode->linkId() == m_linkId;
+          if (isCached != isLinked)
+          {
+            m_valid = false;
+          }
+        },
+        [](const Model::EntityNode*) {},
+        [](const Model::BrushNode*) {},
+        [](const Model::PatchNode*) {}));
+    }
+  }
+}
+
+const std::vector<Model::GroupNode*>& GroupLinkCache::getLinkedGroups(
+  Model::WorldNode& world, const Model::GroupNode& groupNode)
+{
+  if (!m_valid || &groupNode != m_groupNode || groupNode.linkId() != m_linkId)
+  {
+    m_groupNode = &groupNode;
+    m_linkId = groupNode.linkId();
+    m_linkedGroupNodes = Model::collectGroupsWithLinkId({&world}, m_linkId);
+    m_valid = true;
+  }
+  return m_linkedGroupNodes;
+}
+
 GroupLinkRenderer::GroupLinkRenderer(std::weak_ptr<View::MapDocument> document)
   : m_document(document)
 {
 }
 
+void GroupLinkRenderer::invalidate()
+{
+  m_linkedGroups.invalidate();
+  LinkRenderer::invalidate();
+}
+
+void GroupLinkRenderer::invalidateNodes(const std::vector<Model::Node*>& nodes)
+{
+  m_linkedGroups.invalidateNodes(nodes);
+  LinkRenderer::invalidate();
+}
+
 static vm::vec3f getLinkAnchorPosition(const Model::GroupNode& groupNode)
 {
   return vm::vec3f(groupNode.logicalBounds().center());
@@ -58,9 +118,8 @@ std::vector<LinkRenderer::LineVertex> GroupLinkRenderer::getLinks()
 
   if (groupNode)
   {
-    const auto& linkId = groupNode->linkId();
-    const auto linkedGroupNodes =
-      Model::collectGroupsWithLinkId({document->world()}, linkId);
+    const auto& linkedGroupNodes =
+      m_linkedGroups.getLinkedGroups(*document->world(), *groupNode);
 
     const auto linkColor = pref(Preferences::LinkedGroupColor);
     const auto sourcePosition = getLinkAnchorPosition(*groupNode);
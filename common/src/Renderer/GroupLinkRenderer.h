@@ -23,10 +23,18 @@
 #include "Renderer/LinkRenderer.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom
 {
+namespace Model
+{
+class GroupNode;
+class Node;
+class WorldNode;
+} // namespace Model
+
 namespace View
 {
 class MapDocument; // FIXME: Renderer should not depend on View
@@ -34,13 +42,53 @@ class MapDocument; // FIXME: Renderer should not depend on View
 
 namespace Renderer
 {
+
+/**
+ * Caches the groups linked to a group until the group or its link ID change, or until the
+ * groups with its link ID change.
+ */
+class GroupLinkCache
+{
+private:
+  const Model::GroupNode* m_groupNode = nullptr;
+  std::string m_linkId;
+  std::vector<Model::GroupNode*> m_linkedGroupNodes;
+  bool m_valid = false;
+
+public:
+  void invalidate();
+
+  /**
+   * Only invalidates the cache if any of the given nodes is a group whose link ID was
+   * changed to or from the cached link ID.
+   */
+  void invalidateNodes(const std::vector<Model::Node*>& nodes);
+
+  /**
+   * Returns the groups in the given world that have the same link ID as the given group,
+   * including the given group itself.
+   */
+  const std::vector<Model::GroupNode*>& getLinkedGroups(
+    Model::WorldNode& world, const Model::GroupNode& groupNode);
+};
+
 class GroupLinkRenderer : public LinkRenderer
 {
   std::weak_ptr<View::MapDocument> m_document;
 
+  GroupLinkCache m_linkedGroups;
+
 public:
   GroupLinkRenderer(std::weak_ptr<View::MapDocument> document);
 
+  void invalidate() override;
+
+  /**
+   * Invalidates the links, but only collects the linked groups again if any of the given
+   * nodes is a group whose link ID was changed to or from the cached link ID.
+   */
+  void invalidateNodes(const std::vector<Model::Node*>& nodes);
+
 private:
   std::vector<LinkRenderer::LineVertex> getLinks() override;
 
@@ -61,7 +61,7 @@ public:
   LinkRenderer();
 
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
-  void invalidate();
+  virtual void invalidate();
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
@@ -711,7 +711,7 @@ void MapRenderer::nodesWereAdded(const std::vector<Model::Node*>& nodes)
     updateAndInvalidateNodeRecursive(node);
   }
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->addNodes(nodes);
 }
 
 void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
@@ -723,7 +723,7 @@ void MapRenderer::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
     removeNodeRecursive(node);
   }
   invalidateGroupLinkRenderer();
-  invalidateEntityLinkRenderer();
+  m_entityLinkRenderer->removeNodes(nodes);
 }
 
 void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
@@ -735,8 +735,8 @@ void MapRenderer::nodesDidChange(const std::vector<Model::Node*>& nodes)
     // it would cause the entire map to be invalidated on every change.
     updateAndInvalidateNode(node);
   }
-  invalidateEntityLinkRenderer();
-  invalidateGroupLinkRenderer();
+  m_entityLinkRenderer->invalidateNodes(nodes);
+  m_groupLinkRenderer->invalidateNodes(nodes);
 }
 
 void MapRenderer::nodeVisibilityDidChange(const std::vector<Model::Node*>& nodes)
@@ -798,8 +798,11 @@ void MapRenderer::selectionDidChange(const View::Selection& selection)
     updateAndInvalidateNodeRecursive(node);
   }
 
-  invalidateEntityLinkRenderer();
-  invalidateGroupLinkRenderer();
+  // only the links of entities that were (de)selected or contain (de)selected brushes
+  // and patches change their color
+  m_entityLinkRenderer->invalidateNodes(selection.deselectedNodes());
+  m_entityLinkRenderer->invalidateNodes(selection.selectedNodes());
+  m_groupLinkRenderer->invalidateNodes(selection.selectedNodes());
 }
 
 void MapRenderer::resourcesWereProcessed(
@@ -177,6 +177,22 @@ public:
    */
   void render(VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Renders the primitives stored in this index range map once for each of the given
+   * number of instances. Every material is activated only once, and the given setup
+   * function is called with the index of each instance before it is rendered.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param func the material callbacks
+   * @param instanceCount the number of instances to render
+   * @param setupInstance the function to call before each instance is rendered
+   */
+  void renderInstances(
+    VertexArray& vertexArray,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -22,6 +22,7 @@
 #include "Renderer/MaterialIndexRangeMap.h"
 #include "Renderer/VertexArray.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -46,6 +47,16 @@ public:
 
   virtual void prepare(VboManager& vboManager) = 0;
   virtual void render(MaterialRenderFunc& func) = 0;
+
+  /**
+   * Renders this renderer once for each of the given number of instances. The vertex data
+   * and the materials are bound only once for all instances, and the given setup
+   * function is called with the index of each instance before it is rendered.
+   */
+  virtual void renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) = 0;
 };
 
 class MaterialIndexRangeRenderer : public MaterialRenderer
@@ -68,6 +79,10 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  void renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) override;
 };
 
 class MultiMaterialIndexRangeRenderer : public MaterialRenderer
@@ -84,6 +99,10 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  void renderInstances(
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
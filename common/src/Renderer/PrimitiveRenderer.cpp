@@ -286,7 +286,7 @@ void PrimitiveRenderer::renderPolygon(
   const Color& color,
   float lineWidth,
   const PrimitiveRendererOcclusionPolicy occlusionPolicy,
-  const std::vector<vm::vec3f>& positions)
+  const std::span<const vm::vec3f> positions)
 {
   m_lineMeshes[LineRenderAttributes(color, lineWidth, occlusionPolicy)].addLineLoop(
     Vertex::toList(positions.size(), std::begin(positions)));
@@ -296,7 +296,7 @@ void PrimitiveRenderer::renderFilledPolygon(
   const Color& color,
   const PrimitiveRendererOcclusionPolicy occlusionPolicy,
   const PrimitiveRendererCullingPolicy cullingPolicy,
-  const std::vector<vm::vec3f>& positions)
+  const std::span<const vm::vec3f> positions)
 {
   m_triangleMeshes[TriangleRenderAttributes(color, occlusionPolicy, cullingPolicy)]
     .addTriangleFan(Vertex::toList(positions.size(), std::begin(positions)));
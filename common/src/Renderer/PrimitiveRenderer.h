@@ -24,6 +24,7 @@
 #include "Renderer/Renderable.h"
 
 #include <map>
+#include <span>
 #include <vector>
 
 namespace TrenchBroom
@@ -149,12 +150,12 @@ public:
     const Color& color,
     float lineWidth,
     PrimitiveRendererOcclusionPolicy occlusionPolicy,
-    const std::vector<vm::vec3f>& positions);
+    std::span<const vm::vec3f> positions);
   void renderFilledPolygon(
     const Color& color,
     PrimitiveRendererOcclusionPolicy occlusionPolicy,
     PrimitiveRendererCullingPolicy cullingPolicy,
-    const std::vector<vm::vec3f>& positions);
+    std::span<const vm::vec3f> positions);
 
   void renderCylinder(
     const Color& color,
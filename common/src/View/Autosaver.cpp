@@ -25,6 +25,9 @@
 #include "IO/FileSystem.h"
 #include "IO/PathInfo.h"
 #include "IO/TraversalMode.h"
+#include "Model/Game.h"
+#include "Model/WorldNode.h"
+#include "View/CachingLogger.h"
 #include "View/MapDocument.h"
 
 #include "kdl/memory_utils.h"
@@ -34,6 +37,7 @@
 #include "kdl/string_compare.h"
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
 #include <algorithm> // for std::sort
@@ -66,11 +70,24 @@ Autosaver::Autosaver(
   , m_maxBackups{maxBackups}
   , m_lastSaveTime{Clock::now()}
   , m_lastModificationCount{kdl::mem_lock(m_document)->modificationCount()}
+  , m_taskManager{std::make_unique<kdl::task_manager>(1)}
 {
 }
 
+Autosaver::~Autosaver() = default;
+
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (m_pendingBackup)
+  {
+    using namespace std::chrono_literals;
+    if (m_pendingBackup->backupFilePath.wait_for(0s) != std::future_status::ready)
+    {
+      return;
+    }
+    finishAutosave(logger);
+  }
+
   if (!kdl::mem_expired(m_document))
   {
     auto document = kdl::mem_lock(m_document);
@@ -78,7 +95,7 @@ void Autosaver::triggerAutosave(Logger& logger)
       document->modified() && document->modificationCount() != m_lastModificationCount
       && Clock::now() - m_lastSaveTime >= m_saveInterval && document->persistent())
     {
-      autosave(logger, document);
+      autosave(document);
     }
   }
 }
@@ -153,32 +170,89 @@ Result<void> cleanBackups(
          | kdl::fold;
 }
 
+Result<std::filesystem::path> createBackup(
+  Logger& logger,
+  const Model::Game& game,
+  Model::WorldNode& world,
+  const std::filesystem::path& mapPath,
+  const size_t maxBackups)
+{
+  const auto mapBasename = mapPath.stem();
+
+  return createBackupFileSystem(mapPath) | kdl::and_then([&](auto fs) {
+           return collectBackups(fs, mapBasename) | kdl::and_then([&](auto backups) {
+                    return thinBackups(logger, fs, backups, maxBackups);
+                  })
+                  | kdl::and_then([&](auto remainingBackups) {
+                      return cleanBackups(fs, remainingBackups, mapBasename)
+                             | kdl::and_then([&]() {
+                                 assert(remainingBackups.size() < maxBackups);
+                                 const auto backupNo = remainingBackups.size() + 1;
+                                 return fs.makeAbsolute(
+                                   makeBackupName(mapBasename, backupNo));
+                               });
+                    });
+         })
+         | kdl::and_then([&](auto backupFilePath) {
+             // write to a temporary file first so that an incomplete backup is never
+             // mistaken for a valid one
+             const auto tempFilePath = kdl::path_add_extension(backupFilePath, ".tmp");
+             return game.writeMap(world, tempFilePath) | kdl::and_then([&]() {
+                      return IO::Disk::moveFile(tempFilePath, backupFilePath);
+                    })
+                    | kdl::transform([&]() { return backupFilePath; });
+           });
+}
+
 } // namespace
 
-void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
+void Autosaver::waitForAutosave(Logger& logger)
+{
+  if (m_pendingBackup)
+  {
+    m_pendingBackup->backupFilePath.wait();
+    finishAutosave(logger);
+  }
+}
+
+void Autosaver::autosave(std::shared_ptr<MapDocument> document)
 {
   const auto& mapPath = document->path();
   assert(IO::Disk::pathInfo(mapPath) == IO::PathInfo::File);
 
-  const auto mapFilename = mapPath.filename();
-  const auto mapBasename = mapPath.stem();
+  // the worker only touches the snapshot, the game config and its own logger
+  auto snapshot = std::shared_ptr<Model::WorldNode>{document->makeWorldSnapshot()};
+  auto backupLogger = std::make_unique<CachingLogger>();
 
-  createBackupFileSystem(mapPath) | kdl::and_then([&](auto fs) {
-    return collectBackups(fs, mapBasename) | kdl::and_then([&](auto backups) {
-             return thinBackups(logger, fs, backups, m_maxBackups);
-           })
-           | kdl::and_then([&](auto remainingBackups) {
-               return cleanBackups(fs, remainingBackups, mapBasename)
-                      | kdl::and_then([&]() {
-                          assert(remainingBackups.size() < m_maxBackups);
-                          const auto backupNo = remainingBackups.size() + 1;
-                          return fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
-                        });
-             });
-  }) | kdl::transform([&](const auto& backupFilePath) {
-    m_lastSaveTime = Clock::now();
-    m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
+  auto backupFilePath = m_taskManager->run_task(
+    [&backupLogger = *backupLogger,
+     game = document->game(),
+     snapshot = std::move(snapshot),
+     mapPath = mapPath,
+     maxBackups = m_maxBackups]() {
+      return createBackup(backupLogger, *game, *snapshot, mapPath, maxBackups);
+    });
+
+  m_pendingBackup = PendingBackup{
+    std::move(backupFilePath),
+    std::move(backupLogger),
+    Clock::now(),
+    document->modificationCount()};
+}
+
+void Autosaver::finishAutosave(Logger& logger)
+{
+  assert(m_pendingBackup);
+
+  auto pendingBackup = std::move(*m_pendingBackup);
+  m_pendingBackup = std::nullopt;
+
+  // log the messages that were cached while the backup was written
+  pendingBackup.logger->setParentLogger(&logger);
+
+  pendingBackup.backupFilePath.get() | kdl::transform([&](const auto& backupFilePath) {
+    m_lastSaveTime = pendingBackup.saveTime;
+    m_lastModificationCount = pendingBackup.modificationCount;
 
     logger.info() << "Created autosave backup at " << backupFilePath;
   }) | kdl::transform_error([&](auto e) {
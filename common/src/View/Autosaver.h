@@ -19,11 +19,22 @@
 
 #pragma once
 
+#include "Error.h" // IWYU pragma: keep
 #include "IO/PathMatcher.h"
+#include "Result.h"
+
+#include "kdl/result.h"
 
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <optional>
+
+namespace kdl
+{
+class task_manager;
+} // namespace kdl
 
 namespace TrenchBroom
 {
@@ -32,16 +43,34 @@ class Logger;
 
 namespace TrenchBroom::View
 {
+class CachingLogger;
 class Command;
 class MapDocument;
 
 IO::PathMatcher makeBackupPathMatcher(std::filesystem::path mapBasename);
 
+/**
+ * Periodically creates backups of a document.
+ *
+ * A backup is created from a snapshot of the document's world which is taken on the
+ * calling thread. The snapshot is then written to disk and the existing backups are
+ * rotated on a worker thread, so that the document can be edited while the backup is
+ * written. Every backup is first written to a temporary file which is then renamed, so
+ * that a backup file is never observed in an incomplete state.
+ */
 class Autosaver
 {
 private:
   using Clock = std::chrono::system_clock;
 
+  struct PendingBackup
+  {
+    std::future<Result<std::filesystem::path>> backupFilePath;
+    std::unique_ptr<CachingLogger> logger;
+    std::chrono::time_point<Clock> saveTime;
+    size_t modificationCount;
+  };
+
   std::weak_ptr<MapDocument> m_document;
 
   /**
@@ -65,15 +94,33 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * The backup that is currently being written, if any.
+   */
+  std::optional<PendingBackup> m_pendingBackup;
+
+  std::unique_ptr<kdl::task_manager> m_taskManager;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
+  ~Autosaver();
 
+  /**
+   * Starts writing a backup if the document was modified and the save interval has
+   * elapsed. Does nothing while a previous backup is still being written.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Waits until the backup that is currently being written, if any, is complete.
+   */
+  void waitForAutosave(Logger& logger);
+
 private:
-  void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+  void autosave(std::shared_ptr<View::MapDocument> document);
+  void finishAutosave(Logger& logger);
 };
 } // namespace TrenchBroom::View
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
 namespace TrenchBroom::View
 {
@@ -101,6 +102,16 @@ const std::string& LayoutCell::title() const
   return m_title;
 }
 
+float LayoutCell::itemWidth() const
+{
+  return m_itemWidth;
+}
+
+float LayoutCell::itemHeight() const
+{
+  return m_itemHeight;
+}
+
 float LayoutCell::scale() const
 {
   return m_scale;
@@ -214,15 +225,16 @@ const std::vector<LayoutCell>& LayoutRow::cells() const
 
 const LayoutCell* LayoutRow::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_cells.size(); ++i)
+  // the cells are sorted by their x coordinates, so skip those left of x
+  const auto first = std::partition_point(
+    m_cells.begin(), m_cells.end(), [&](const auto& cell) {
+      return x > cell.cellBounds().right();
+    });
+
+  for (auto it = first; it != m_cells.end(); ++it)
   {
-    const auto& cell = m_cells[i];
-    const auto& cellBounds = cell.cellBounds();
-    if (x > cellBounds.right())
-    {
-      continue;
-    }
-    if (x < cellBounds.left())
+    const auto& cell = *it;
+    if (x < cell.cellBounds().left())
     {
       return nullptr;
     }
@@ -447,32 +459,40 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
   return m_rows;
 }
 
-size_t LayoutGroup::indexOfRowAt(const float y) const
+LayoutGroup::RowRange LayoutGroup::rowsIntersectingY(
+  const float y, const float height) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
-  {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y < rowBounds.bottom())
-    {
-      return i;
-    }
-  }
+  const auto first =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return row.bounds().bottom() < y;
+    });
+  const auto last = std::partition_point(first, m_rows.end(), [&](const auto& row) {
+    return row.bounds().top() <= y + height;
+  });
+  return RowRange{first, last};
+}
 
-  return m_rows.size();
+size_t LayoutGroup::indexOfRowAt(const float y) const
+{
+  const auto it =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return y >= row.bounds().bottom();
+    });
+  return size_t(std::distance(m_rows.begin(), it));
 }
 
 const LayoutCell* LayoutGroup::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
+  // the rows are sorted by their y coordinates, so skip those above y
+  const auto first =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return y > row.bounds().bottom();
+    });
+
+  for (auto it = first; it != m_rows.end(); ++it)
   {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y > rowBounds.bottom())
-    {
-      continue;
-    }
-    if (y < rowBounds.top())
+    const auto& row = *it;
+    if (y < row.bounds().top())
     {
       return nullptr;
     }
@@ -722,18 +742,11 @@ float CellLayout::rowPosition(const float y, const int offset)
     validate();
   }
 
-  auto groupIndex = m_groups.size();
-  for (size_t i = 0; i < m_groups.size(); ++i)
-  {
-    const LayoutGroup& candidate = m_groups[i];
-    const LayoutBounds groupBounds = candidate.bounds();
-    if (y + m_rowMargin > groupBounds.bottom())
-    {
-      continue;
-    }
-    groupIndex = i;
-    break;
-  }
+  auto groupIndex = size_t(std::distance(
+    m_groups.begin(),
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return y + m_rowMargin > group.bounds().bottom();
+    })));
 
   if (groupIndex == m_groups.size())
   {
@@ -802,6 +815,23 @@ const std::vector<LayoutGroup>& CellLayout::groups()
   return m_groups;
 }
 
+CellLayout::GroupRange CellLayout::groupsIntersectingY(const float y, const float height)
+{
+  if (!m_valid)
+  {
+    validate();
+  }
+
+  const auto first =
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return group.bounds().bottom() < y;
+    });
+  const auto last = std::partition_point(first, m_groups.end(), [&](const auto& group) {
+    return group.bounds().top() <= y + height;
+  });
+  return GroupRange{first, last};
+}
+
 const LayoutCell* CellLayout::cellAt(const float x, const float y)
 {
   if (!m_valid)
@@ -809,15 +839,16 @@ const LayoutCell* CellLayout::cellAt(const float x, const float y)
     validate();
   }
 
-  for (size_t i = 0; i < m_groups.size(); ++i)
+  // the groups are sorted by their y coordinates, so skip those above y
+  const auto first =
+    std::partition_point(m_groups.begin(), m_groups.end(), [&](const auto& group) {
+      return y > group.bounds().bottom();
+    });
+
+  for (auto it = first; it != m_groups.end(); ++it)
   {
-    const auto& group = m_groups[i];
-    const auto groupBounds = group.bounds();
-    if (y > groupBounds.bottom())
-    {
-      continue;
-    }
-    if (y < groupBounds.top())
+    const auto& group = *it;
+    if (y < group.bounds().top())
     {
       return nullptr;
     }
@@ -905,6 +936,40 @@ void CellLayout::addItem(
   m_height += (newGroupHeight - oldGroupHeight);
 }
 
+bool CellLayout::updateItemSizes(const ItemSizeFunction& getItemSize)
+{
+  if (!m_valid)
+  {
+    validate();
+  }
+
+  const auto hasChangedSize = [&]() {
+    for (const auto& group : m_groups)
+    {
+      for (const auto& row : group.rows())
+      {
+        for (const auto& cell : row.cells())
+        {
+          const auto itemSize = getItemSize(cell);
+          if (itemSize && *itemSize != vm::vec2f{cell.itemWidth(), cell.itemHeight()})
+          {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  };
+
+  if (!hasChangedSize())
+  {
+    return false;
+  }
+
+  layoutItems(getItemSize);
+  return true;
+}
+
 void CellLayout::clear()
 {
   m_groups.clear();
@@ -918,6 +983,11 @@ void CellLayout::validate()
     return;
   }
 
+  layoutItems([](const auto&) -> std::optional<vm::vec2f> { return std::nullopt; });
+}
+
+void CellLayout::layoutItems(const ItemSizeFunction& getItemSize)
+{
   m_height = 2.0f * m_outerMargin;
   m_valid = true;
   if (!m_groups.empty())
@@ -932,16 +1002,14 @@ void CellLayout::validate()
       {
         for (const auto& cell : row.cells())
         {
-          const auto& itemBounds = cell.itemBounds();
+          const auto itemSize =
+            getItemSize(cell).value_or(vm::vec2f{cell.itemWidth(), cell.itemHeight()});
           const auto& titleBounds = cell.titleBounds();
-          const auto scale = cell.scale();
-          const auto itemWidth = itemBounds.width / scale;
-          const auto itemHeight = itemBounds.height / scale;
           addItem(
             cell.item(),
             cell.title(),
-            itemWidth,
-            itemHeight,
+            itemSize.x(),
+            itemSize.y(),
             titleBounds.width,
             titleBounds.height);
         }
@@ -19,10 +19,14 @@
 
 #pragma once
 
+#include "kdl/range.h"
+
 #include "vm/forward.h"
 #include "vm/vec.h"
 
 #include <any>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -94,6 +98,8 @@ public:
 
   const std::string& title() const;
 
+  float itemWidth() const;
+  float itemHeight() const;
   float scale() const;
 
   const LayoutBounds& bounds() const;
@@ -164,6 +170,9 @@ private:
 
 class LayoutGroup
 {
+public:
+  using RowRange = kdl::range<std::vector<LayoutRow>::const_iterator>;
+
 private:
   std::string m_title;
   float m_cellMargin;
@@ -219,6 +228,13 @@ public:
   LayoutBounds bounds() const;
 
   const std::vector<LayoutRow>& rows() const;
+
+  /**
+   * Returns the rows that intersect the given vertical range. Since the rows are sorted
+   * by their y coordinates, they are found by binary search.
+   */
+  RowRange rowsIntersectingY(float y, float height) const;
+
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
 
@@ -236,6 +252,15 @@ public:
 
 class CellLayout
 {
+public:
+  /**
+   * Returns the new unscaled size of the item of the given cell, or nothing if the size
+   * of the item did not change.
+   */
+  using ItemSizeFunction = std::function<std::optional<vm::vec2f>(const LayoutCell&)>;
+
+  using GroupRange = kdl::range<std::vector<LayoutGroup>::const_iterator>;
+
 private:
   size_t m_maxCellsPerRow;
   float m_width = 1.0f;
@@ -295,6 +320,13 @@ public:
   void setWidth(float width);
 
   const std::vector<LayoutGroup>& groups();
+
+  /**
+   * Returns the groups that intersect the given vertical range. Since the groups are
+   * sorted by their y coordinates, they are found by binary search.
+   */
+  GroupRange groupsIntersectingY(float y, float height);
+
   const LayoutCell* cellAt(float x, float y);
 
   void addGroup(std::string title, float titleHeight);
@@ -306,10 +338,20 @@ public:
     float titleWidth,
     float titleHeight);
 
+  /**
+   * Changes the sizes of the items for which the given function returns a new size and
+   * lays out the existing cells again. Returns true if the size of any item changed.
+   *
+   * This is much cheaper than clearing the layout and adding all items again, because the
+   * items and their titles are kept.
+   */
+  bool updateItemSizes(const ItemSizeFunction& getItemSize);
+
   void clear();
 
 private:
   void validate();
+  void layoutItems(const ItemSizeFunction& getItemSize);
 };
 
 } // namespace TrenchBroom::View
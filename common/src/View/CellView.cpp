@@ -118,6 +118,15 @@ void CellView::clear()
   m_valid = true;
 }
 
+void CellView::updateItemSizes(const Layout::ItemSizeFunction& getItemSize)
+{
+  // an invalid layout is reloaded with the current item sizes anyway
+  if (m_valid && m_layout.updateItemSizes(getItemSize))
+  {
+    updateScrollBar();
+  }
+}
+
 void CellView::resizeEvent(QResizeEvent* event)
 {
   validate();
@@ -408,9 +417,9 @@ void CellView::renderTitleBackgrounds(float y, float height)
   using Vertex = Renderer::GLVertexTypes::P2::Vertex;
   auto vertices = std::vector<Vertex>{};
 
-  for (const auto& group : m_layout.groups())
+  for (const auto& group : m_layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height) && !group.title().empty())
+    if (!group.title().empty())
     {
       const auto titleBounds = m_layout.titleBoundsForVisibleRect(group, y, height);
       vertices.emplace_back(
@@ -449,60 +458,50 @@ auto collectStringVertices(
   const auto textColor = std::vector<Color>{pref(Preferences::BrowserTextColor)};
   const auto subTextColor = std::vector<Color>{pref(Preferences::BrowserSubTextColor)};
 
+  // collect the vertices of all visible titles in one buffer per font
   auto stringVertices = std::map<Renderer::FontDescriptor, std::vector<TextVertex>>{};
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    const auto& groupTitle = group.title();
+    if (!groupTitle.empty())
     {
-      const auto& groupTitle = group.title();
-      if (!groupTitle.empty())
-      {
-        const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
-        const auto offset = vm::vec2f(
-          titleBounds.left() + 2.0f,
-          height - (titleBounds.top() - y) - titleBounds.height);
-
-        auto& font = fontManager.font(defaultFont);
-        const auto quads = font.quads(groupTitle, false, offset);
-        const auto titleVertices = TextVertex::toList(
-          quads.size() / 2,
-          kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
-          kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
-          kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-        auto& vertices = stringVertices[defaultFont];
-        vertices.insert(
-          std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
-      }
+      const auto titleBounds = layout.titleBoundsForVisibleRect(group, y, height);
+      const auto offset = vm::vec2f(
+        titleBounds.left() + 2.0f, height - (titleBounds.top() - y) - titleBounds.height);
+
+      auto& font = fontManager.font(defaultFont);
+      const auto quads = font.quads(groupTitle, false, offset);
+      const auto titleVertices = TextVertex::toList(
+        quads.size() / 2,
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
+        kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
+        kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
+      auto& vertices = stringVertices[defaultFont];
+      vertices.insert(
+        std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
+    }
 
-      for (const auto& row : group.rows())
+    for (const auto& row : group.rowsIntersectingY(y, height))
+    {
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto& title = cell.title();
+        const auto bounds = cell.titleBounds();
+        const auto fontDescriptor =
+          fontManager.selectFontSize(defaultFont, title, bounds.width, 6);
+        const auto& font = fontManager.font(fontDescriptor);
+        const auto size = font.measure(title);
+
+        const auto x = bounds.left() + std::max((bounds.width - size.x()) / 2.0f, 0.0f);
+
+        // y is relative to top, but OpenGL coords are relative to bottom, so invert
+        const auto yOffset = vm::vec2f{x, y + height - bounds.bottom()};
+
+        const auto quads = font.quads(title, false, yOffset);
+        auto& vertices = stringVertices[fontDescriptor];
+        for (size_t i = 0; i + 1 < quads.size(); i += 2)
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& title = cell.title();
-            const auto bounds = cell.titleBounds();
-            const auto fontDescriptor =
-              fontManager.selectFontSize(defaultFont, title, bounds.width, 6);
-            const auto& font = fontManager.font(fontDescriptor);
-            const auto size = font.measure(title);
-
-            const auto x =
-              bounds.left() + std::max((bounds.width - size.x()) / 2.0f, 0.0f);
-
-            // y is relative to top, but OpenGL coords are relative to bottom, so invert
-            const auto yOffset = vm::vec2f{x, y + height - bounds.bottom()};
-
-            const auto quads = font.quads(title, false, yOffset);
-            const auto vertices = TextVertex::toList(
-              quads.size() / 2,
-              kdl::skip_iterator{std::begin(quads), std::end(quads), 0, 2},
-              kdl::skip_iterator{std::begin(quads), std::end(quads), 1, 2},
-              kdl::skip_iterator{std::begin(textColor), std::end(textColor), 0, 0});
-
-            stringVertices[fontDescriptor] =
-              kdl::vec_concat(std::move(stringVertices[fontDescriptor]), vertices);
-          }
+          vertices.emplace_back(quads[i], quads[i + 1], textColor.front());
         }
       }
     }
@@ -61,6 +61,13 @@ public:
   explicit CellView(GLContextManager& contextManager, QScrollBar* scrollBar = nullptr);
   void invalidate();
   void clear();
+
+  /**
+   * Updates the sizes of the items in the layout without reloading it. Pass a function of
+   * type `const Cell& cell -> std::optional<vm::vec2f>` that returns the new size of the
+   * item of the given cell, or nothing if the size did not change.
+   */
+  void updateItemSizes(const Layout::ItemSizeFunction& getItemSize);
   void resizeEvent(QResizeEvent* event) override;
 
   /**
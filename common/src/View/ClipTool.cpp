@@ -41,10 +41,14 @@
 #include "kdl/map_utils.h"
 #include "kdl/memory_utils.h"
 #include "kdl/overload.h"
+#include "kdl/parallel.h"
+#include "kdl/result.h"
 #include "kdl/set_temp.h"
 #include "kdl/string_utils.h"
 #include "kdl/vector_utils.h"
 
+#include "vm/bbox.h"
+#include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/vec.h"
 #include "vm/vec_io.h"
@@ -54,6 +58,8 @@
 
 #include <algorithm>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom::View
 {
@@ -521,7 +527,11 @@ void ClipTool::toggleSide()
       m_clipSide = ClipSide::Front;
       break;
     }
-    update();
+
+    // the clipped brushes do not depend on the clip side
+    clearRenderers();
+    updateRenderers();
+    refreshViews();
   }
 }
 
@@ -809,36 +819,80 @@ void ClipTool::updateBrushes()
   const auto& brushNodes = document->selectedNodes().brushes();
   const auto& worldBounds = document->worldBounds();
 
-  const auto clip =
-    [&](auto* node, const auto& p1, const auto& p2, const auto& p3, auto& brushMap) {
-      auto brush = node->brush();
-      Model::BrushFace::create(
+  if (canClip())
+  {
+    const auto points = m_strategy->getPoints();
+    ensure(points.size() == 3, "invalid number of points");
+
+    const auto createClipFace = [&](const auto& p1, const auto& p2, const auto& p3) {
+      return Model::BrushFace::create(
         p1,
         p2,
         p3,
         Model::BrushFaceAttributes(document->currentMaterialName()),
-        document->world()->mapFormat())
-        | kdl::and_then([&](Model::BrushFace&& clipFace) {
-            setFaceAttributes(brush.faces(), clipFace);
-            return brush.clip(worldBounds, std::move(clipFace));
-          })
-        | kdl::transform([&]() {
-            brushMap[node->parent()].push_back(new Model::BrushNode(std::move(brush)));
-          })
-        | kdl::transform_error(
-          [&](auto e) { document->error() << "Could not clip brush: " << e.msg; });
+        document->world()->mapFormat());
     };
 
-  if (canClip())
-  {
-    const auto points = m_strategy->getPoints();
-    ensure(points.size() == 3, "invalid number of points");
+    // Returns nullopt if the given brush is entirely above the clip face and a copy of
+    // the given brush if it is entirely below the clip face. The bounds check is
+    // conservative, so brushes that pass it are clipped as usual.
+    const auto clip = [&](const Model::Brush& brush, const Model::BrushFace& clipFace)
+      -> std::optional<Result<Model::Brush>> {
+      const auto& plane = clipFace.boundary();
+      const auto corners = brush.bounds().vertices();
+      const auto allCorners = [&](const auto status) {
+        return std::all_of(corners.begin(), corners.end(), [&](const auto& corner) {
+          return plane.point_status(corner) != status;
+        });
+      };
+
+      if (allCorners(vm::plane_status::above))
+      {
+        return brush;
+      }
+      if (allCorners(vm::plane_status::below))
+      {
+        return std::nullopt;
+      }
 
-    for (auto* brushNode : brushNodes)
-    {
-      clip(brushNode, points[0], points[1], points[2], m_frontBrushes);
-      clip(brushNode, points[0], points[2], points[1], m_backBrushes);
-    }
+      auto result = brush;
+      auto face = clipFace;
+      setFaceAttributes(result.faces(), face);
+      return result.clip(worldBounds, std::move(face))
+             | kdl::transform([&]() { return std::move(result); });
+    };
+
+    const auto addBrush =
+      [&](auto* node, std::optional<Result<Model::Brush>> clipResult, auto& brushMap) {
+        if (clipResult)
+        {
+          std::move(*clipResult) | kdl::transform([&](auto brush) {
+            brushMap[node->parent()].push_back(new Model::BrushNode(std::move(brush)));
+          }) | kdl::transform_error([&](auto e) {
+            document->error() << "Could not clip brush: " << e.msg;
+          });
+        }
+      };
+
+    createClipFace(points[0], points[1], points[2])
+        .join(createClipFace(points[0], points[2], points[1]))
+      | kdl::transform([&](const auto& frontFace, const auto& backFace) {
+          // clip the brushes in parallel, but create the nodes and report errors here
+          auto clipResults =
+            kdl::vec_parallel_transform(brushNodes, [&](const auto* brushNode) {
+              return std::pair{
+                clip(brushNode->brush(), frontFace), clip(brushNode->brush(), backFace)};
+            });
+
+          for (size_t i = 0; i < brushNodes.size(); ++i)
+          {
+            auto& [frontResult, backResult] = clipResults[i];
+            addBrush(brushNodes[i], std::move(frontResult), m_frontBrushes);
+            addBrush(brushNodes[i], std::move(backResult), m_backBrushes);
+          }
+        })
+      | kdl::transform_error(
+        [&](auto e) { document->error() << "Could not clip brushes: " << e.msg; });
   }
   else
   {
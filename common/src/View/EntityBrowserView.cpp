@@ -326,30 +326,24 @@ void EntityBrowserView::renderBounds(Layout& layout, const float y, const float
   using BoundsVertex = Renderer::GLVertexTypes::P3C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        const auto* definition = cellData(cell).entityDefinition;
+        auto* modelRenderer = cellData(cell).modelRenderer;
+
+        if (modelRenderer == nullptr)
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto* definition = cellData(cell).entityDefinition;
-            auto* modelRenderer = cellData(cell).modelRenderer;
-
-            if (modelRenderer == nullptr)
-            {
-              const auto itemTrans = itemTransformation(cell, y, height, false);
-              const auto& color = definition->color();
-              vm::bbox3f{definition->bounds()}.for_each_edge(
-                [&](const vm::vec3f& v1, const vm::vec3f& v2) {
-                  vertices.emplace_back(itemTrans * v1, color);
-                  vertices.emplace_back(itemTrans * v2, color);
-                });
-            }
-          }
+          const auto itemTrans = itemTransformation(cell, y, height, false);
+          const auto& color = definition->color();
+          vm::bbox3f{definition->bounds()}.for_each_edge(
+            [&](const vm::vec3f& v1, const vm::vec3f& v2) {
+              vertices.emplace_back(itemTrans * v1, color);
+              vertices.emplace_back(itemTrans * v2, color);
+            });
         }
       }
     }
@@ -387,32 +381,25 @@ void EntityBrowserView::renderModels(
   shader.set("CameraUp", CameraUp);
   shader.set("ViewMatrix", transformation.viewMatrix());
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
+        if (auto* modelRenderer = cellData(cell).modelRenderer)
         {
-          for (const auto& cell : row.cells())
-          {
-            if (auto* modelRenderer = cellData(cell).modelRenderer)
-            {
-              shader.set(
-                "Orientation", static_cast<int>(cellData(cell).modelOrientation));
-
-              const auto itemTrans = itemTransformation(cell, y, height, true);
-              shader.set("ModelMatrix", itemTrans);
-
-              const auto multMatrix =
-                Renderer::MultiplyModelMatrix{transformation, itemTrans};
-
-              auto renderFunc = Renderer::DefaultMaterialRenderFunc{
-                pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter)};
-              modelRenderer->render(renderFunc);
-            }
-          }
+          shader.set("Orientation", static_cast<int>(cellData(cell).modelOrientation));
+
+          const auto itemTrans = itemTransformation(cell, y, height, true);
+          shader.set("ModelMatrix", itemTrans);
+
+          const auto multMatrix =
+            Renderer::MultiplyModelMatrix{transformation, itemTrans};
+
+          auto renderFunc = Renderer::DefaultMaterialRenderFunc{
+            pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter)};
+          modelRenderer->render(renderFunc);
         }
       }
     }
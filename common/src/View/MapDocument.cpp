@@ -36,6 +36,7 @@
 #include "IO/DiskIO.h"
 #include "IO/ExportOptions.h"
 #include "IO/GameConfigParser.h"
+#include "IO/MapFileSerializer.h"
 #include "IO/PathInfo.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
@@ -108,6 +109,7 @@
 #include "View/UpdateLinkedGroupsCommand.h"
 #include "View/UpdateLinkedGroupsHelper.h"
 #include "View/ViewEffectsService.h"
+#include "octree.h"
 
 #include "kdl/collection_utils.h"
 #include "kdl/grouped_range.h"
@@ -119,6 +121,7 @@
 #include "kdl/result_fold.h"
 #include "kdl/stable_remove_duplicates.h"
 #include "kdl/string_format.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
@@ -129,7 +132,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdlib> // for std::abs
+#include <iterator>
 #include <map>
 #include <mutex>
 #include <sstream>
@@ -382,6 +387,7 @@ MapDocument::MapDocument()
   : m_worldBounds(DefaultWorldBounds)
   , m_world(nullptr)
   , m_resourceManager(std::make_unique<Assets::ResourceManager>())
+  , m_taskManager(std::make_unique<kdl::task_manager>())
   , m_entityDefinitionManager(std::make_unique<Assets::EntityDefinitionManager>())
   , m_entityModelManager(std::make_unique<Assets::EntityModelManager>(
       [&](auto resourceLoader) {
@@ -948,7 +954,8 @@ bool MapDocument::pasteNodes(const std::vector<Model::Node*>& nodes)
   fixRecursiveLinkedGroups(nodesToAdd, *this);
   copyAndSetLinkIds(nodesToAdd, *m_world, *this);
 
-  auto transaction = Transaction{*this, "Paste Nodes"};
+  auto transaction =
+    Transaction{*this, "Paste Nodes", NodeChangeNotifications::Coalesced};
 
   const auto addedNodes = addNodes(nodesToAdd);
   if (addedNodes.empty())
@@ -981,12 +988,10 @@ void MapDocument::loadPointFile(std::filesystem::path path)
     unloadPointFile();
   }
 
-  IO::Disk::withInputStream(path, [&](auto& stream) {
-    return Model::loadPointFile(stream) | kdl::transform([&](auto trace) {
-             info() << "Loaded point file " << path;
-             m_pointFile = PointFile{std::move(trace), std::move(path)};
-             pointFileWasLoadedNotifier();
-           });
+  Model::loadPointFile(path) | kdl::transform([&](auto trace) {
+    info() << "Loaded point file " << path;
+    m_pointFile = PointFile{std::move(trace), std::move(path)};
+    pointFileWasLoadedNotifier();
   }) | kdl::transform_error([&](auto e) {
     error() << "Couldn't load portal file " << path << ": " << e.msg;
     m_pointFile = {};
@@ -1035,12 +1040,10 @@ void MapDocument::loadPortalFile(std::filesystem::path path)
   }
 
 
-  IO::Disk::withInputStream(path, [&](auto& stream) {
-    return Model::loadPortalFile(stream) | kdl::transform([&](auto portalFile) {
-             info() << "Loaded portal file " << path;
-             m_portalFile = {std::move(portalFile), std::move(path)};
-             portalFileWasLoadedNotifier();
-           });
+  Model::loadPortalFile(path) | kdl::transform([&](auto portalFile) {
+    info() << "Loaded portal file " << path;
+    m_portalFile = {std::move(portalFile), std::move(path)};
+    portalFileWasLoadedNotifier();
   }) | kdl::transform_error([&](auto e) {
     error() << "Couldn't load portal file " << path << ": " << e.msg;
     m_portalFile = std::nullopt;
@@ -1816,7 +1819,8 @@ void MapDocument::deleteObjects()
 {
   const auto nodes = m_selectedNodes.nodes();
 
-  auto transaction = Transaction{*this, "Delete Objects"};
+  auto transaction =
+    Transaction{*this, "Delete Objects", NodeChangeNotifications::Coalesced};
   deselectAll();
   removeNodes(nodes);
   assertResult(transaction.commit());
@@ -3149,19 +3153,44 @@ bool MapDocument::csgSubtract()
   selectTouching(false);
 
   const auto minuendNodes = std::vector<Model::BrushNode*>{selectedNodes().brushes()};
-  const auto subtrahends = kdl::vec_transform(
-    subtrahendNodes, [](const auto* subtrahendNode) { return &subtrahendNode->brush(); });
+
+  // index the subtrahends by their bounds so that every minuend is only subtracted by
+  // the subtrahends it may intersect
+  auto subtrahendTree = octree<FloatType, size_t>{256.0};
+  for (size_t i = 0; i < subtrahendNodes.size(); ++i)
+  {
+    subtrahendTree.insert(subtrahendNodes[i]->brush().bounds(), i);
+  }
+
+  const auto mapFormat = m_world->mapFormat();
+  const auto& materialName = currentMaterialName();
+
+  // the subtractions are independent of each other, so we can perform them in parallel
+  auto subtractionResults =
+    kdl::vec_parallel_transform(minuendNodes, [&](Model::BrushNode* minuendNode) {
+      const auto& minuend = minuendNode->brush();
+
+      // keep the subtrahends in the order in which they were selected
+      auto subtrahendIndices = subtrahendTree.find_intersectors(minuend.bounds());
+      std::sort(subtrahendIndices.begin(), subtrahendIndices.end());
+
+      const auto subtrahends = kdl::vec_transform(
+        subtrahendIndices, [&](const auto i) { return &subtrahendNodes[i]->brush(); });
+
+      return std::make_pair(
+        minuendNode,
+        minuend.subtract(mapFormat, m_worldBounds, materialName, subtrahends));
+    });
 
   auto toAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
   auto toRemove =
     std::vector<Model::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
   return kdl::vec_transform(
-           minuendNodes,
-           [&](auto* minuendNode) {
-             const auto& minuend = minuendNode->brush();
-             auto currentSubtractionResults = minuend.subtract(
-               m_world->mapFormat(), m_worldBounds, currentMaterialName(), subtrahends);
+           std::move(subtractionResults),
+           [&](auto subtractionResult) {
+             auto* minuendNode = subtractionResult.first;
+             auto& currentSubtractionResults = subtractionResult.second;
 
              return kdl::vec_filter(
                       std::move(currentSubtractionResults),
@@ -3251,35 +3280,42 @@ bool MapDocument::csgHollow()
     return false;
   }
 
+  const auto mapFormat = m_world->mapFormat();
+  const auto& materialName = currentMaterialName();
+  const auto thickness = FloatType(m_grid->actualSize());
+
+  // the brushes are hollowed independently of each other, so we can do it in parallel
+  auto hollowResults =
+    kdl::vec_parallel_transform(brushNodes, [&](Model::BrushNode* brushNode) {
+      const auto& originalBrush = brushNode->brush();
+
+      auto shrunkenBrush = originalBrush;
+      return shrunkenBrush.expand(m_worldBounds, -thickness, true)
+             | kdl::and_then([&]() {
+                 return originalBrush.subtract(
+                          mapFormat, m_worldBounds, materialName, shrunkenBrush)
+                        | kdl::fold;
+               });
+    });
+
   bool didHollowAnything = false;
   auto toAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
   auto toRemove = std::vector<Model::Node*>{};
 
-  for (auto* brushNode : brushNodes)
+  for (size_t i = 0; i < brushNodes.size(); ++i)
   {
-    const auto& originalBrush = brushNode->brush();
-
-    auto shrunkenBrush = originalBrush;
-    shrunkenBrush.expand(m_worldBounds, -FloatType(m_grid->actualSize()), true)
-      | kdl::and_then([&]() {
+    auto* brushNode = brushNodes[i];
+    std::move(hollowResults[i])
+      | kdl::transform([&](auto fragments) {
           didHollowAnything = true;
 
-          return originalBrush.subtract(
-                   m_world->mapFormat(),
-                   m_worldBounds,
-                   currentMaterialName(),
-                   shrunkenBrush)
-                 | kdl::fold | kdl::transform([&](auto fragments) {
-                     auto fragmentNodes =
-                       kdl::vec_transform(std::move(fragments), [](auto&& b) {
-                         return new Model::BrushNode{std::forward<decltype(b)>(b)};
-                       });
-
-                     auto& toAddForParent = toAdd[brushNode->parent()];
-                     toAddForParent =
-                       kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
-                     toRemove.push_back(brushNode);
-                   });
+          auto fragmentNodes = kdl::vec_transform(std::move(fragments), [](auto&& b) {
+            return new Model::BrushNode{std::forward<decltype(b)>(b)};
+          });
+
+          auto& toAddForParent = toAdd[brushNode->parent()];
+          toAddForParent = kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
+          toRemove.push_back(brushNode);
         })
       | kdl::transform_error(
         [&](const auto& e) { error() << "Could not hollow brush: " << e; });
@@ -4221,11 +4257,34 @@ void MapDocument::clearRepeatableCommands()
   m_repeatStack->clear();
 }
 
-void MapDocument::startTransaction(std::string name, const TransactionScope scope)
+void MapDocument::startTransaction(
+  std::string name,
+  const TransactionScope scope,
+  const NodeChangeNotifications nodeChangeNotifications)
 {
+  // observers must be able to observe the intermediate states of long running
+  // transactions
+  assert(
+    scope == TransactionScope::Oneshot
+    || nodeChangeNotifications == NodeChangeNotifications::Immediate);
+
   debug("Starting transaction '" + name + "'");
   doStartTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
+
+  m_transactionNodeChangeNotifications.push_back(nodeChangeNotifications);
+  if (nodeChangeNotifications == NodeChangeNotifications::Coalesced)
+  {
+    if (!nodesDidChangeNotifier.coalescing())
+    {
+      nodesDidChangeNotifier.resetObserverTimings();
+      nodesDidChangeNotifier.setTimingEnabled(true);
+    }
+
+    // will change notifications must be sent before the nodes change, but only once
+    nodesWillChangeNotifier.startCoalescing(CoalescingMode::Immediate);
+    nodesDidChangeNotifier.startCoalescing(CoalescingMode::Deferred);
+  }
 }
 
 void MapDocument::rollbackTransaction()
@@ -4245,6 +4304,7 @@ bool MapDocument::commitTransaction()
     return false;
   }
 
+  endTransactionScope();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
   return true;
@@ -4255,10 +4315,55 @@ void MapDocument::cancelTransaction()
   debug("Cancelling transaction");
   doRollbackTransaction();
   m_repeatStack->rollbackTransaction();
+  endTransactionScope();
   doCommitTransaction();
   m_repeatStack->commitTransaction();
 }
 
+void MapDocument::endTransactionScope()
+{
+  assert(!m_transactionNodeChangeNotifications.empty());
+
+  const auto nodeChangeNotifications = m_transactionNodeChangeNotifications.back();
+  m_transactionNodeChangeNotifications.pop_back();
+  if (nodeChangeNotifications == NodeChangeNotifications::Coalesced)
+  {
+    nodesWillChangeNotifier.stopCoalescing();
+    nodesDidChangeNotifier.stopCoalescing();
+
+    if (!nodesDidChangeNotifier.coalescing())
+    {
+      nodesDidChangeNotifier.setTimingEnabled(false);
+      logNodesDidChangeTimings();
+    }
+  }
+}
+
+void MapDocument::logNodesDidChangeTimings()
+{
+  const auto timings = nodesDidChangeNotifier.observerTimings();
+  const auto slowestIt = std::max_element(
+    timings.begin(), timings.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.duration < rhs.duration;
+    });
+
+  if (slowestIt != timings.end() && slowestIt->notificationCount > 0)
+  {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    auto total = std::chrono::nanoseconds{0};
+    for (const auto& timing : timings)
+    {
+      total += timing.duration;
+    }
+
+    debug() << "Coalesced node change notifications took "
+            << Milliseconds{total}.count() << "ms, slowest observer #"
+            << std::distance(timings.begin(), slowestIt) << " took "
+            << Milliseconds{slowestIt->duration}.count() << "ms";
+  }
+}
+
 std::unique_ptr<CommandResult> MapDocument::execute(std::unique_ptr<Command>&& command)
 {
   return doExecute(std::move(command));
@@ -4297,7 +4402,7 @@ void MapDocument::processResourcesSync(const Assets::ProcessContext& processCont
 void MapDocument::processResourcesAsync(const Assets::ProcessContext& processContext)
 {
   const auto processedResourceIds = m_resourceManager->process(
-    [](auto task) { return std::async(std::move(task)); },
+    [&](auto task) { return m_taskManager->run_task(std::move(task)); },
     processContext,
     std::chrono::milliseconds{20});
 
@@ -4794,6 +4899,41 @@ void MapDocument::unsetEntityModels(const std::vector<Model::Node*>& nodes)
   Model::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
 }
 
+std::unique_ptr<Model::WorldNode> MapDocument::makeWorldSnapshot() const
+{
+  ensure(m_world, "world is null");
+
+  // serialize the nodes that have changed since the last save while their materials are
+  // still available, the clones share the cached text and the brush geometry
+  IO::MapFileSerializer::updateCachedSerializations(
+    m_world->mapFormat(), {m_world.get()});
+
+  auto snapshot = std::unique_ptr<Model::WorldNode>{
+    static_cast<Model::WorldNode*>(m_world->cloneRecursively(m_worldBounds))};
+
+  // unsetting the materials would invalidate the cached text, but it remains valid for
+  // the snapshot
+  snapshot->accept(kdl::overload(
+    [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, Model::EntityNode* entity) {
+      entity->visitChildren(thisLambda);
+    },
+    [](Model::BrushNode* brushNode) {
+      auto cachedSerialization = brushNode->cachedSerialization();
+      for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i)
+      {
+        brushNode->setFaceMaterial(i, nullptr);
+      }
+      brushNode->setCachedSerialization(std::move(cachedSerialization));
+    },
+    [](Model::PatchNode* patchNode) { patchNode->setMaterial(nullptr); }));
+  snapshot->accept(makeUnsetEntityDefinitionsVisitor());
+  snapshot->accept(makeUnsetEntityModelsVisitor());
+  return snapshot;
+}
+
 std::vector<std::filesystem::path> MapDocument::externalSearchPaths() const
 {
   std::vector<std::filesystem::path> searchPaths;
@@ -5127,6 +5267,8 @@ void MapDocument::connectObservers()
     transactionDoneNotifier.connect(this, &MapDocument::transactionDone);
   m_notifierConnection +=
     transactionUndoneNotifier.connect(this, &MapDocument::transactionUndone);
+  m_notifierConnection +=
+    nodesWereRemovedNotifier.connect(this, &MapDocument::nodesWereRemoved);
 
   // tag management
   m_notifierConnection +=
@@ -5145,6 +5287,17 @@ void MapDocument::connectObservers()
     modsDidChangeNotifier.connect(this, &MapDocument::updateAllFaceTags);
 }
 
+void MapDocument::nodesWereRemoved(const std::vector<Model::Node*>& nodes)
+{
+  // removed nodes may be deleted before the coalesced notifications are sent
+  if (nodesDidChangeNotifier.coalescing())
+  {
+    const auto removedNodes = Model::collectNodesAndDescendants(nodes);
+    nodesWillChangeNotifier.discardCoalescedValues(removedNodes);
+    nodesDidChangeNotifier.discardCoalescedValues(removedNodes);
+  }
+}
+
 void MapDocument::materialCollectionsWillChange()
 {
   unsetMaterials();
@@ -5220,19 +5373,29 @@ void MapDocument::transactionUndone(const std::string& name)
   debug() << "Transaction '" << name << "' undone";
 }
 
-Transaction::Transaction(std::weak_ptr<MapDocument> document, std::string name)
-  : Transaction{kdl::mem_lock(document), std::move(name)}
+Transaction::Transaction(
+  std::weak_ptr<MapDocument> document,
+  std::string name,
+  const NodeChangeNotifications nodeChangeNotifications)
+  : Transaction{kdl::mem_lock(document), std::move(name), nodeChangeNotifications}
 {
 }
 
-Transaction::Transaction(std::shared_ptr<MapDocument> document, std::string name)
-  : Transaction{*document, std::move(name)}
+Transaction::Transaction(
+  std::shared_ptr<MapDocument> document,
+  std::string name,
+  const NodeChangeNotifications nodeChangeNotifications)
+  : Transaction{*document, std::move(name), nodeChangeNotifications}
 {
 }
 
-Transaction::Transaction(MapDocument& document, std::string name)
+Transaction::Transaction(
+  MapDocument& document,
+  std::string name,
+  const NodeChangeNotifications nodeChangeNotifications)
   : m_document{document}
   , m_name{std::move(name)}
+  , m_nodeChangeNotifications{nodeChangeNotifications}
   , m_state{State::Running}
 {
   begin();
@@ -5293,6 +5456,7 @@ void Transaction::cancel()
 
 void Transaction::begin()
 {
-  m_document.startTransaction(m_name, TransactionScope::Oneshot);
+  m_document.startTransaction(
+    m_name, TransactionScope::Oneshot, m_nodeChangeNotifications);
 }
 } // namespace TrenchBroom::View
@@ -43,6 +43,11 @@
 #include <variant>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+} // namespace kdl
+
 namespace TrenchBroom
 {
 class Color;
@@ -109,6 +114,23 @@ struct PortalFile
   std::filesystem::path path;
 };
 
+/**
+ * Controls when the observers of the node change notifiers are notified of the changes
+ * that a transaction makes.
+ */
+enum class NodeChangeNotifications
+{
+  /** Observers are notified of every change right away. */
+  Immediate,
+  /**
+   * Observers are notified of each changed node only once: nodesWillChange before the
+   * node changes for the first time, and nodesDidChange when the outermost coalescing
+   * transaction is committed or cancelled. Only suitable for oneshot transactions whose
+   * commands don't depend on observers having seen the previous changes.
+   */
+  Coalesced,
+};
+
 class MapDocument : public Model::MapFacade, public CachingLogger
 {
 public:
@@ -124,6 +146,7 @@ protected:
   std::optional<PortalFile> m_portalFile;
 
   std::unique_ptr<Assets::ResourceManager> m_resourceManager;
+  std::unique_ptr<kdl::task_manager> m_taskManager;
   std::unique_ptr<Assets::EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<Assets::EntityModelManager> m_entityModelManager;
   std::unique_ptr<Assets::MaterialManager> m_materialManager;
@@ -160,6 +183,13 @@ protected:
    */
   std::unique_ptr<RepeatStack> m_repeatStack;
 
+  /*
+   * How the node change notifications of the currently running transactions are sent.
+   * While a coalescing transaction is running, observers are notified of each changed
+   * node only once.
+   */
+  std::vector<NodeChangeNotifications> m_transactionNodeChangeNotifications;
+
 public: // notification
   Notifier<Command&> commandDoNotifier;
   Notifier<Command&> commandDoneNotifier;
@@ -316,6 +346,18 @@ public: // new, load, save document
   void saveDocumentTo(const std::filesystem::path& path);
   Result<void> exportDocumentAs(const IO::ExportOptions& options);
 
+  /**
+   * Returns a copy of the world that does not refer to any materials, entity definitions
+   * or entity models. The copy only shares immutable state with this document, such as
+   * the geometry of its brushes, so it can be written on another thread while this
+   * document continues to change.
+   *
+   * The brushes and patches that have changed since they were last serialized are
+   * serialized before they are copied, so that the copy can be written without its
+   * materials.
+   */
+  std::unique_ptr<Model::WorldNode> makeWorldSnapshot() const;
+
 private:
   void doSaveDocument(const std::filesystem::path& path);
   void clearDocument();
@@ -655,7 +697,10 @@ public: // command processing
   void clearRepeatableCommands();
 
 public: // transactions
-  void startTransaction(std::string name, TransactionScope scope);
+  void startTransaction(
+    std::string name,
+    TransactionScope scope,
+    NodeChangeNotifications nodeChangeNotifications = NodeChangeNotifications::Immediate);
   void rollbackTransaction();
   bool commitTransaction();
   void cancelTransaction();
@@ -663,6 +708,9 @@ public: // transactions
   virtual bool isCurrentDocumentStateObservable() const = 0;
 
 private:
+  void endTransactionScope();
+  void logNodesDidChangeTimings();
+
   std::unique_ptr<CommandResult> execute(std::unique_ptr<Command>&& command);
   std::unique_ptr<CommandResult> executeAndStore(
     std::unique_ptr<UndoableCommand>&& command);
@@ -814,6 +862,7 @@ private:
 
 private: // observers
   void connectObservers();
+  void nodesWereRemoved(const std::vector<Model::Node*>& nodes);
   void materialCollectionsWillChange();
   void materialCollectionsDidChange();
   void entityDefinitionsWillChange();
@@ -840,12 +889,22 @@ public:
 private:
   MapDocument& m_document;
   std::string m_name;
+  NodeChangeNotifications m_nodeChangeNotifications;
   State m_state;
 
 public:
-  explicit Transaction(std::weak_ptr<MapDocument> document, std::string name = "");
-  explicit Transaction(std::shared_ptr<MapDocument> document, std::string name = "");
-  explicit Transaction(MapDocument& document, std::string name = "");
+  explicit Transaction(
+    std::weak_ptr<MapDocument> document,
+    std::string name = "",
+    NodeChangeNotifications nodeChangeNotifications = NodeChangeNotifications::Immediate);
+  explicit Transaction(
+    std::shared_ptr<MapDocument> document,
+    std::string name = "",
+    NodeChangeNotifications nodeChangeNotifications = NodeChangeNotifications::Immediate);
+  explicit Transaction(
+    MapDocument& document,
+    std::string name = "",
+    NodeChangeNotifications nodeChangeNotifications = NodeChangeNotifications::Immediate);
   ~Transaction();
 
   State state() const;
@@ -243,12 +243,13 @@ vm::vec3 MapView3D::doGetPasteObjectsDelta(
   {
     const auto pickRay = vm::ray3(m_camera->pickRay(
       static_cast<float>(clientCoords.x()), static_cast<float>(clientCoords.y())));
-    auto pickResult = Model::PickResult::byDistance();
+    using namespace Model::HitFilters;
+    const auto filter = type(Model::BrushNode::BrushHitType);
 
+    auto pickResult = Model::PickResult::query(filter);
     document->pick(pickRay, pickResult);
 
-    using namespace Model::HitFilters;
-    const auto& hit = pickResult.first(type(Model::BrushNode::BrushHitType));
+    const auto& hit = pickResult.first(filter);
     if (const auto faceHandle = Model::hitToFaceHandle(hit))
     {
       const auto& face = faceHandle->face();
@@ -80,6 +80,7 @@
 
 #include "vm/polygon.h"
 #include "vm/util.h"
+#include "vm/vec.h"
 
 #include <sstream>
 #include <vector>
@@ -1130,20 +1131,22 @@ void MapViewBase::validatePortalFileRenderer(Renderer::RenderContext&)
   auto* portalFile = document->portalFile();
   if (portalFile)
   {
-    for (const auto& poly : portalFile->portals())
+    for (size_t i = 0; i < portalFile->portalCount(); ++i)
     {
+      const auto vertices = portalFile->portalVertices(i);
+
       m_portalFileRenderer->renderFilledPolygon(
         pref(Preferences::PortalFileFillColor),
         Renderer::PrimitiveRendererOcclusionPolicy::Hide,
         Renderer::PrimitiveRendererCullingPolicy::ShowBackfaces,
-        poly.vertices());
+        vertices);
 
       const auto lineWidth = 4.0f;
       m_portalFileRenderer->renderPolygon(
         pref(Preferences::PortalFileBorderColor),
         lineWidth,
         Renderer::PrimitiveRendererOcclusionPolicy::Hide,
-        poly.vertices());
+        vertices);
     }
   }
 }
@@ -49,11 +49,25 @@
 #include "vm/mat_ext.h"
 #include "vm/vec.h"
 
+#include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom::View
 {
+namespace
+{
+
+vm::vec2f scaledTextureSize(const Assets::Material& material)
+{
+  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
+  const auto* texture = material.texture();
+  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
+  return vm::round(scaleFactor * textureSize);
+}
+
+} // namespace
 
 MaterialBrowserView::MaterialBrowserView(
   QScrollBar* scrollBar,
@@ -64,7 +78,7 @@ MaterialBrowserView::MaterialBrowserView(
 {
   auto document = kdl::mem_lock(m_document);
   m_notifierConnection += document->materialUsageCountsDidChangeNotifier.connect(
-    this, &MaterialBrowserView::reloadMaterials);
+    this, &MaterialBrowserView::materialUsageCountsDidChange);
   m_notifierConnection += document->resourcesWereProcessedNotifier.connect(
     this, &MaterialBrowserView::resourcesWereProcessed);
 }
@@ -106,6 +120,7 @@ void MaterialBrowserView::setFilterText(const std::string& filterText)
   if (filterText != m_filterText)
   {
     m_filterText = filterText;
+    m_filterPatterns = kdl::str_split(m_filterText, " ");
     reloadMaterials();
   }
 }
@@ -132,9 +147,40 @@ void MaterialBrowserView::revealMaterial(const Assets::Material* material)
   });
 }
 
-void MaterialBrowserView::resourcesWereProcessed(const std::vector<Assets::ResourceId>&)
+void MaterialBrowserView::materialUsageCountsDidChange()
 {
-  reloadMaterials();
+  if (m_hideUnused || m_sortOrder == MaterialSortOrder::Usage)
+  {
+    reloadMaterials();
+  }
+  else
+  {
+    // only the colors of the material borders change
+    update();
+  }
+}
+
+void MaterialBrowserView::resourcesWereProcessed(
+  const std::vector<Assets::ResourceId>& resourceIds)
+{
+  auto document = kdl::mem_lock(m_document);
+  const auto materials =
+    document->materialManager().findMaterialsByTextureResourceId(resourceIds);
+
+  if (!materials.empty())
+  {
+    // loading a texture only changes the size of the cells showing it, so we don't need
+    // to filter, sort and measure all materials again
+    const auto processedMaterials =
+      std::unordered_set<const Assets::Material*>{materials.begin(), materials.end()};
+    updateItemSizes([&](const Cell& cell) -> std::optional<vm::vec2f> {
+      const auto& material = cellData(cell);
+      return processedMaterials.count(&material) > 0
+               ? std::optional{scaledTextureSize(material)}
+               : std::nullopt;
+    });
+    update();
+  }
 }
 
 void MaterialBrowserView::reloadMaterials()
@@ -197,16 +243,13 @@ void MaterialBrowserView::addMaterialToLayout(
   const auto materialName = std::filesystem::path{material.name()}.filename().string();
   const auto titleHeight = fontManager().font(font).measure(materialName).y();
 
-  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
-  const auto* texture = material.texture();
-  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
-  const auto scaledTextureSize = vm::round(scaleFactor * textureSize);
+  const auto textureSize = scaledTextureSize(material);
 
   layout.addItem(
     &material,
     materialName,
-    scaledTextureSize.x(),
-    scaledTextureSize.y(),
+    textureSize.x(),
+    textureSize.y(),
     maxCellWidth,
     titleHeight + 4.0f);
 }
@@ -257,10 +300,10 @@ std::vector<const Assets::Material*> MaterialBrowserView::filterMaterials(
       return material->usageCount() == 0;
     });
   }
-  if (!m_filterText.empty())
+  if (!m_filterPatterns.empty())
   {
     materials = kdl::vec_erase_if(std::move(materials), [&](const auto* material) {
-      return !kdl::all_of(kdl::str_split(m_filterText, " "), [&](const auto& pattern) {
+      return !kdl::all_of(m_filterPatterns, [&](const auto& pattern) {
         return kdl::ci::str_contains(material->name(), pattern);
       });
     });
@@ -322,32 +365,23 @@ void MaterialBrowserView::renderBounds(Layout& layout, const float y, const floa
   using BoundsVertex = Renderer::GLVertexTypes::P2C4::Vertex;
   auto vertices = std::vector<BoundsVertex>{};
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-            const auto& color = materialColor(material);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
-              color);
-          }
-        }
+        const auto& bounds = cell.itemBounds();
+        const auto& material = cellData(cell);
+        const auto& color = materialColor(material);
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)}, color);
+        vertices.emplace_back(
+          vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)}, color);
       }
     }
   }
@@ -384,35 +418,29 @@ void MaterialBrowserView::renderMaterials(
   shader.set("Material", 0);
   shader.set("Brightness", pref(Preferences::Brightness));
 
-  for (const auto& group : layout.groups())
+  for (const auto& group : layout.groupsIntersectingY(y, height))
   {
-    if (group.intersectsY(y, height))
+    for (const auto& row : group.rowsIntersectingY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& cell : row.cells())
       {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-
-            auto vertexArray = Renderer::VertexArray::move(std::vector<Vertex>{
-              Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
-              Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
-              Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
-              Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
-            });
-
-            material.activate(
-              pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
-
-            vertexArray.prepare(vboManager());
-            vertexArray.render(Renderer::PrimType::Quads);
-
-            material.deactivate();
-          }
-        }
+        const auto& bounds = cell.itemBounds();
+        const auto& material = cellData(cell);
+
+        auto vertexArray = Renderer::VertexArray::move(std::vector<Vertex>{
+          Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
+          Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
+          Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
+          Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
+        });
+
+        material.activate(
+          pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+
+        vertexArray.prepare(vboManager());
+        vertexArray.render(Renderer::PrimType::Quads);
+
+        material.deactivate();
       }
     }
   }
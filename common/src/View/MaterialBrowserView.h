@@ -58,6 +58,7 @@ private:
   bool m_hideUnused = false;
   MaterialSortOrder m_sortOrder = MaterialSortOrder::Name;
   std::string m_filterText;
+  std::vector<std::string> m_filterPatterns;
 
   const Assets::Material* m_selectedMaterial = nullptr;
 
@@ -81,6 +82,7 @@ public:
   void revealMaterial(const Assets::Material* material);
 
 private:
+  void materialUsageCountsDidChange();
   void resourcesWereProcessed(const std::vector<Assets::ResourceId>& resources);
 
   void reloadMaterials();
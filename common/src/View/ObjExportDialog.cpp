@@ -24,6 +24,7 @@
 #include <QFileDialog>
 #include <QLabel>
 #include <QLineEdit>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QRadioButton>
 
@@ -151,6 +152,15 @@ void ObjExportDialog::createGui()
     options.mtlPathMode = m_relativeToGamePathRadioButton->isChecked()
                             ? IO::ObjMtlPathMode::RelativeToGamePath
                             : IO::ObjMtlPathMode::RelativeToExportPath;
+
+    // a modal progress dialog processes events when its value changes
+    auto progressDialog = QProgressDialog{tr("Exporting..."), QString{}, 0, 100, this};
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
+    options.progress = [&](const double progress) {
+      progressDialog.setValue(int(progress * 100.0));
+    };
+
     m_mapFrame->exportDocument(options);
     close();
   });
@@ -28,6 +28,7 @@
 #include "Model/Object.h"
 #include "Model/PatchNode.h"
 #include "Model/WorldNode.h"
+#include "Notifier.h"
 #include "View/MapDocumentCommandFacade.h"
 
 #include "kdl/result.h"
@@ -47,8 +48,18 @@ SetLinkIdsCommand::~SetLinkIdsCommand() = default;
 
 namespace
 {
-auto setLinkIds(const std::vector<std::tuple<Model::Node*, std::string>>& linkIds)
+auto setLinkIds(
+  MapDocumentCommandFacade& document,
+  const std::vector<std::tuple<Model::Node*, std::string>>& linkIds)
 {
+  const auto nodes = kdl::vec_transform(linkIds, [](const auto& nodeAndLinkId) {
+    return std::get<Model::Node*>(nodeAndLinkId);
+  });
+
+  // observers such as the group link renderer depend on the link IDs
+  NotifyBeforeAndAfter notifyNodes(
+    document.nodesWillChangeNotifier, document.nodesDidChangeNotifier, nodes);
+
   return kdl::vec_transform(linkIds, [](const auto& nodeAndLinkId) {
     auto* node = std::get<Model::Node*>(nodeAndLinkId);
     const auto& linkId = std::get<std::string>(nodeAndLinkId);
@@ -68,15 +79,17 @@ auto setLinkIds(const std::vector<std::tuple<Model::Node*, std::string>>& linkId
 }
 } // namespace
 
-std::unique_ptr<CommandResult> SetLinkIdsCommand::doPerformDo(MapDocumentCommandFacade*)
+std::unique_ptr<CommandResult> SetLinkIdsCommand::doPerformDo(
+  MapDocumentCommandFacade* document)
 {
-  m_linkIds = setLinkIds(m_linkIds);
+  m_linkIds = setLinkIds(*document, m_linkIds);
   return std::make_unique<CommandResult>(true);
 }
 
-std::unique_ptr<CommandResult> SetLinkIdsCommand::doPerformUndo(MapDocumentCommandFacade*)
+std::unique_ptr<CommandResult> SetLinkIdsCommand::doPerformUndo(
+  MapDocumentCommandFacade* document)
 {
-  m_linkIds = setLinkIds(m_linkIds);
+  m_linkIds = setLinkIds(*document, m_linkIds);
   return std::make_unique<CommandResult>(true);
 }
 
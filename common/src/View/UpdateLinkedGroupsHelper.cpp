@@ -82,35 +82,67 @@ void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(MapDocumentCommandFacade&
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
-  // - p.first is the group node to update
-  // - p.second is a vector containing the group node's original children
+  // m_state contains
+  // - pairs p where p.first is a linked group node and p.second is a vector containing
+  //   the group node's original children
+  // - pairs q where q.first is a linked node and q.second contains its original contents
   //
-  // Let p_o be an update from the other helper. If p_o is an update for a linked group
-  // node that was updated by this helper, then there is a pair p_t in this helper such
-  // that p_t.first == p_o.first. In this case, we want to keep the old children of the
-  // linked group node stored in this helper and discard those in the other helper. If p_o
-  // is not an update for a linked group node that was updated by this helper, then we
-  // will add p_o to our updates and remove it from the other helper's updates to prevent
-  // the replaced node to be deleted with the other helper.
+  // Let p_o be a replacement from the other helper. If p_o is a replacement of the
+  // children of a linked group node whose children were replaced by this helper, then
+  // there is a pair p_t in this helper such that p_t.first == p_o.first. In this case, we
+  // want to keep the old children of the linked group node stored in this helper and
+  // discard those in the other helper. If p_o is not a replacement for a linked group
+  // node that was updated by this helper, then we will add p_o to our updates and remove
+  // it from the other helper's updates to prevent the replaced node to be deleted with
+  // the other helper.
+  //
+  // Likewise, let q_o be a swap from the other helper. If this helper has already swapped
+  // the contents of q_o.first, or if q_o.first belongs to a group whose children were
+  // replaced by this helper, then we keep the original contents stored in this helper.
+  // Otherwise we add q_o to our updates.
 
   auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
   auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
 
-  for (auto& [theirGroupNodeToUpdate, theirOldChildren] : theirLinkedGroupUpdates)
+  const auto isReplacedByMe = [&](const Model::Node* node) {
+    return std::any_of(
+      std::begin(myLinkedGroupUpdates.childrenToReplace),
+      std::end(myLinkedGroupUpdates.childrenToReplace),
+      [&](const auto& p) { return p.first == node || p.first->isAncestorOf(node); });
+  };
+
+  const auto isSwappedByMe = [&](const Model::Node* node) {
+    return std::any_of(
+      std::begin(myLinkedGroupUpdates.contentsToSwap),
+      std::end(myLinkedGroupUpdates.contentsToSwap),
+      [&](const auto& q) { return q.first == node; });
+  };
+
+  for (auto& [theirGroupNodeToUpdate, theirOldChildren] :
+       theirLinkedGroupUpdates.childrenToReplace)
   {
     const auto myIt = std::find_if(
-      std::begin(myLinkedGroupUpdates),
-      std::end(myLinkedGroupUpdates),
+      std::begin(myLinkedGroupUpdates.childrenToReplace),
+      std::end(myLinkedGroupUpdates.childrenToReplace),
       [theirGroupNodeToUpdate = theirGroupNodeToUpdate](const auto& p) {
         return p.first == theirGroupNodeToUpdate;
       });
-    if (myIt == std::end(myLinkedGroupUpdates))
+    if (myIt == std::end(myLinkedGroupUpdates.childrenToReplace))
     {
-      myLinkedGroupUpdates.emplace_back(
+      myLinkedGroupUpdates.childrenToReplace.emplace_back(
         theirGroupNodeToUpdate, std::move(theirOldChildren));
     }
   }
+
+  for (auto& [theirNodeToUpdate, theirOldContents] :
+       theirLinkedGroupUpdates.contentsToSwap)
+  {
+    if (!isSwappedByMe(theirNodeToUpdate) && !isReplacedByMe(theirNodeToUpdate))
+    {
+      myLinkedGroupUpdates.contentsToSwap.emplace_back(
+        theirNodeToUpdate, std::move(theirOldContents));
+    }
+  }
 }
 
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
@@ -146,12 +178,19 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
                Model::collectGroupsWithLinkId({document.world()}, groupNode->linkId()),
                groupNode);
 
-             return Model::updateLinkedGroups(
-               *groupNode, groupNodesToUpdate, worldBounds);
+             return Model::updateLinkedNodes(*groupNode, groupNodesToUpdate, worldBounds);
            })
-         | kdl::fold
-         | kdl::and_then([&](auto nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-             return kdl::vec_flatten(std::move(nestedUpdateLists));
+         | kdl::fold | kdl::transform([&](auto nestedUpdates) {
+             auto result = LinkedGroupUpdates{};
+             for (auto& updates : nestedUpdates)
+             {
+               result.childrenToReplace = kdl::vec_concat(
+                 std::move(result.childrenToReplace),
+                 std::move(updates.childrenToReplace));
+               result.contentsToSwap = kdl::vec_concat(
+                 std::move(result.contentsToSwap), std::move(updates.contentsToSwap));
+             }
+             return result;
            });
 }
 
@@ -161,9 +200,37 @@ void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(
   std::visit(
     kdl::overload(
       [](const ChangedLinkedGroups&) {},
-      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
-        m_state = document.performReplaceChildren(std::move(linkedGroupUpdates));
+      [&](LinkedGroupUpdates& linkedGroupUpdates) {
+        // Swapped nodes may be contained in groups whose children are replaced, so
+        // when applying, we swap before replacing, and when undoing, we replace before
+        // swapping. A node may be swapped more than once, so the swaps are undone in
+        // reverse order.
+        auto& contentsToSwap = linkedGroupUpdates.contentsToSwap;
+        const auto swapContents = [&]() {
+          if (!contentsToSwap.empty())
+          {
+            document.performSwapNodeContents(contentsToSwap);
+          }
+        };
+        const auto replaceChildren = [&]() {
+          linkedGroupUpdates.childrenToReplace = document.performReplaceChildren(
+            std::move(linkedGroupUpdates.childrenToReplace));
+        };
+
+        if (!linkedGroupUpdates.applied)
+        {
+          swapContents();
+          replaceChildren();
+        }
+        else
+        {
+          replaceChildren();
+          std::reverse(contentsToSwap.begin(), contentsToSwap.end());
+          swapContents();
+          std::reverse(contentsToSwap.begin(), contentsToSwap.end());
+        }
+        linkedGroupUpdates.applied = !linkedGroupUpdates.applied;
       }),
-    std::move(m_state));
+    m_state);
 }
 } // namespace TrenchBroom::View
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "Model/NodeContents.h"
 #include "Result.h"
 
 #include <memory>
@@ -49,17 +50,23 @@ bool checkLinkedGroupsToUpdate(const std::vector<Model::GroupNode*>& changedLink
  *
  * The class is initialized with a vector of group nodes whose changes should be
  * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * is first called, the updates are computed with Model::updateLinkedNodes: the contents
+ * of the linked nodes whose corresponding nodes have changed are swapped with their new
+ * contents, and the children of linked groups whose structure has changed are replaced.
+ * Calling undoLinkedGroupUpdates swaps and replaces the original contents and children
+ * back, effectively undoing the change.
  */
 class UpdateLinkedGroupsHelper
 {
 private:
   using ChangedLinkedGroups = std::vector<Model::GroupNode*>;
-  using LinkedGroupUpdates =
-    std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>;
+  struct LinkedGroupUpdates
+  {
+    std::vector<std::pair<Model::Node*, std::vector<std::unique_ptr<Model::Node>>>>
+      childrenToReplace;
+    std::vector<std::pair<Model::Node*, Model::NodeContents>> contentsToSwap;
+    bool applied = false;
+  };
   std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
 
 public:
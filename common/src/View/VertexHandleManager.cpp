@@ -25,16 +25,60 @@
 #include "Preferences.h"
 #include "View/Grid.h"
 
+#include "vm/bbox.h"
 #include "vm/distance.h"
 #include "vm/intersection.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
+#include "vm/scalar.h"
 #include "vm/vec.h"
 
 namespace TrenchBroom
 {
 namespace View
 {
+vm::bbox3 handleBounds(const vm::vec3& handle)
+{
+  return vm::bbox3{handle, handle};
+}
+
+vm::bbox3 handleBounds(const vm::segment3& handle)
+{
+  return vm::merge(vm::bbox3{handle.start(), handle.start()}, handle.end());
+}
+
+vm::bbox3 handleBounds(const vm::polygon3& handle)
+{
+  return vm::bbox3::merge_all(std::begin(handle), std::end(handle));
+}
+
+bool mayHitHandle(
+  const vm::ray3& pickRay,
+  const Renderer::Camera& camera,
+  const FloatType handleRadius,
+  const vm::bbox3& bounds)
+{
+  // the pick radius of a handle grows with its distance from the camera, and the
+  // distance from the camera is greatest at one of the corners of the bounds
+  auto maxScaling = FloatType(0);
+  for (const auto x : {vm::bbox3::Corner::min, vm::bbox3::Corner::max})
+  {
+    for (const auto y : {vm::bbox3::Corner::min, vm::bbox3::Corner::max})
+    {
+      for (const auto z : {vm::bbox3::Corner::min, vm::bbox3::Corner::max})
+      {
+        const auto corner = vm::vec3f{bounds.corner(x, y, z)};
+        const auto scaling = FloatType(camera.perspectiveScalingFactor(corner));
+        maxScaling = vm::max(maxScaling, vm::abs(scaling));
+      }
+    }
+  }
+
+  const auto pickBounds = bounds.expand(FloatType(2) * handleRadius * maxScaling);
+  return pickBounds.contains(pickRay.origin)
+         || vm::intersect_ray_bbox(pickRay, pickBounds) != std::nullopt;
+}
+
 VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
 const Model::HitType::Type VertexHandleManager::HandleHitType =
@@ -45,17 +89,15 @@ void VertexHandleManager::pick(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
-    if (
-      const auto distance = camera.pickPointHandle(
-        pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius))))
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
+    if (const auto distance = camera.pickPointHandle(pickRay, position, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *distance);
       const auto error = vm::squared_distance(pickRay, position).distance;
       pickResult.addHit(Model::Hit(HandleHitType, *distance, hitPoint, position, error));
     }
-  }
+  });
 }
 
 void VertexHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -65,6 +107,7 @@ void VertexHandleManager::addHandles(const Model::BrushNode* brushNode)
   {
     add(vertex->position());
   }
+  addIncidentBrush(brushNode);
 }
 
 void VertexHandleManager::removeHandles(const Model::BrushNode* brushNode)
@@ -74,6 +117,7 @@ void VertexHandleManager::removeHandles(const Model::BrushNode* brushNode)
   {
     assertResult(remove(vertex->position()));
   }
+  removeIncidentBrush(brushNode);
 }
 
 Model::HitType::Type VertexHandleManager::hitType() const
@@ -96,19 +140,18 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = FloatType(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     if (
-      const auto edgeDist = camera.pickLineSegmentHandle(
-        pickRay, position, FloatType(pref(Preferences::HandleRadius))))
+      const auto edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius))
     {
       if (
         const auto pointHandle =
           grid.snap(vm::point_at_distance(pickRay, *edgeDist), position))
       {
         if (
-          const auto pointDist = camera.pickPointHandle(
-            pickRay, *pointHandle, FloatType(pref(Preferences::HandleRadius))))
+          const auto pointDist =
+            camera.pickPointHandle(pickRay, *pointHandle, handleRadius))
         {
           const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
           pickResult.addHit(Model::Hit(
@@ -116,7 +159,7 @@ void EdgeHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -124,18 +167,16 @@ void EdgeHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = FloatType(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, FloatType(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Model::Hit(HandleHitType, *pointDist, hitPoint, position));
     }
-  }
+  });
 }
 
 void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -145,6 +186,7 @@ void EdgeHandleManager::addHandles(const Model::BrushNode* brushNode)
   {
     add(vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position()));
   }
+  addIncidentBrush(brushNode);
 }
 
 void EdgeHandleManager::removeHandles(const Model::BrushNode* brushNode)
@@ -155,6 +197,7 @@ void EdgeHandleManager::removeHandles(const Model::BrushNode* brushNode)
     assertResult(remove(
       vm::segment3(edge->firstVertex()->position(), edge->secondVertex()->position())));
   }
+  removeIncidentBrush(brushNode);
 }
 
 Model::HitType::Type EdgeHandleManager::hitType() const
@@ -177,8 +220,8 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = FloatType(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     if (const auto plane = vm::from_points(std::begin(position), std::end(position)))
     {
       if (
@@ -189,8 +232,8 @@ void FaceHandleManager::pickGridHandle(
           grid.snap(vm::point_at_distance(pickRay, *distance), *plane);
 
         if (
-          const auto pointDist = camera.pickPointHandle(
-            pickRay, pointHandle, FloatType(pref(Preferences::HandleRadius))))
+          const auto pointDist =
+            camera.pickPointHandle(pickRay, pointHandle, handleRadius))
         {
           const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
           pickResult.addHit(Model::Hit(
@@ -198,7 +241,7 @@ void FaceHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -206,18 +249,16 @@ void FaceHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  forEachHandleNearRay(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Model::Hit(HandleHitType, *pointDist, hitPoint, position));
     }
-  }
+  });
 }
 
 void FaceHandleManager::addHandles(const Model::BrushNode* brushNode)
@@ -227,6 +268,7 @@ void FaceHandleManager::addHandles(const Model::BrushNode* brushNode)
   {
     add(face.polygon());
   }
+  addIncidentBrush(brushNode);
 }
 
 void FaceHandleManager::removeHandles(const Model::BrushNode* brushNode)
@@ -236,6 +278,7 @@ void FaceHandleManager::removeHandles(const Model::BrushNode* brushNode)
   {
     assertResult(remove(face.polygon()));
   }
+  removeIncidentBrush(brushNode);
 }
 
 Model::HitType::Type FaceHandleManager::hitType() const
@@ -25,9 +25,12 @@
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
 #include "Renderer/Camera.h"
+#include "octree.h"
 
 #include "kdl/vector_set.h"
 
+#include "vm/bbox.h"
+#include "vm/polygon.h"
 #include "vm/segment.h"
 
 #include <iterator>
@@ -45,6 +48,27 @@ namespace View
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given handle, used to store the handle in a spatial index.
+ */
+vm::bbox3 handleBounds(const vm::vec3& handle);
+vm::bbox3 handleBounds(const vm::segment3& handle);
+vm::bbox3 handleBounds(const vm::polygon3& handle);
+
+/**
+ * Indicates whether a handle with the given bounds may be hit by the given pick ray, that
+ * is, whether the given bounds, enlarged by the pick radius of a handle at its corner
+ * farthest from the camera, are hit by the ray.
+ *
+ * If this returns false for some bounds, then it also returns false for all bounds
+ * contained in them, so it can be used to prune spatial index nodes.
+ */
+bool mayHitHandle(
+  const vm::ray3& pickRay,
+  const Renderer::Camera& camera,
+  FloatType handleRadius,
+  const vm::bbox3& bounds);
+
 class VertexHandleManagerBase
 {
 public:
@@ -178,6 +202,16 @@ protected:
    */
   HandleMap m_handles;
 
+  /**
+   * Spatial index over the entries of m_handles, which are stable in memory.
+   */
+  octree<FloatType, HandleEntry*> m_handleTree;
+
+  /**
+   * Spatial index over the brushes whose handles were added to this manager.
+   */
+  octree<FloatType, Model::BrushNode*> m_brushTree;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -185,7 +219,9 @@ protected:
 
 public:
   VertexHandleManagerBaseT()
-    : m_selectedHandleCount(0)
+    : m_handleTree(64.0)
+    , m_brushTree(64.0)
+    , m_selectedHandleCount(0)
   {
   }
 
@@ -324,8 +360,15 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    auto [it, inserted] = m_handles.try_emplace(handle);
+    it->second.inc();
+
+    if (inserted)
+    {
+      m_handleTree.insert(handleBounds(handle), &*it);
+    }
   }
 
   /**
@@ -346,6 +389,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -360,6 +404,8 @@ public:
   void clear()
   {
     m_handles.clear();
+    m_handleTree.clear();
+    m_brushTree.clear();
     m_selectedHandleCount = 0;
   }
 
@@ -466,8 +512,10 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+    const auto bounds = handleBounds(otherHandle).expand(0.001);
+    for (auto* entry : m_handleTree.find_intersectors(bounds))
     {
+      auto& [handle, info] = *entry;
       if (compare(otherHandle, handle, epsilon) == 0)
       {
         fun(info);
@@ -507,6 +555,55 @@ private:
     }
   }
 
+protected:
+  /**
+   * Calls the given function for every handle that may be hit by the given pick ray, see
+   * mayHitHandle.
+   *
+   * @tparam F the type of the function, which must accept a handle
+   * @param pickRay the picking ray
+   * @param camera the camera
+   * @param handleRadius the handle radius
+   * @param fun the function to call
+   */
+  template <typename F>
+  void forEachHandleNearRay(
+    const vm::ray3& pickRay,
+    const Renderer::Camera& camera,
+    const FloatType handleRadius,
+    const F& fun) const
+  {
+    const auto entries = m_handleTree.find_if([&](const vm::bbox3& bounds) {
+      return mayHitHandle(pickRay, camera, handleRadius, bounds);
+    });
+
+    for (const auto* entry : entries)
+    {
+      fun(entry->first);
+    }
+  }
+
+  /**
+   * Adds the given brush to the brushes considered by findIncidentBrushes.
+   */
+  void addIncidentBrush(const Model::BrushNode* brushNode)
+  {
+    // the brushes are only handed back to the callers that own them
+    auto* mutableBrushNode = const_cast<Model::BrushNode*>(brushNode);
+    if (!m_brushTree.contains(mutableBrushNode))
+    {
+      m_brushTree.insert(brushNode->logicalBounds(), mutableBrushNode);
+    }
+  }
+
+  /**
+   * Removes the given brush from the brushes considered by findIncidentBrushes.
+   */
+  void removeIncidentBrush(const Model::BrushNode* brushNode)
+  {
+    m_brushTree.remove(const_cast<Model::BrushNode*>(brushNode));
+  }
+
 public:
   /**
    * Applies the given picking test to all handles in this manager and adds all hits to
@@ -531,6 +628,27 @@ public:
   }
 
 public:
+  /**
+   * Finds and returns all brushes whose handles were added to this manager and which are
+   * incident to the given handle.
+   *
+   * @param handle the handle
+   * @return a set of all brushes that are incident to the given handle
+   */
+  std::vector<Model::BrushNode*> findIncidentBrushes(const Handle& handle) const
+  {
+    auto result = kdl::vector_set<Model::BrushNode*>{};
+    const auto bounds = handleBounds(handle).expand(0.001);
+    for (auto* brushNode : m_brushTree.find_intersectors(bounds))
+    {
+      if (isIncident(handle, brushNode))
+      {
+        result.insert(brushNode);
+      }
+    }
+    return result.release_data();
+  }
+
   /**
    * Finds and returns all brushes in the given range which are incident to the given
    * handle.
@@ -138,27 +138,24 @@ public:
     return result;
   }
 
-  // FIXME: use vector_set
+  // the handle managers contain the handles of exactly the selected brushes, so we can
+  // use their spatial index to find the incident brushes
   template <typename M, typename H2>
   std::vector<Model::BrushNode*> findIncidentBrushes(
     const M& manager, const H2& handle) const
   {
-    const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
-    return manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes));
+    return manager.findIncidentBrushes(handle);
   }
 
-  // FIXME: use vector_set
   template <typename M, typename I>
   std::vector<Model::BrushNode*> findIncidentBrushes(const M& manager, I cur, I end) const
   {
-    const std::vector<Model::BrushNode*>& brushes = selectedBrushes();
     kdl::vector_set<Model::BrushNode*> result;
-    auto out = std::inserter(result, std::end(result));
 
     while (cur != end)
     {
-      const auto& handle = *cur;
-      manager.findIncidentBrushes(handle, std::begin(brushes), std::end(brushes), out);
+      const auto brushes = manager.findIncidentBrushes(*cur);
+      result.insert(std::begin(brushes), std::end(brushes));
       ++cur;
     }
 
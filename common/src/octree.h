@@ -39,6 +39,8 @@
 #include <cstdint>
 #include <optional>
 #include <ostream>
+#include <queue>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -554,6 +556,75 @@ public:
     }
   }
 
+  /**
+   * Visits every data item in this tree that is stored in a node whose bounds intersect
+   * with the given ray. The nodes are visited in the order of the distance at which the
+   * ray enters them, so that the caller can stop the traversal once it has found what it
+   * is looking for.
+   *
+   * The visitor is called with a data item and the distance at which the ray enters the
+   * node containing that item. Since the bounds of every item are contained in the
+   * bounds of its node, any intersection between the ray and an item's bounds is at
+   * least that far away. The traversal stops if the visitor returns false.
+   *
+   * @tparam V the visitor type, which accepts a data item and a distance and returns
+   * whether to continue the traversal
+   * @param ray the ray to test
+   * @param visitor the visitor to call
+   */
+  template <typename V>
+  void visit_intersectors_near_to_far(const vm::ray<T, 3>& ray, const V& visitor) const
+  {
+    using entry = std::tuple<T, const node*>;
+    const auto compare = [](const entry& lhs, const entry& rhs) {
+      return std::get<0>(lhs) > std::get<0>(rhs);
+    };
+    auto queue =
+      std::priority_queue<entry, std::vector<entry>, decltype(compare)>{compare};
+
+    const auto push = [&](const node& node) {
+      const auto bounds = get_address(node).to_bounds(m_min_size);
+      if (bounds.contains(ray.origin))
+      {
+        queue.emplace(T(0), &node);
+      }
+      else if (const auto distance = vm::intersect_ray_bbox(ray, bounds))
+      {
+        queue.emplace(*distance, &node);
+      }
+    };
+
+    if (m_root)
+    {
+      push(*m_root);
+    }
+
+    while (!queue.empty())
+    {
+      const auto [distance, current] = queue.top();
+      queue.pop();
+
+      for (const auto& data : get_data(*current))
+      {
+        if (!visitor(data, distance))
+        {
+          return;
+        }
+      }
+
+      if (const auto* inner = std::get_if<inner_node>(current))
+      {
+        for (const auto& child : inner->children)
+        {
+          if (!is_leaf_node(child) || !get_data(child).empty())
+          {
+            push(child);
+          }
+        }
+      }
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box intersects with the given bbox
    * and returns a list of those items.
@@ -633,6 +704,52 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and returns a list of those items.
+   *
+   * @tparam P the predicate type, which accepts the bounds of a node
+   * @param predicate the predicate to apply to the node bounds
+   * @return a list containing all found data items
+   */
+  template <typename P>
+  std::vector<U> find_if(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_if(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and appends it to the given output iterator.
+   *
+   * The children of a node are only visited if the node satisfies the predicate, so the
+   * predicate must return false for a node only if it returns false for all of its
+   * children.
+   *
+   * @tparam P the predicate type, which accepts the bounds of a node
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply to the node bounds
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::copy(data.begin(), data.end(), out);
+        },
+        [&](const auto& node) {
+          return predicate(get_address(node).to_bounds(m_min_size));
+        });
+    }
+  }
+
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 
 private:
@@ -34,7 +34,11 @@
 #include "vm/intersection.h"
 #include "vm/ray.h"
 
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <utility>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -147,4 +151,72 @@ TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
   CHECK(renderer1 != nullptr);
   CHECK(renderer2 != nullptr);
 }
+
+TEST_CASE("EntityModelTest.loadFrame")
+{
+  auto modelData =
+    EntityModelData{Assets::PitchType::Normal, Assets::Orientation::Oriented};
+  auto& surface = modelData.addSurface("surface", 2);
+
+  auto materials = std::vector<Material>{};
+  materials.push_back(makeDummyMaterial("skin"));
+  surface.setSkins(std::move(materials));
+
+  auto builder = makeDummyBuilder();
+  auto& frame0 = modelData.addFrame("frame 0", vm::bbox3f{0, 8});
+  surface.addMesh(frame0, builder.vertices(), builder.indices());
+
+  auto loadCount = std::atomic<size_t>{0};
+  modelData.addFrame(
+    "frame 1", vm::bbox3f{0, 8}, [&](EntityModelData& data, EntityModelFrame& frame) {
+      ++loadCount;
+      auto frameBuilder = makeDummyBuilder();
+      data.surface(0).addMesh(frame, frameBuilder.vertices(), frameBuilder.indices());
+    });
+
+  CHECK(modelData.frameCount() == 2u);
+  CHECK(modelData.isFrameLoaded(0));
+  CHECK_FALSE(modelData.isFrameLoaded(1));
+  CHECK(loadCount == 0u);
+
+  SECTION("Accessing the frame loads it")
+  {
+    const auto* frame1 = std::as_const(modelData).frame(1);
+    REQUIRE(frame1 != nullptr);
+    CHECK(frame1->name() == "frame 1");
+    CHECK(modelData.isFrameLoaded(1));
+    CHECK(loadCount == 1u);
+
+    std::as_const(modelData).frame("frame 1");
+    CHECK(loadCount == 1u);
+  }
+
+  SECTION("Concurrent accesses load the frame once")
+  {
+    auto frames = std::vector<std::future<const EntityModelFrame*>>{};
+    for (size_t i = 0; i < 8; ++i)
+    {
+      frames.push_back(std::async(
+        std::launch::async, [&]() { return std::as_const(modelData).frame(1); }));
+    }
+
+    for (auto& frame : frames)
+    {
+      CHECK(frame.get() == std::as_const(modelData).frame(1));
+    }
+    CHECK(modelData.isFrameLoaded(1));
+    CHECK(loadCount == 1u);
+  }
+
+  SECTION("Moving the model data keeps the loader")
+  {
+    auto movedModelData = std::move(modelData);
+    CHECK_FALSE(movedModelData.isFrameLoaded(1));
+
+    movedModelData.loadFrame(1);
+    CHECK(movedModelData.isFrameLoaded(1));
+    CHECK(loadCount == 1u);
+    CHECK(movedModelData.buildRenderer(0, 1) != nullptr);
+  }
+}
 } // namespace TrenchBroom::Assets
@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/BufferedWriter.h"
+
+#include <sstream>
+#include <string>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::IO
+{
+
+TEST_CASE("BufferedWriter")
+{
+  auto stream = std::ostringstream{};
+
+  SECTION("Output is written when flushing")
+  {
+    auto writer = BufferedWriter{stream};
+    writer.write("{\n");
+    writer.format("( {} {} {} ) {}\n", 1.5, -2.0, 0.125, "some_material");
+    CHECK(stream.str().empty());
+
+    writer.flush();
+    CHECK(stream.str() == "{\n( 1.5 -2 0.125 ) some_material\n");
+
+    writer.write("}\n");
+    writer.flush();
+    CHECK(stream.str() == "{\n( 1.5 -2 0.125 ) some_material\n}\n");
+  }
+
+  SECTION("Output is written when destroying the writer")
+  {
+    {
+      auto writer = BufferedWriter{stream};
+      writer.format("// brush {}\n", 7);
+    }
+    CHECK(stream.str() == "// brush 7\n");
+  }
+
+  SECTION("Output is written when the buffer is full")
+  {
+    auto writer = BufferedWriter{stream, 8};
+    writer.write("abc");
+    CHECK(stream.str().empty());
+
+    writer.format("{}{}", "def", "gh");
+    CHECK(stream.str() == "abcdefgh");
+
+    writer.write("ij");
+    CHECK(stream.str() == "abcdefgh");
+
+    writer.write("0123456789");
+    CHECK(stream.str() == "abcdefghij0123456789");
+  }
+}
+
+} // namespace TrenchBroom::IO
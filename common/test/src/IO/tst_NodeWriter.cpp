@@ -18,6 +18,7 @@
  */
 
 #include "Exceptions.h"
+#include "IO/MapFileSerializer.h"
 #include "IO/NodeWriter.h"
 #include "Model/BezierPatch.h"
 #include "Model/BrushBuilder.h"
@@ -1021,6 +1022,81 @@ TEST_CASE("NodeWriterTest.writeFaces")
   delete brushNode;
 }
 
+TEST_CASE("NodeWriterTest.reuseCachedSerializations")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Standard};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* brushNode1 =
+    new Model::BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+  auto* brushNode2 =
+    new Model::BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+  map.defaultLayer()->addChildren({brushNode1, brushNode2});
+
+  const auto writeMap = [&]() {
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.writeMap();
+    return str.str();
+  };
+
+  const auto original = writeMap();
+
+  const auto cachedSerialization1 = brushNode1->cachedSerialization();
+  const auto cachedSerialization2 = brushNode2->cachedSerialization();
+  REQUIRE(cachedSerialization1 != nullptr);
+  REQUIRE(cachedSerialization2 != nullptr);
+  REQUIRE(brushNode1->lineNumber() == 5u);
+  REQUIRE(brushNode2->lineNumber() == 14u);
+
+  SECTION("Unchanged nodes are not serialized again")
+  {
+    CHECK(writeMap() == original);
+    CHECK(brushNode1->cachedSerialization() == cachedSerialization1);
+    CHECK(brushNode2->cachedSerialization() == cachedSerialization2);
+    CHECK(brushNode1->lineNumber() == 5u);
+    CHECK(brushNode2->lineNumber() == 14u);
+  }
+
+  SECTION("Changed nodes are serialized again")
+  {
+    Model::transformNode(
+      *brushNode1, vm::translation_matrix(vm::vec3{64, 0, 0}), worldBounds);
+    CHECK(brushNode1->cachedSerialization() == nullptr);
+
+    const auto actual = writeMap();
+    CHECK(actual != original);
+    CHECK(
+      actual.find("( 96 32 32 ) ( 96 33 32 ) ( 97 32 32 ) none 0 0 0 1 1")
+      != std::string::npos);
+    CHECK(brushNode1->cachedSerialization() != nullptr);
+    CHECK(brushNode1->cachedSerialization() != cachedSerialization1);
+    CHECK(brushNode2->cachedSerialization() == cachedSerialization2);
+    CHECK(brushNode1->lineNumber() == 5u);
+    CHECK(brushNode2->lineNumber() == 14u);
+  }
+
+  SECTION("Nodes are serialized again for another map format")
+  {
+    auto str = std::stringstream{};
+    auto writer =
+      NodeWriter{map, MapFileSerializer::create(Model::MapFormat::Valve, str)};
+    writer.writeMap();
+
+    CHECK(brushNode1->cachedSerialization() != cachedSerialization1);
+    CHECK(brushNode1->cachedSerialization()->format == Model::MapFormat::Valve);
+  }
+
+  SECTION("Clones share the cached serialization")
+  {
+    auto clone =
+      std::unique_ptr<Model::Node>{brushNode1->cloneRecursively(worldBounds)};
+    CHECK(clone->cachedSerialization() == cachedSerialization1);
+  }
+}
+
 TEST_CASE("NodeWriterTest.writePropertiesWithQuotationMarks")
 {
   Model::WorldNode map(
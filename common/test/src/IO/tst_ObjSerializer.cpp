@@ -38,9 +38,12 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -70,7 +73,8 @@ TEST_CASE("ObjSerializer.writeBrush")
   writer.writeMap();
 
   CHECK(objStream.str() == R"(mtllib some_file_name.mtl
-# vertices
+
+o entity0_brush0
 v -32 -32 -32
 v -32 -32 32
 v -32 32 32
@@ -79,22 +83,16 @@ v 32 32 32
 v 32 -32 32
 v 32 -32 -32
 v 32 32 -32
-
-# texture coordinates
 vt 32 -32
 vt -32 -32
 vt -32 32
 vt 32 32
-
-# normals
 vn -1 0 -0
 vn 0 0 1
 vn 0 -1 -0
 vn 0 1 -0
 vn 0 0 -1
 vn 1 0 -0
-
-o entity0_brush0
 usemtl some_material
 f  1/1/1  2/2/1  3/3/1  4/4/1
 usemtl some_material
@@ -148,7 +146,8 @@ TEST_CASE("ObjSerializer.writePatch")
   writer.writeMap();
 
   CHECK(objStream.str() == R"(mtllib some_file_name.mtl
-# vertices
+
+o entity0_patch0
 v 0 0 -0
 v 0 0.21875 -0.25
 v 0.25 0.4375 -0.25
@@ -230,11 +229,7 @@ v 1.25 0.46875 -2
 v 1.5 0.375 -2
 v 1.75 0.21875 -2
 v 2 0 -2
-
-# texture coordinates
 vt 0 -0
-
-# normals
 vn 0.5499719409228703 -0.6285393610547089 -0.5499719409228703
 vn 0.5734623443633283 -0.6553855364152325 -0.4915391523114243
 vn 0.5144957554275265 -0.6859943405700353 -0.5144957554275265
@@ -316,8 +311,6 @@ vn -0.1849000654084097 -0.7396002616336388 0.647150228929434
 vn -0.35218036253024954 -0.7043607250604991 0.6163156344279367
 vn -0.4915391523114243 -0.6553855364152325 0.5734623443633283
 vn -0.5499719409228703 -0.6285393610547089 0.5499719409228703
-
-o entity0_patch0
 usemtl some_material
 f  1/1/1  2/1/2  3/1/3  4/1/4
 f  4/1/4  3/1/3  5/1/5  6/1/6
@@ -391,6 +384,108 @@ f  71/1/71  80/1/80  81/1/81  72/1/72
 )");
 }
 
+TEST_CASE("ObjSerializer.writeFlatPatch")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* patchNode = new Model::PatchNode{Model::BezierPatch{
+    3,
+    3,
+    {{0, 0, 0},
+     {1, 0, 0},
+     {2, 0, 0},
+     {0, 1, 0},
+     {1, 1, 0},
+     {2, 1, 0},
+     {0, 2, 0},
+     {1, 2, 0},
+     {2, 2, 0}},
+    "some_material"}};
+  map.defaultLayer()->addChild(patchNode);
+
+  auto objStream = std::ostringstream{};
+  auto mtlStream = std::ostringstream{};
+  const auto mtlFilename = "some_file_name.mtl";
+  const auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+
+  auto writer = NodeWriter{
+    map, std::make_unique<ObjSerializer>(objStream, mtlStream, mtlFilename, objOptions)};
+  writer.writeMap();
+
+  // flat patches are not subdivided
+  CHECK(objStream.str() == R"(mtllib some_file_name.mtl
+
+o entity0_patch0
+v 0 0 -0
+v 0 0 -2
+v 2 0 -2
+v 2 0 -0
+vt 0 -0
+vn 0 -1 -0
+usemtl some_material
+f  1/1/1  2/1/1  3/1/1  4/1/1
+
+)");
+}
+
+TEST_CASE("ObjSerializer.writeMultipleBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto map = Model::WorldNode{{}, {}, Model::MapFormat::Quake3};
+
+  auto builder = Model::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* brushNode1 =
+    new Model::BrushNode{builder.createCube(64.0, "some_material") | kdl::value()};
+  auto* brushNode2 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{64, 64, 64}, {128, 128, 128}}, "some_material")
+    | kdl::value()};
+  map.defaultLayer()->addChild(brushNode1);
+  map.defaultLayer()->addChild(brushNode2);
+
+  auto objStream = std::ostringstream{};
+  auto mtlStream = std::ostringstream{};
+  const auto mtlFilename = "some_file_name.mtl";
+
+  auto progress = std::vector<double>{};
+  auto objOptions =
+    ObjExportOptions{"/some/export/path.obj", ObjMtlPathMode::RelativeToGamePath};
+  objOptions.progress = [&](const double value) { progress.push_back(value); };
+
+  auto writer = NodeWriter{
+    map, std::make_unique<ObjSerializer>(objStream, mtlStream, mtlFilename, objOptions)};
+  writer.writeMap();
+
+  const auto countLines = [&](const std::string& prefix) {
+    auto count = size_t(0);
+    auto str = std::istringstream{objStream.str()};
+    for (auto line = std::string{}; std::getline(str, line);)
+    {
+      if (line.starts_with(prefix))
+      {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  // the second brush's vertex indices follow those of the first brush
+  CHECK(countLines("o ") == 2);
+  CHECK(countLines("v ") == 16);
+  CHECK_THAT(objStream.str(), Catch::Contains("f  9/"));
+
+  // the normals are shared between the brushes
+  CHECK(countLines("vn ") == 6);
+
+  CHECK_FALSE(progress.empty());
+  CHECK(std::is_sorted(progress.begin(), progress.end()));
+  CHECK(progress.back() == 1.0);
+}
+
 TEST_CASE("ObjSerializer.writeRelativeMaterialPath")
 {
   const auto worldBounds = vm::bbox3{8192.0};
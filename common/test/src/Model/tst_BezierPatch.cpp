@@ -60,6 +60,49 @@ TEST_CASE("BezierPatch.evaluate")
   CHECK(patch.evaluate(subdiv) == expectedGrid);
 }
 
+TEST_CASE("BezierPatch.requiredSubdivisionsPerSurface")
+{
+  using P = BezierPatch::Point;
+
+  SECTION("Flat patch")
+  {
+    // clang-format off
+    const auto patch = BezierPatch{3, 3, { P{0, 0, 0}, P{1, 0, 0}, P{2, 0, 0},
+                                           P{0, 1, 0}, P{1, 1, 0}, P{2, 1, 0},
+                                           P{0, 2, 0}, P{1, 2, 0}, P{2, 2, 0} }, ""};
+    // clang-format on
+
+    CHECK(patch.requiredSubdivisionsPerSurface(0.5, 3) == 0u);
+    CHECK(patch.requiredSubdivisionsPerSurface(0.0, 3) == 0u);
+  }
+
+  SECTION("Curved patch")
+  {
+    // clang-format off
+    const auto patch = BezierPatch{3, 3, { P{0, 0, 0}, P{1, 0, 1}, P{2, 0, 0},
+                                           P{0, 1, 1}, P{1, 1, 2}, P{2, 1, 1},
+                                           P{0, 2, 0}, P{1, 2, 1}, P{2, 2, 0} }, ""};
+    // clang-format on
+
+    CHECK(patch.requiredSubdivisionsPerSurface(1.0, 3) == 0u);
+    CHECK(patch.requiredSubdivisionsPerSurface(0.5, 3) == 1u);
+    CHECK(patch.requiredSubdivisionsPerSurface(0.1, 3) == 2u);
+    CHECK(patch.requiredSubdivisionsPerSurface(0.01, 3) == 3u);
+    CHECK(patch.requiredSubdivisionsPerSurface(0.01, 2) == 2u);
+  }
+
+  SECTION("Flat patch with curved texture coordinates")
+  {
+    // clang-format off
+    const auto patch = BezierPatch{3, 3, { P{0, 0, 0, 0.0, 0}, P{1, 0, 0, 0.25, 0}, P{2, 0, 0, 1.0, 0},
+                                           P{0, 1, 0, 0.0, 1}, P{1, 1, 0, 0.25, 1}, P{2, 1, 0, 1.0, 1},
+                                           P{0, 2, 0, 0.0, 2}, P{1, 2, 0, 0.25, 2}, P{2, 2, 0, 1.0, 2} }, ""};
+    // clang-format on
+
+    CHECK(patch.requiredSubdivisionsPerSurface(0.5, 3) == 3u);
+  }
+}
+
 TEST_CASE("BezierPatch.transform")
 {
   // clang-format off
@@ -40,6 +40,9 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/mat_io.h"
 #include "vm/polygon.h"
 #include "vm/ray.h"
 #include "vm/segment.h"
@@ -48,6 +51,7 @@
 
 #include <fstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Catch2.h"
@@ -124,6 +128,46 @@ TEST_CASE("BrushTest.constructBrushWithRedundantFaces")
           .is_error());
 }
 
+TEST_CASE("BrushTest.copy")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  const auto original = builder.createCube(64.0, "material") | kdl::value();
+
+  auto copy = original;
+  REQUIRE(copy == original);
+
+  // the copy shares the geometry of the original
+  CHECK(&copy.vertices() == &original.vertices());
+  for (size_t i = 0; i < copy.faceCount(); ++i)
+  {
+    CHECK(copy.face(i).geometry() == original.face(i).geometry());
+  }
+
+  SECTION("Changing face attributes keeps the geometry shared")
+  {
+    copy.face(0).setAttributes(BrushFaceAttributes{"other_material"});
+    CHECK(&copy.vertices() == &original.vertices());
+  }
+
+  SECTION("Transforming the copy detaches its geometry")
+  {
+    REQUIRE(copy
+              .transform(worldBounds, vm::translation_matrix(vm::vec3{16, 0, 0}), false)
+              .is_success());
+
+    CHECK(&copy.vertices() != &original.vertices());
+    CHECK(original.bounds() == vm::bbox3{32.0});
+    CHECK(copy.bounds() == vm::bbox3{{-16, -32, -32}, {48, 32, 32}});
+    for (size_t i = 0; i < copy.faceCount(); ++i)
+    {
+      CHECK(copy.face(i).geometry() != original.face(i).geometry());
+      CHECK(copy.face(i).boundary().normal == original.face(i).boundary().normal);
+    }
+    CHECK(copy == (Brush::create(worldBounds, copy.faces()) | kdl::value()));
+  }
+}
+
 TEST_CASE("BrushTest.clip")
 {
   const vm::bbox3 worldBounds(4096.0);
@@ -284,6 +328,41 @@ TEST_CASE("BrushTest.contractToZero")
   CHECK(brush1.expand(worldBounds, -64, true).is_error());
 }
 
+TEST_CASE("BrushTest.transform")
+{
+  const auto worldBounds = vm::bbox3{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush =
+    builder.createCuboid(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 32, 16}}, "material")
+    | kdl::value();
+
+  using T = std::tuple<vm::mat4x4, vm::bbox3>;
+
+  // clang-format off
+  const auto [transformation, expectedBounds] = GENERATE(values<T>({
+  {vm::translation_matrix(vm::vec3{16, 8, -4}),         {{16, 8, -4}, {80, 40, 12}}},
+  {vm::rotation_matrix(0.0, 0.0, vm::to_radians(90.0)), {{-32, 0, 0}, {0, 64, 16}}},
+  {vm::scaling_matrix(vm::vec3{2, 1, 1}),               {{0, 0, 0}, {128, 32, 16}}},
+  {vm::mirror_matrix<FloatType>(vm::axis::x),           {{-64, 0, 0}, {0, 32, 16}}},
+  }));
+  // clang-format on
+
+  CAPTURE(transformation);
+
+  REQUIRE(brush.transform(worldBounds, transformation, false).is_success());
+
+  const auto expectedVertices = expectedBounds.vertices();
+  CHECK(brush.bounds() == expectedBounds);
+  CHECK_THAT(
+    brush.vertexPositions(),
+    Catch::UnorderedEquals(
+      std::vector<vm::vec3>{expectedVertices.begin(), expectedVertices.end()}));
+
+  // the result must not depend on whether the geometry was transformed or rebuilt
+  CHECK(brush == (Brush::create(worldBounds, brush.faces()) | kdl::value()));
+}
+
 TEST_CASE("BrushTest.moveVertex")
 {
   const vm::bbox3 worldBounds(4096.0);
@@ -29,6 +29,7 @@
 #include "kdl/result.h"
 
 #include <string>
+#include <tuple>
 
 #include "CatchUtils/Matchers.h"
 
@@ -180,6 +181,38 @@ TEST_CASE("BrushBuilderTest.createCylinder")
     })});
 }
 
+TEST_CASE("BrushBuilderTest.createCylinderWithDifferentBounds")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  using T = std::tuple<vm::bbox3, vm::axis::type>;
+
+  // clang-format off
+  const auto
+  [bounds,                                     axis] = GENERATE(values<T>({
+  {vm::bbox3{{-32, -32, -32}, {32, 32, 32}},   vm::axis::z},
+  {vm::bbox3{{0, 0, 0}, {128, 64, 16}},        vm::axis::z},
+  {vm::bbox3{{0, 0, 0}, {128, 64, 16}},        vm::axis::x},
+  {vm::bbox3{{16, -64, 8}, {48, 64, 256}},     vm::axis::y},
+  }));
+  // clang-format on
+
+  CAPTURE(bounds, axis);
+
+  const auto cylinder =
+    builder.createCylinder(bounds, 16, RadiusMode::ToEdge, axis, "someName");
+  REQUIRE(cylinder.is_success());
+  CHECK(cylinder.value().faceCount() == 18u);
+  CHECK(cylinder.value().bounds() == bounds);
+
+  const auto cone = builder.createCone(bounds, 16, RadiusMode::ToEdge, axis, "someName");
+  REQUIRE(cone.is_success());
+  CHECK(cone.value().faceCount() == 17u);
+  CHECK(cone.value().bounds() == bounds);
+}
+
 TEST_CASE("BrushBuilderTest.createHollowCylinder")
 {
   const auto worldBounds = vm::bbox3{8192.0};
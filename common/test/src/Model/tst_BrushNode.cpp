@@ -25,6 +25,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
+#include "Model/BrushGeometry.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
@@ -34,6 +35,9 @@
 #include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
 #include "Model/PickResult.h"
+#include "Model/Polyhedron.h"
+#include "Renderer/BrushRendererBrushCache.h"
+#include "Renderer/GLVertex.h"
 #include "TestUtils.h"
 
 #include "kdl/collection_utils.h"
@@ -43,6 +47,8 @@
 #include "vm/approx.h"
 #include "vm/bbox.h"
 #include "vm/bbox_io.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/polygon.h"
 #include "vm/ray.h"
 #include "vm/segment.h"
@@ -169,6 +175,117 @@ TEST_CASE("BrushNodeTest.hasSelectedFaces")
   }
 }
 
+TEST_CASE("BrushNodeTest.setBrush")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto getUVCoords = [](const auto& brushCache) {
+    return kdl::vec_transform(brushCache.cachedVertices(), [](const auto& vertex) {
+      return Renderer::getVertexComponent<2>(vertex);
+    });
+  };
+
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  auto brushNode = BrushNode{builder.createCube(64.0, "some_material") | kdl::value()};
+
+  auto& brushCache = brushNode.brushRendererBrushCache();
+  brushCache.validateVertexCache(brushNode);
+
+  const auto uvCoordsVersion = brushCache.uvCoordsVersion();
+  const auto originalUVCoords = getUVCoords(brushCache);
+
+  auto brush = brushNode.brush();
+
+  SECTION("Changing the UV coordinates only invalidates the cached UV coordinates")
+  {
+    auto attributes = brush.face(0).attributes();
+    attributes.setOffset({16, 8});
+    attributes.setRotation(45.0f);
+    brush.face(0).setAttributes(attributes);
+    brushNode.setBrush(std::move(brush));
+
+    CHECK(brushCache.onlyUVCoordsChangedSince(uvCoordsVersion));
+
+    brushCache.validateVertexCache(brushNode);
+    CHECK(getUVCoords(brushCache) != originalUVCoords);
+
+    auto expectedBrushCache = Renderer::BrushRendererBrushCache{};
+    expectedBrushCache.validateVertexCache(brushNode);
+    CHECK(getUVCoords(brushCache) == getUVCoords(expectedBrushCache));
+
+    const auto& faces = brushNode.brush().faces();
+    for (const auto& cachedFace : brushCache.cachedFacesSortedByMaterial())
+    {
+      CHECK(cachedFace.face >= faces.data());
+      CHECK(cachedFace.face < faces.data() + faces.size());
+    }
+    for (const auto& cachedEdge : brushCache.cachedEdges())
+    {
+      CHECK(cachedEdge.face1 >= faces.data());
+      CHECK(cachedEdge.face1 < faces.data() + faces.size());
+    }
+  }
+
+  SECTION("Changing other attributes invalidates the vertex cache")
+  {
+    auto attributes = brush.face(0).attributes();
+    attributes.setSurfaceValue(1.0f);
+    brush.face(0).setAttributes(attributes);
+    brushNode.setBrush(std::move(brush));
+
+    CHECK_FALSE(brushCache.onlyUVCoordsChangedSince(uvCoordsVersion));
+  }
+
+  SECTION("Changing the geometry invalidates the vertex cache")
+  {
+    REQUIRE(brush
+              .transform(worldBounds, vm::translation_matrix(vm::vec3{16, 0, 0}), false)
+              .is_success());
+    brushNode.setBrush(std::move(brush));
+
+    CHECK_FALSE(brushCache.onlyUVCoordsChangedSince(uvCoordsVersion));
+  }
+}
+
+TEST_CASE("BrushNodeTest.validateVertexCache")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+  auto brushNode = BrushNode{builder.createCube(64.0, "some_material") | kdl::value()};
+  auto copyNode = BrushNode{brushNode.brush()};
+  REQUIRE(copyNode.brush().sharesGeometryWith(brushNode.brush()));
+
+  auto& brushCache = brushNode.brushRendererBrushCache();
+  brushCache.validateVertexCache(brushNode);
+  copyNode.brushRendererBrushCache().validateVertexCache(copyNode);
+
+  // the geometry is shared with the copy, so the cache must not write into it
+  for (const auto* vertex : brushNode.brush().vertices())
+  {
+    CHECK(vertex->payload() == BrushVertexPayload::defaultValue());
+  }
+
+  const auto& cachedVertices = brushCache.cachedVertices();
+  const auto& cachedEdges = brushCache.cachedEdges();
+  REQUIRE(cachedEdges.size() == brushNode.brush().edgeCount());
+
+  auto cachedEdgeIt = cachedEdges.begin();
+  for (const auto* edge : brushNode.brush().edges())
+  {
+    const auto getPosition = [&](const size_t vertexIndex) {
+      return Renderer::getVertexComponent<0>(cachedVertices[vertexIndex]);
+    };
+
+    CHECK(
+      getPosition(cachedEdgeIt->vertexIndex1RelativeToBrush)
+      == vm::vec3f{edge->firstVertex()->position()});
+    CHECK(
+      getPosition(cachedEdgeIt->vertexIndex2RelativeToBrush)
+      == vm::vec3f{edge->secondVertex()->position()});
+    ++cachedEdgeIt;
+  }
+}
+
 TEST_CASE("BrushNodeTest.containsPatchNode")
 {
   const auto worldBounds = vm::bbox3d{8192.0};
@@ -17,10 +17,12 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Error.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityNodeIndex.h"
 
+#include "kdl/result.h"
 #include "kdl/vector_utils.h"
 
 #include <string>
@@ -227,6 +229,123 @@ TEST_CASE("EntityNodeIndexTest.allValuesForKeys")
   CHECK_THAT(
     index.allValuesForKeys(EntityNodeIndexQuery::exact("test")),
     Catch::UnorderedEquals(std::vector<std::string>{"somevalue", "somevalue2"}));
+
+  CHECK_THAT(
+    index.allValuesForKeys(EntityNodeIndexQuery::substring("the")),
+    Catch::UnorderedEquals(std::vector<std::string>{"someothervalue"}));
+
+  delete entity1;
+  delete entity2;
+}
+
+TEST_CASE("EntityNodeIndexTest.findEntityNodesByValueQuery")
+{
+  auto index = EntityNodeIndex{};
+
+  auto* entity1 = new EntityNode{Entity{{
+    {"classname", "light"},
+    {"target", "door_trigger_1"},
+  }}};
+
+  auto* entity2 = new EntityNode{Entity{{
+    {"classname", "func_door"},
+    {"targetname", "door_trigger_1"},
+  }}};
+
+  auto* entity3 = new EntityNode{Entity{{
+    {"classname", "func_button"},
+    {"target", "lift_trigger_12"},
+  }}};
+
+  index.addEntityNode(entity1);
+  index.addEntityNode(entity2);
+  index.addEntityNode(entity3);
+
+  const auto find = [&](const auto& keyQuery, const auto& valueQuery) {
+    return index.findEntityNodes(keyQuery, valueQuery);
+  };
+
+  using Q = EntityNodeIndexQuery;
+
+  SECTION("Substring queries")
+  {
+    CHECK_THAT(
+      find(Q::any(), Q::substring("trigger")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2, entity3}));
+    CHECK_THAT(
+      find(Q::exact("target"), Q::substring("trigger")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity3}));
+    CHECK_THAT(
+      find(Q::any(), Q::substring("func_")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity2, entity3}));
+    CHECK_THAT(
+      find(Q::substring("name"), Q::any()),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2, entity3}));
+    CHECK_THAT(
+      find(Q::substring("tname"), Q::substring("door")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity2}));
+    CHECK(find(Q::any(), Q::substring("Trigger")).empty());
+    CHECK(find(Q::any(), Q::substring("xyz")).empty());
+  }
+
+  SECTION("Short substring queries")
+  {
+    CHECK_THAT(
+      find(Q::any(), Q::substring("ft")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity3}));
+    CHECK_THAT(
+      find(Q::any(), Q::substring("")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2, entity3}));
+  }
+
+  SECTION("Glob queries")
+  {
+    CHECK_THAT(
+      find(Q::any(), Q::glob("*_trigger_%")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2}));
+    CHECK_THAT(
+      find(Q::any(), Q::glob("*_trigger_%*")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2, entity3}));
+    CHECK_THAT(
+      find(Q::glob("target*"), Q::glob("door*")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity2}));
+    CHECK_THAT(
+      find(Q::glob("classname"), Q::glob("func_b?tton")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity3}));
+    CHECK(find(Q::any(), Q::glob("trigger*")).empty());
+  }
+
+  SECTION("Regex queries")
+  {
+    CHECK_THAT(
+      find(Q::any(), Q::regex("^func_(door|button)$") | kdl::value()),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity2, entity3}));
+    CHECK_THAT(
+      find(Q::exact("target"), Q::regex("_trigger_[0-9]{2}$") | kdl::value()),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity3}));
+    CHECK_THAT(
+      find(Q::any(), Q::regex("lift_?trigger") | kdl::value()),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity3}));
+    CHECK_THAT(
+      find(Q::regex("^target$") | kdl::value(), Q::any()),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity1, entity3}));
+    CHECK(Q::regex("door(").is_error());
+  }
+
+  SECTION("Removed properties are not found")
+  {
+    index.removeProperty(entity3, "target", "lift_trigger_12");
+    CHECK(find(Q::any(), Q::substring("lift")).empty());
+
+    index.removeEntityNode(entity1);
+    CHECK_THAT(
+      find(Q::any(), Q::substring("trigger")),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{entity2}));
+  }
+
+  delete entity1;
+  delete entity2;
+  delete entity3;
 }
 } // namespace Model
 } // namespace TrenchBroom
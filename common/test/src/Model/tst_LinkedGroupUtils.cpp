@@ -162,6 +162,80 @@ TEST_CASE("GroupNode.updateLinkedGroups")
   }
 }
 
+TEST_CASE("GroupNode.updateLinkedNodes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto groupNode = GroupNode{Group{"name"}};
+  auto* entityNode1 = new EntityNode{Entity{}};
+  auto* entityNode2 = new EntityNode{Entity{}};
+  groupNode.addChildren({entityNode1, entityNode2});
+
+  auto groupNodeClone = std::unique_ptr<GroupNode>{
+    static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+  transformNode(*groupNodeClone, vm::translation_matrix(vm::vec3{0, 2, 0}), worldBounds);
+
+  auto* clonedEntityNode1 = static_cast<EntityNode*>(groupNodeClone->children()[0]);
+  REQUIRE(clonedEntityNode1->entity().origin() == vm::vec3{0, 2, 0});
+
+  SECTION("Unchanged target group is not updated")
+  {
+    updateLinkedNodes(groupNode, {groupNodeClone.get()}, worldBounds)
+      | kdl::transform([&](const LinkedNodeUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          CHECK(r.contentsToSwap.empty());
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Only changed nodes are updated")
+  {
+    transformNode(*entityNode1, vm::translation_matrix(vm::vec3{0, 0, 3}), worldBounds);
+    REQUIRE(entityNode1->entity().origin() == vm::vec3{0, 0, 3});
+
+    updateLinkedNodes(groupNode, {groupNodeClone.get()}, worldBounds)
+      | kdl::transform([&](const LinkedNodeUpdates& r) {
+          CHECK(r.childrenToReplace.empty());
+          REQUIRE(r.contentsToSwap.size() == 1u);
+
+          const auto& [nodeToUpdate, newContents] = r.contentsToSwap.front();
+          CHECK(nodeToUpdate == clonedEntityNode1);
+
+          const auto& newEntity = std::get<Entity>(newContents.get());
+          CHECK(newEntity.origin() == vm::vec3{0, 2, 3});
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Children of structurally changed target group are replaced")
+  {
+    groupNode.addChild(new EntityNode{Entity{}});
+
+    updateLinkedNodes(groupNode, {groupNodeClone.get()}, worldBounds)
+      | kdl::transform([&](const LinkedNodeUpdates& r) {
+          CHECK(r.contentsToSwap.empty());
+          REQUIRE(r.childrenToReplace.size() == 1u);
+
+          const auto& [groupNodeToUpdate, newChildren] = r.childrenToReplace.front();
+          CHECK(groupNodeToUpdate == groupNodeClone.get());
+          CHECK(newChildren.size() == 3u);
+        })
+      | kdl::transform_error([](const auto&) { FAIL(); });
+  }
+
+  SECTION("Updating a changed node fails if it exceeds world bounds")
+  {
+    transformNode(
+      *groupNodeClone, vm::translation_matrix(vm::vec3{8192 - 8, 0, 0}), worldBounds);
+    transformNode(*entityNode1, vm::translation_matrix(vm::vec3{1, 0, 0}), worldBounds);
+
+    updateLinkedNodes(groupNode, {groupNodeClone.get()}, worldBounds)
+      | kdl::transform([](auto) { FAIL(); }) | kdl::transform_error([](auto e) {
+          CHECK(e == Error{"Updating a linked node would exceed world bounds"});
+        });
+  }
+}
+
 TEST_CASE("GroupNode.updateNestedLinkedGroups")
 {
   const auto worldBounds = vm::bbox3{8192.0};
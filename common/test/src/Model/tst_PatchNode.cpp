@@ -26,11 +26,14 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/bbox.h"
 #include "vm/ray.h"
 #include "vm/ray_io.h"
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
+#include <memory>
+
 #include "Catch2.h"
 
 namespace vm
@@ -166,6 +169,75 @@ TEST_CASE("PatchNode.makePatchGrid")
     == kdl::vec_transform(expectedPoints, [](const auto& p) { return vm::approx{p}; }));
 }
 
+TEST_CASE("PatchNode.grid")
+{
+  using P = BezierPatch::Point;
+
+  // clang-format off
+  const auto flatPatch = BezierPatch{3, 3, { P{0, 0, 0}, P{1, 0, 0}, P{2, 0, 0},
+                                             P{0, 1, 0}, P{1, 1, 0}, P{2, 1, 0},
+                                             P{0, 2, 0}, P{1, 2, 0}, P{2, 2, 0} }, "material"};
+  const auto curvedPatch = BezierPatch{3, 3, { P{0, 0,  0}, P{16, 0,  32}, P{32, 0,  0},
+                                               P{0, 16, 0}, P{16, 16, 32}, P{32, 16, 0},
+                                               P{0, 32, 0}, P{16, 32, 32}, P{32, 32, 0} }, "material"};
+  // clang-format on
+
+  SECTION("Flat patches are not subdivided")
+  {
+    const auto patchNode = PatchNode{flatPatch};
+    CHECK(patchNode.grid().pointRowCount == 2u);
+    CHECK(patchNode.grid().pointColumnCount == 2u);
+  }
+
+  SECTION("Curved patches are subdivided")
+  {
+    const auto patchNode = PatchNode{curvedPatch};
+    CHECK(patchNode.grid().pointRowCount == 9u);
+    CHECK(patchNode.grid().pointColumnCount == 9u);
+  }
+
+  SECTION("Large, gently curved patches are subdivided")
+  {
+    // clang-format off
+    const auto patchNode = PatchNode{BezierPatch{3, 3, {
+      P{0,   0,   0}, P{256,   0, 0.5}, P{512,   0, 0},
+      P{0, 256, 0.5}, P{256, 256, 1.0}, P{512, 256, 0.5},
+      P{0, 512,   0}, P{256, 512, 0.5}, P{512, 512, 0} }, "material"}};
+    // clang-format on
+
+    CHECK(patchNode.grid().pointRowCount == 9u);
+    CHECK(patchNode.grid().pointColumnCount == 9u);
+  }
+
+  SECTION("Setting a patch updates the grid")
+  {
+    auto patchNode = PatchNode{flatPatch};
+    patchNode.setPatch(curvedPatch);
+    CHECK(patchNode.grid().pointRowCount == 9u);
+    CHECK(patchNode.grid().points == makePatchGrid(curvedPatch, 3u).points);
+  }
+
+  SECTION("Setting a patch with the same control points keeps the grid")
+  {
+    auto patchNode = PatchNode{curvedPatch};
+    const auto* points = patchNode.grid().points.data();
+
+    auto patch = curvedPatch;
+    patch.setMaterialName("other_material");
+    patchNode.setPatch(std::move(patch));
+
+    CHECK(patchNode.grid().points.data() == points);
+  }
+
+  SECTION("Clones have the same grid")
+  {
+    const auto patchNode = PatchNode{curvedPatch};
+    auto clone = std::unique_ptr<PatchNode>{
+      static_cast<PatchNode*>(patchNode.clone(vm::bbox3{8192.0}))};
+    CHECK(clone->grid().points == patchNode.grid().points);
+  }
+}
+
 TEST_CASE("PatchNode.pickFlatPatch")
 {
   using P = BezierPatch::Point;
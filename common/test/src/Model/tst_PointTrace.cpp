@@ -23,7 +23,8 @@
 #include "vm/vec.h"
 #include "vm/vec_io.h"
 
-#include <sstream>
+#include <string>
+#include <string_view>
 
 #include "Catch2.h"
 
@@ -115,7 +116,6 @@ TEST_CASE("loadPointFile")
   }));
   // clang-format on
 
-  auto stream = std::istringstream{file};
-  CHECK(loadPointFile(stream) == expectedTrace);
+  CHECK(loadPointFile(std::string_view{file}) == expectedTrace);
 }
 } // namespace TrenchBroom::Model
@@ -31,6 +31,7 @@
 #include <iterator>
 #include <set>
 #include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -507,6 +508,120 @@ TEST_CASE("PolyhedronTest.swap")
   CHECK(rhs.bounds() == original.bounds());
 }
 
+TEST_CASE("PolyhedronTest.addPoints")
+{
+  const vm::vec3d p1(-64.0, -64.0, -64.0);
+  const vm::vec3d p2(-64.0, -64.0, +64.0);
+  const vm::vec3d p3(-64.0, +64.0, -64.0);
+  const vm::vec3d p4(-64.0, +64.0, +64.0);
+  const vm::vec3d p5(+64.0, -64.0, -64.0);
+  const vm::vec3d p6(+64.0, -64.0, +64.0);
+  const vm::vec3d p7(+64.0, +64.0, -64.0);
+  const vm::vec3d p8(+64.0, +64.0, +64.0);
+  const vm::vec3d p9(0.0, 0.0, 128.0);
+  const vm::vec3d p10(0.0, 0.0, 0.0);
+
+  Polyhedron3d p({p1, p2, p3, p4, p5, p6, p7, p8});
+  p.addPoints({p9, p10});
+
+  CHECK(p == Polyhedron3d({p1, p2, p3, p4, p5, p6, p7, p8, p9}));
+}
+
+TEST_CASE("PolyhedronTest.removeVertex")
+{
+  const vm::vec3d p1(-64.0, -64.0, -64.0);
+  const vm::vec3d p2(-64.0, -64.0, +64.0);
+  const vm::vec3d p3(-64.0, +64.0, -64.0);
+  const vm::vec3d p4(-64.0, +64.0, +64.0);
+  const vm::vec3d p5(+64.0, -64.0, -64.0);
+  const vm::vec3d p6(+64.0, -64.0, +64.0);
+  const vm::vec3d p7(+64.0, +64.0, -64.0);
+  const vm::vec3d p8(+64.0, +64.0, +64.0);
+  const vm::vec3d p9(0.0, 0.0, 128.0);
+
+  SECTION("Remove a corner of a cube")
+  {
+    Polyhedron3d p({p1, p2, p3, p4, p5, p6, p7, p8});
+    CHECK(p.removeVertex(p8));
+    CHECK(p == Polyhedron3d({p1, p2, p3, p4, p5, p6, p7}));
+  }
+
+  SECTION("Remove the tip of a pyramid on top of a cube")
+  {
+    Polyhedron3d p({p1, p2, p3, p4, p5, p6, p7, p8, p9});
+    CHECK(p.removeVertex(p9));
+    CHECK(p == Polyhedron3d({p1, p2, p3, p4, p5, p6, p7, p8}));
+  }
+
+  SECTION("Remove a vertex that does not exist")
+  {
+    Polyhedron3d p({p1, p2, p3, p4, p5, p6, p7, p8});
+    CHECK_FALSE(p.removeVertex(p9));
+    CHECK(p == Polyhedron3d({p1, p2, p3, p4, p5, p6, p7, p8}));
+  }
+
+  SECTION("Remove a vertex of a tetrahedron")
+  {
+    Polyhedron3d p({p1, p5, p3, p2});
+    CHECK_FALSE(p.removeVertex(p2));
+    CHECK(p == Polyhedron3d({p1, p5, p3, p2}));
+  }
+
+  SECTION("Remove each vertex")
+  {
+    const auto points = GENERATE_COPY(
+      std::vector<vm::vec3d>{p1, p2, p3, p4, p5, p6, p7, p8},
+      std::vector<vm::vec3d>{p1, p2, p3, p4, p5, p6, p7, p8, p9},
+      std::vector<vm::vec3d>{p1, p2, p3, p5, p6, p7, p9},
+      std::vector<vm::vec3d>{
+        {-32.0, -64.0, -64.0},
+        {+32.0, -64.0, -64.0},
+        {+64.0, -32.0, -64.0},
+        {+64.0, +32.0, -64.0},
+        {+32.0, +64.0, -64.0},
+        {-32.0, +64.0, -64.0},
+        {-64.0, +32.0, -64.0},
+        {-64.0, -32.0, -64.0},
+        {-16.0, -32.0, +64.0},
+        {+16.0, -32.0, +64.0},
+        {+32.0, -16.0, +64.0},
+        {+32.0, +16.0, +64.0},
+        {+16.0, +32.0, +64.0},
+        {-16.0, +32.0, +64.0},
+        {-32.0, +16.0, +64.0},
+        {-32.0, -16.0, +64.0},
+        {0.0, 0.0, 96.0}});
+
+    CAPTURE(points);
+
+    const auto original = Polyhedron3d(points);
+    for (const auto* vertex : original.vertices())
+    {
+      const auto position = vertex->position();
+      CAPTURE(position);
+
+      auto remainingPoints = std::vector<vm::vec3d>{};
+      for (const auto& point : points)
+      {
+        if (point != position)
+        {
+          remainingPoints.push_back(point);
+        }
+      }
+
+      auto p = original;
+      if (p.removeVertex(position))
+      {
+        CHECK(p == Polyhedron3d(remainingPoints));
+      }
+      else
+      {
+        CHECK(p == original);
+      }
+    }
+  }
+}
+
 TEST_CASE("PolyhedronTest.clipCubeWithHorizontalPlane")
 {
   const vm::vec3d p1(-64.0, -64.0, -64.0);
@@ -18,9 +18,10 @@
  */
 
 #include "Error.h"
-#include "IO/DiskIO.h"
 #include "Model/PortalFile.h"
 
+#include "kdl/result.h"
+
 #include "vm/polygon.h"
 
 #include <filesystem>
@@ -35,9 +36,7 @@ namespace Model
 TEST_CASE("PortalFileTest.parseInvalidPRT1")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt1_invalid.prt";
-  CHECK(IO::Disk::withInputStream(path, [](auto& stream) {
-          return Model::loadPortalFile(stream);
-        }).is_error());
+  CHECK(Model::loadPortalFile(std::filesystem::path{path}).is_error());
 }
 
 static const std::vector<vm::polygon3f> ExpectedPortals{
@@ -65,9 +64,7 @@ TEST_CASE("PortalFileTest.parsePRT1")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt1.prt";
   CHECK(
-    (IO::Disk::withInputStream(
-       path, [](auto& stream) { return Model::loadPortalFile(stream); })
-     | kdl::value())
+    (Model::loadPortalFile(std::filesystem::path{path}) | kdl::value())
       .portals()
     == ExpectedPortals);
 }
@@ -76,9 +73,7 @@ TEST_CASE("PortalFileTest.parsePRT1Q3")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt1q3.prt";
   CHECK(
-    (IO::Disk::withInputStream(
-       path, [](auto& stream) { return Model::loadPortalFile(stream); })
-     | kdl::value())
+    (Model::loadPortalFile(std::filesystem::path{path}) | kdl::value())
       .portals()
     == ExpectedPortals);
 }
@@ -87,9 +82,7 @@ TEST_CASE("PortalFileTest.parsePRT1AM")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt1am.prt";
   CHECK(
-    (IO::Disk::withInputStream(
-       path, [](auto& stream) { return Model::loadPortalFile(stream); })
-     | kdl::value())
+    (Model::loadPortalFile(std::filesystem::path{path}) | kdl::value())
       .portals()
     == ExpectedPortals);
 }
@@ -98,9 +91,7 @@ TEST_CASE("PortalFileTest.parsePRT2")
 {
   const auto path = "fixture/test/Model/PortalFile/portaltest_prt2.prt";
   CHECK(
-    (IO::Disk::withInputStream(
-       path, [](auto& stream) { return Model::loadPortalFile(stream); })
-     | kdl::value())
+    (Model::loadPortalFile(std::filesystem::path{path}) | kdl::value())
       .portals()
     == ExpectedPortals);
 }
@@ -40,6 +40,8 @@
 #include "vm/mat_ext.h"
 #include "vm/mat_io.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom::Model
@@ -429,4 +431,61 @@ TEST_CASE("WorldNodeTest.setPersistentIdsWhenAddingLayersAndGroups")
   CHECK(groupNode->persistentId() == 2u);
 }
 
+TEST_CASE("WorldNodeTest.linkIdIndex")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode1 = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  auto* brushNode2 = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+
+  setLinkId(*groupNode, "group");
+  setLinkId(*entityNode, "entity");
+  setLinkId(*brushNode1, "brush");
+
+  groupNode->addChildren({entityNode, brushNode1});
+
+  CHECK(worldNode.findNodesWithLinkId("group").empty());
+
+  worldNode.defaultLayer()->addChild(groupNode);
+  worldNode.defaultLayer()->addChild(brushNode2);
+
+  CHECK(worldNode.findNodesWithLinkId("group") == std::vector<Node*>{groupNode});
+  CHECK(worldNode.findNodesWithLinkId("entity") == std::vector<Node*>{entityNode});
+  CHECK(worldNode.findNodesWithLinkId("brush") == std::vector<Node*>{brushNode1});
+  CHECK(
+    worldNode.findNodesWithLinkId(brushNode2->linkId())
+    == std::vector<Node*>{brushNode2});
+
+  SECTION("Changing a link ID updates the index")
+  {
+    const auto oldLinkId = brushNode2->linkId();
+    setLinkId(*brushNode2, "brush");
+
+    CHECK(worldNode.findNodesWithLinkId(oldLinkId).empty());
+    CHECK_THAT(
+      worldNode.findNodesWithLinkId("brush"),
+      Catch::Matchers::UnorderedEquals(std::vector<Node*>{brushNode1, brushNode2}));
+  }
+
+  SECTION("Removing a node removes it and its descendants from the index")
+  {
+    worldNode.defaultLayer()->removeChild(groupNode);
+
+    CHECK(worldNode.findNodesWithLinkId("group").empty());
+    CHECK(worldNode.findNodesWithLinkId("entity").empty());
+    CHECK(worldNode.findNodesWithLinkId("brush").empty());
+
+    // the removed node is no longer connected to the index
+    setLinkId(*brushNode1, "other");
+    CHECK(worldNode.findNodesWithLinkId("other").empty());
+
+    delete groupNode;
+  }
+}
+
 } // namespace TrenchBroom::Model
@@ -0,0 +1,214 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/WorldNode.h"
+#include "NotifierConnection.h"
+#include "Renderer/EntityLinkRenderer.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentTest.h"
+#include "View/Selection.h"
+
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+namespace
+{
+
+using Link = std::tuple<vm::vec3f, vm::vec3f, Color>;
+
+std::vector<Link> toLinks(const std::vector<LinkRenderer::LineVertex>& vertices)
+{
+  REQUIRE(vertices.size() % 2u == 0u);
+
+  auto links = std::vector<Link>{};
+  for (size_t i = 0; i < vertices.size(); i += 2u)
+  {
+    links.emplace_back(
+      getVertexComponent<0>(vertices[i]),
+      getVertexComponent<0>(vertices[i + 1u]),
+      getVertexComponent<1>(vertices[i]));
+  }
+
+  std::sort(links.begin(), links.end());
+  return links;
+}
+
+Link makeLink(
+  const Model::EntityNodeBase& source,
+  const Model::EntityNodeBase& target,
+  const Color& color)
+{
+  return {
+    vm::vec3f{source.linkSourceAnchor()}, vm::vec3f{target.linkTargetAnchor()}, color};
+}
+
+} // namespace
+
+TEST_CASE_METHOD(View::MapDocumentTest, "EntityLinkCache.getLinks")
+{
+  const auto defaultColor = Color{0.0f, 1.0f, 0.0f, 1.0f};
+  const auto selectedColor = Color{1.0f, 0.0f, 0.0f, 1.0f};
+
+  auto cache = EntityLinkCache{};
+
+  // update the cache like MapRenderer does
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection += document->nodesWereAddedNotifier.connect(
+    [&](const auto& nodes) { cache.addNodes(nodes); });
+  notifierConnection += document->nodesWereRemovedNotifier.connect(
+    [&](const auto& nodes) { cache.removeNodes(nodes); });
+  notifierConnection += document->nodesDidChangeNotifier.connect(
+    [&](const auto& nodes) { cache.invalidateNodes(nodes); });
+  notifierConnection +=
+    document->selectionDidChangeNotifier.connect([&](const View::Selection& selection) {
+      cache.invalidateNodes(selection.deselectedNodes());
+      cache.invalidateNodes(selection.selectedNodes());
+    });
+
+  const auto getLinks = [&]() {
+    return toLinks(cache.getLinks(
+      *document->world(), document->editorContext(), defaultColor, selectedColor));
+  };
+
+  // returns the links of the incrementally updated cache after checking that they are
+  // the same as the links after rebuilding the cache
+  const auto getCheckedLinks = [&]() {
+    const auto links = getLinks();
+
+    cache.invalidate();
+    CHECK(getLinks() == links);
+
+    return links;
+  };
+
+  auto* sourceNode = new Model::EntityNode{Model::Entity{{
+    {Model::EntityPropertyKeys::Origin, "0 0 0"},
+    {Model::EntityPropertyKeys::Target, "target1"},
+  }}};
+  auto* targetNode1 = new Model::EntityNode{Model::Entity{{
+    {Model::EntityPropertyKeys::Origin, "64 0 0"},
+    {Model::EntityPropertyKeys::Targetname, "target1"},
+  }}};
+  auto* targetNode2 = new Model::EntityNode{Model::Entity{{
+    {Model::EntityPropertyKeys::Origin, "0 64 0"},
+    {Model::EntityPropertyKeys::Targetname, "target2"},
+  }}};
+
+  document->addNodes(
+    {{document->parentForNodes(), {sourceNode, targetNode1, targetNode2}}});
+
+  REQUIRE(
+    getCheckedLinks()
+    == std::vector<Link>{makeLink(*sourceNode, *targetNode1, defaultColor)});
+
+  SECTION("Retargeting an entity")
+  {
+    document->selectNodes({sourceNode});
+    document->setProperty(Model::EntityPropertyKeys::Target, "target2");
+    document->deselectAll();
+
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode2, defaultColor)});
+  }
+
+  SECTION("Renaming a targetname")
+  {
+    document->selectNodes({targetNode1});
+    document->setProperty(Model::EntityPropertyKeys::Targetname, "target2");
+    document->deselectAll();
+
+    CHECK(getCheckedLinks().empty());
+
+    document->selectNodes({targetNode2});
+    document->setProperty(Model::EntityPropertyKeys::Targetname, "target1");
+    document->deselectAll();
+
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode2, defaultColor)});
+  }
+
+  SECTION("Adding a killtarget")
+  {
+    document->selectNodes({sourceNode});
+    document->setProperty(Model::EntityPropertyKeys::Killtarget, "target2");
+    document->deselectAll();
+
+    auto expectedLinks = std::vector<Link>{
+      makeLink(*sourceNode, *targetNode1, defaultColor),
+      makeLink(*sourceNode, *targetNode2, defaultColor),
+    };
+    std::sort(expectedLinks.begin(), expectedLinks.end());
+
+    CHECK(getCheckedLinks() == expectedLinks);
+  }
+
+  SECTION("Removing a target")
+  {
+    document->removeNodes({targetNode1});
+    CHECK(getCheckedLinks().empty());
+
+    document->undoCommand();
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode1, defaultColor)});
+  }
+
+  SECTION("Removing a source")
+  {
+    document->removeNodes({sourceNode});
+    CHECK(getCheckedLinks().empty());
+  }
+
+  SECTION("Selecting a target changes the link color")
+  {
+    document->selectNodes({targetNode1});
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode1, selectedColor)});
+
+    document->deselectAll();
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode1, defaultColor)});
+  }
+
+  SECTION("Selecting a source changes the link color")
+  {
+    document->selectNodes({sourceNode});
+    CHECK(
+      getCheckedLinks()
+      == std::vector<Link>{makeLink(*sourceNode, *targetNode1, selectedColor)});
+  }
+}
+
+} // namespace TrenchBroom::Renderer
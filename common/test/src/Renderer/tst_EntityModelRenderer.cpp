@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelDataResource.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Renderer/EntityModelRenderer.h"
+#include "Renderer/MaterialIndexRangeRenderer.h"
+
+#include "vm/mat.h"
+#include "vm/mat_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE("buildEntityModelInstances")
+{
+  using namespace Assets;
+
+  auto orientedModel = EntityModel{
+    "oriented",
+    createEntityModelDataResource(
+      EntityModelData{PitchType::Normal, Orientation::Oriented})};
+  auto uprightModel = EntityModel{
+    "upright",
+    createEntityModelDataResource(
+      EntityModelData{PitchType::Normal, Orientation::ViewPlaneParallelUpright})};
+
+  auto orientedRenderer = MaterialIndexRangeRenderer{};
+  auto uprightRenderer = MaterialIndexRangeRenderer{};
+
+  auto entityNode1 = Model::EntityNode{Model::Entity{{{"origin", "8 0 0"}}}};
+  auto entityNode2 = Model::EntityNode{Model::Entity{{{"origin", "0 16 0"}}}};
+  auto entityNode3 = Model::EntityNode{Model::Entity{{{"origin", "0 0 32"}}}};
+  auto entityNode4 = Model::EntityNode{Model::Entity{}};
+
+  entityNode1.setModel(&orientedModel);
+  entityNode2.setModel(&uprightModel);
+  entityNode3.setModel(&orientedModel);
+
+  const auto entities = std::unordered_map<const Model::EntityNode*, MaterialRenderer*>{
+    {&entityNode1, &orientedRenderer},
+    {&entityNode2, &uprightRenderer},
+    {&entityNode3, &orientedRenderer},
+    // has no model, so it is omitted
+    {&entityNode4, &orientedRenderer},
+  };
+
+  const auto instances = buildEntityModelInstances(entities);
+  REQUIRE(instances.size() == 2u);
+
+  const auto findInstances = [&](const MaterialRenderer* renderer) {
+    const auto it = std::find_if(
+      instances.begin(), instances.end(), [&](const auto& i) {
+        return i.renderer == renderer;
+      });
+    REQUIRE(it != instances.end());
+    return *it;
+  };
+
+  const auto orientedInstances = findInstances(&orientedRenderer);
+  CHECK(orientedInstances.orientation == Orientation::Oriented);
+  CHECK_THAT(
+    orientedInstances.entityNodes,
+    Catch::Matchers::UnorderedEquals(
+      std::vector<const Model::EntityNode*>{&entityNode1, &entityNode3}));
+
+  const auto uprightInstances = findInstances(&uprightRenderer);
+  CHECK(uprightInstances.orientation == Orientation::ViewPlaneParallelUpright);
+  CHECK(
+    uprightInstances.entityNodes
+    == std::vector<const Model::EntityNode*>{&entityNode2});
+
+  for (const auto& i : instances)
+  {
+    REQUIRE(i.transformations.size() == i.entityNodes.size());
+    for (size_t j = 0; j < i.entityNodes.size(); ++j)
+    {
+      CHECK(
+        i.transformations[j]
+        == vm::mat4x4f{i.entityNodes[j]->entity().modelTransformation(std::nullopt)});
+    }
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BrushNode.h"
+#include "Model/GroupNode.h"
+#include "Model/WorldNode.h"
+#include "NotifierConnection.h"
+#include "Renderer/GroupLinkRenderer.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentTest.h"
+#include "View/Selection.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::Renderer
+{
+
+TEST_CASE_METHOD(View::MapDocumentTest, "GroupLinkCache.getLinkedGroups")
+{
+  auto cache = GroupLinkCache{};
+
+  // update the cache like MapRenderer does
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection +=
+    document->nodesWereAddedNotifier.connect([&](const auto&) { cache.invalidate(); });
+  notifierConnection +=
+    document->nodesWereRemovedNotifier.connect([&](const auto&) { cache.invalidate(); });
+  notifierConnection += document->nodesDidChangeNotifier.connect(
+    [&](const auto& nodes) { cache.invalidateNodes(nodes); });
+  notifierConnection +=
+    document->selectionDidChangeNotifier.connect([&](const View::Selection& selection) {
+      cache.invalidateNodes(selection.selectedNodes());
+    });
+
+  // returns the linked groups of the incrementally updated cache after checking that
+  // they are the same as the linked groups after rebuilding the cache
+  const auto getCheckedLinkedGroups = [&](const Model::GroupNode& groupNode) {
+    const auto linkedGroupNodes = cache.getLinkedGroups(*document->world(), groupNode);
+
+    cache.invalidate();
+    CHECK(cache.getLinkedGroups(*document->world(), groupNode) == linkedGroupNodes);
+
+    return linkedGroupNodes;
+  };
+
+  auto* brushNode1 = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode1}}});
+  document->selectNodes({brushNode1});
+  auto* groupNode1 = document->groupSelection("group1");
+  auto* groupNode2 = document->createLinkedDuplicate();
+  document->deselectAll();
+
+  auto* brushNode3 = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode3}}});
+  document->selectNodes({brushNode3});
+  auto* groupNode3 = document->groupSelection("group3");
+  document->deselectAll();
+
+  REQUIRE_THAT(
+    getCheckedLinkedGroups(*groupNode1),
+    Catch::Matchers::UnorderedEquals(
+      std::vector<Model::GroupNode*>{groupNode1, groupNode2}));
+
+  SECTION("Linking a group")
+  {
+    document->linkGroups({groupNode1, groupNode3});
+
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode1),
+      Catch::Matchers::UnorderedEquals(
+        std::vector<Model::GroupNode*>{groupNode1, groupNode2, groupNode3}));
+  }
+
+  SECTION("Linking groups and selecting one of them")
+  {
+    document->selectNodes({groupNode1, groupNode3});
+    document->linkGroups({groupNode1, groupNode3});
+    document->deselectAll();
+    document->selectNodes({groupNode1});
+
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode1),
+      Catch::Matchers::UnorderedEquals(
+        std::vector<Model::GroupNode*>{groupNode1, groupNode2, groupNode3}));
+  }
+
+  SECTION("Unlinking a group")
+  {
+    document->unlinkGroups({groupNode2});
+
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode1),
+      Catch::Matchers::UnorderedEquals(std::vector<Model::GroupNode*>{groupNode1}));
+
+    document->undoCommand();
+
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode1),
+      Catch::Matchers::UnorderedEquals(
+        std::vector<Model::GroupNode*>{groupNode1, groupNode2}));
+  }
+
+  SECTION("Removing a linked group")
+  {
+    document->removeNodes({groupNode2});
+
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode1),
+      Catch::Matchers::UnorderedEquals(std::vector<Model::GroupNode*>{groupNode1}));
+  }
+
+  SECTION("Changing the group")
+  {
+    CHECK_THAT(
+      getCheckedLinkedGroups(*groupNode3),
+      Catch::Matchers::UnorderedEquals(std::vector<Model::GroupNode*>{groupNode3}));
+  }
+}
+
+} // namespace TrenchBroom::Renderer
@@ -19,22 +19,33 @@
 
 #include <QString>
 
+#include "Assets/Material.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureResource.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/NodeWriter.h"
 #include "IO/TestEnvironment.h"
 #include "Logger.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/EntityNode.h"
 #include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
 #include "TestUtils.h"
 #include "View/Autosaver.h"
 #include "View/MapDocumentTest.h"
 
 #include "kdl/vector_utils.h"
 
+#include "vm/vec.h"
+
 #include <fmt/format.h>
 
 #include <chrono>
 #include <filesystem>
+#include <sstream>
+#include <string>
 #include <thread>
 
 #include "Catch2.h"
@@ -62,6 +73,22 @@ IO::TestEnvironment makeTestEnvironment()
                              }};
 }
 
+class Quake2MapDocumentTest : public MapDocumentTest
+{
+public:
+  Quake2MapDocumentTest()
+    : MapDocumentTest{Model::MapFormat::Quake2}
+  {
+  }
+};
+
+std::string writeMap(const Model::WorldNode& world)
+{
+  auto str = std::stringstream{};
+  IO::NodeWriter{world, str}.writeMap();
+  return str.str();
+}
+
 } // namespace
 
 TEST_CASE("AutosaverTest.makeBackupPathMatcher")
@@ -98,6 +125,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveUntilSaveInter
 
   autosaver.triggerAutosave(logger);
 
+  autosaver.waitForAutosave(logger);
+
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
 }
@@ -114,6 +143,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveOfUnchangedMap
 
   auto autosaver = Autosaver{document, 0s};
   autosaver.triggerAutosave(logger);
+  autosaver.waitForAutosave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -138,6 +168,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAfterSaveInterv
 
   autosaver.triggerAutosave(logger);
 
+  autosaver.waitForAutosave(logger);
+
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
 }
@@ -161,6 +193,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
 
   autosaver.triggerAutosave(logger);
 
+  autosaver.waitForAutosave(logger);
+
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
 
@@ -169,15 +203,123 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+
+  autosaver.waitForAutosave(logger);
   CHECK_FALSE(env.fileExists("autosave/test.2.map"));
 
   // modify the map
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+
+  autosaver.waitForAutosave(logger);
   CHECK(env.fileExists("autosave/test.2.map"));
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverWritesSnapshot")
+{
+  using namespace std::chrono_literals;
+
+  auto env = IO::TestEnvironment{};
+  auto logger = NullLogger{};
+
+  document->saveDocumentAs(env.dir() / "test.map");
+  assert(env.fileExists("test.map"));
+
+  auto autosaver = Autosaver{document, 0s};
+
+  // modify the map so that writing it takes a while
+  auto nodes = std::vector<Model::Node*>{};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    nodes.push_back(createBrushNode("some_material"));
+  }
+  document->addNodes({{document->currentLayer(), nodes}});
+
+  // this is what the backup should contain
+  document->saveDocumentTo(env.dir() / "expected.map");
+
+  autosaver.triggerAutosave(logger);
+
+  // keep modifying the map while the backup is being written
+  for (size_t i = 0; i < 10; ++i)
+  {
+    document->selectAllNodes();
+    document->translateObjects(vm::vec3{16, 0, 0});
+    document->deleteObjects();
+    document->addNodes({{document->currentLayer(), {new Model::EntityNode{{}}}}});
+  }
+
+  autosaver.waitForAutosave(logger);
+
+  CHECK(env.fileExists("autosave/test.1.map"));
+  CHECK_FALSE(env.fileExists("autosave/test.1.map.tmp"));
+  CHECK(env.loadFile("autosave/test.1.map") == env.loadFile("expected.map"));
+}
+
+TEST_CASE_METHOD(Quake2MapDocumentTest, "Quake2MapDocumentTest.makeWorldSnapshot")
+{
+  auto textureResource = Assets::createTextureResource(Assets::Texture{
+    1,
+    1,
+    Color{},
+    GL_RGBA,
+    Assets::TextureMask::Off,
+    Assets::Q2EmbeddedDefaults{4, 8, 16},
+    Assets::TextureBuffer{4}});
+  auto material = Assets::Material{"some_material", std::move(textureResource)};
+
+  // the surface contents and flags of the faces are taken from the material
+  auto* brushNode = createBrushNode("some_material", [](auto& brush) {
+    for (auto& face : brush.faces())
+    {
+      auto attributes = face.attributes();
+      attributes.setSurfaceValue(2.0f);
+      face.setAttributes(attributes);
+    }
+  });
+  document->addNodes({{document->currentLayer(), {brushNode}}});
+
+  for (size_t i = 0; i < brushNode->brush().faceCount(); ++i)
+  {
+    brushNode->setFaceMaterial(i, &material);
+  }
+  REQUIRE(brushNode->brush().face(0).resolvedSurfaceContents() == 8);
+
+  const auto snapshot = document->makeWorldSnapshot();
+  CHECK(writeMap(*snapshot) == writeMap(*document->world()));
+
+  for (size_t i = 0; i < brushNode->brush().faceCount(); ++i)
+  {
+    brushNode->setFaceMaterial(i, nullptr);
+  }
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.makeWorldSnapshot")
+{
+  auto* brushNode = createBrushNode("some_material");
+  document->addNodes({{document->currentLayer(), {brushNode}}});
+
+  const auto snapshot = document->makeWorldSnapshot();
+  const auto snapshotBrushNodes = snapshot->defaultLayer()->children();
+  REQUIRE(snapshotBrushNodes.size() == 1u);
+
+  const auto* snapshotBrushNode =
+    dynamic_cast<const Model::BrushNode*>(snapshotBrushNodes.front());
+  REQUIRE(snapshotBrushNode != nullptr);
+
+  // the snapshot is a complete brush that shares its geometry with the document
+  CHECK(snapshotBrushNode->logicalBounds() == brushNode->logicalBounds());
+  CHECK(snapshotBrushNode->brush().sharesGeometryWith(brushNode->brush()));
+  CHECK(snapshotBrushNode->cachedSerialization() != nullptr);
+  CHECK(snapshotBrushNode->cachedSerialization() == brushNode->cachedSerialization());
+
+  for (const auto& face : snapshotBrushNode->brush().faces())
+  {
+    CHECK(face.material() == nullptr);
+  }
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 {
   using namespace std::chrono_literals;
@@ -220,6 +362,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     const auto allPaths = kdl::vec_push_back(initialPaths, "autosave/test.3.map");
 
@@ -244,6 +387,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     CHECK(env.directoryContents("autosave") == allPaths);
     CHECK(
@@ -305,6 +449,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.waitForAutosave(logger);
 
     const auto allPaths = std::vector<std::filesystem::path>{
       "autosave/test.1.map",
@@ -353,6 +498,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesWhenCrashFilesP
 
   autosaver.triggerAutosave(logger);
 
+  autosaver.waitForAutosave(logger);
+
   CHECK(env.fileExists("autosave/test.2.map"));
 }
 
@@ -0,0 +1,224 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/CellLayout.h"
+
+#include "vm/vec.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+namespace
+{
+
+CellLayout makeLayout()
+{
+  auto layout = CellLayout{};
+  layout.setWidth(90.0f);
+  layout.setCellWidth(10.0f, 40.0f);
+  layout.setCellHeight(10.0f, 40.0f);
+  layout.setRowMargin(5.0f);
+  layout.setGroupMargin(5.0f);
+  return layout;
+}
+
+std::vector<std::vector<int>> getItems(CellLayout& layout)
+{
+  auto result = std::vector<std::vector<int>>{};
+  for (const auto& group : layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      auto& rowItems = result.emplace_back();
+      for (const auto& cell : row.cells())
+      {
+        rowItems.push_back(cell.itemAs<int>());
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<std::string> getTitles(const CellLayout::GroupRange& groups)
+{
+  auto result = std::vector<std::string>{};
+  for (const auto& group : groups)
+  {
+    result.push_back(group.title());
+  }
+  return result;
+}
+
+std::vector<int> getItems(const LayoutGroup::RowRange& rows)
+{
+  auto result = std::vector<int>{};
+  for (const auto& row : rows)
+  {
+    for (const auto& cell : row.cells())
+    {
+      result.push_back(cell.itemAs<int>());
+    }
+  }
+  return result;
+}
+
+CellLayout makeGroupedLayout()
+{
+  // 3 groups of 3 rows each, every row contains 4 cells of 20x20
+  auto layout = makeLayout();
+  for (int i = 0; i < 3; ++i)
+  {
+    layout.addGroup("group" + std::to_string(i), 10.0f);
+    for (int j = 0; j < 12; ++j)
+    {
+      const auto item = i * 12 + j;
+      layout.addItem(item, std::to_string(item), 20.0f, 20.0f, 0.0f, 0.0f);
+    }
+  }
+  return layout;
+}
+
+} // namespace
+
+TEST_CASE("CellLayout.groupsIntersectingY")
+{
+  auto layout = makeGroupedLayout();
+  const auto& groups = layout.groups();
+  REQUIRE(groups.size() == 3u);
+
+  const auto& group1Bounds = groups[1].bounds();
+
+  CHECK(getTitles(layout.groupsIntersectingY(-20.0f, 10.0f)).empty());
+  CHECK(
+    getTitles(layout.groupsIntersectingY(0.0f, 1.0f))
+    == std::vector<std::string>{"group0"});
+  CHECK(
+    getTitles(layout.groupsIntersectingY(group1Bounds.top(), 1.0f))
+    == std::vector<std::string>{"group1"});
+  CHECK(
+    getTitles(layout.groupsIntersectingY(group1Bounds.top() - 10.0f, 20.0f))
+    == std::vector<std::string>{"group0", "group1"});
+  CHECK(
+    getTitles(layout.groupsIntersectingY(0.0f, layout.height()))
+    == std::vector<std::string>{"group0", "group1", "group2"});
+  CHECK(getTitles(layout.groupsIntersectingY(layout.height() + 1.0f, 10.0f)).empty());
+}
+
+TEST_CASE("LayoutGroup.rowsIntersectingY")
+{
+  auto layout = makeGroupedLayout();
+  const auto& group = layout.groups()[1];
+  const auto& rows = group.rows();
+  REQUIRE(rows.size() == 3u);
+
+  CHECK(getItems(group.rowsIntersectingY(group.titleBounds().top(), 1.0f)).empty());
+  CHECK(
+    getItems(group.rowsIntersectingY(rows[0].bounds().top(), 1.0f))
+    == std::vector<int>{12, 13, 14, 15});
+  CHECK(
+    getItems(group.rowsIntersectingY(rows[1].bounds().top() + 1.0f, 1.0f))
+    == std::vector<int>{16, 17, 18, 19});
+  CHECK(
+    getItems(group.rowsIntersectingY(
+      rows[1].bounds().top(), rows[2].bounds().top() - rows[1].bounds().top()))
+    == std::vector<int>{16, 17, 18, 19, 20, 21, 22, 23});
+}
+
+TEST_CASE("CellLayout.cellAt")
+{
+  auto layout = makeGroupedLayout();
+
+  for (const auto& group : layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      for (const auto& cell : row.cells())
+      {
+        const auto& bounds = cell.cellBounds();
+        const auto x = bounds.left() + bounds.width / 2.0f;
+        const auto y = bounds.top() + bounds.height / 2.0f;
+        CHECK(layout.cellAt(x, y) == &cell);
+      }
+    }
+  }
+
+  const auto& group = layout.groups()[1];
+  const auto& titleBounds = group.titleBounds();
+  CHECK(layout.cellAt(titleBounds.left() + 1.0f, titleBounds.top() + 1.0f) == nullptr);
+  CHECK(layout.cellAt(89.0f, group.rows().front().bounds().top() + 1.0f) == nullptr);
+  CHECK(layout.cellAt(1.0f, layout.height() + 1.0f) == nullptr);
+}
+
+TEST_CASE("LayoutGroup.indexOfRowAt")
+{
+  auto layout = makeGroupedLayout();
+  const auto& group = layout.groups()[1];
+  const auto& rows = group.rows();
+
+  CHECK(group.indexOfRowAt(group.titleBounds().top()) == 0u);
+  CHECK(group.indexOfRowAt(rows[0].bounds().top()) == 0u);
+  CHECK(group.indexOfRowAt(rows[1].bounds().top()) == 1u);
+  CHECK(group.indexOfRowAt(rows[2].bounds().bottom() - 1.0f) == 2u);
+  CHECK(group.indexOfRowAt(rows[2].bounds().bottom()) == 3u);
+}
+
+TEST_CASE("CellLayout.updateItemSizes")
+{
+  auto layout = makeLayout();
+  for (int i = 0; i < 4; ++i)
+  {
+    layout.addItem(i, std::to_string(i), 20.0f, 20.0f, 0.0f, 0.0f);
+  }
+
+  REQUIRE(getItems(layout) == std::vector<std::vector<int>>{{0, 1, 2, 3}});
+  const auto height = layout.height();
+
+  SECTION("Layout is unchanged if no size changes")
+  {
+    CHECK_FALSE(layout.updateItemSizes(
+      [](const auto&) -> std::optional<vm::vec2f> { return std::nullopt; }));
+    CHECK_FALSE(layout.updateItemSizes(
+      [](const auto&) -> std::optional<vm::vec2f> { return vm::vec2f{20, 20}; }));
+    CHECK(getItems(layout) == std::vector<std::vector<int>>{{0, 1, 2, 3}});
+    CHECK(layout.height() == height);
+  }
+
+  SECTION("Cells are laid out again if an item size changes")
+  {
+    CHECK(layout.updateItemSizes([](const auto& cell) -> std::optional<vm::vec2f> {
+      return cell.template itemAs<int>() == 1 ? std::optional{vm::vec2f{40, 40}}
+                                              : std::nullopt;
+    }));
+
+    CHECK(getItems(layout) == std::vector<std::vector<int>>{{0, 1, 2}, {3}});
+    CHECK(layout.height() > height);
+
+    const auto& cell = layout.groups().front().rows().front().cells()[1];
+    CHECK(cell.title() == "1");
+    CHECK(cell.itemWidth() == 40.0f);
+    CHECK(cell.itemHeight() == 40.0f);
+  }
+}
+
+} // namespace TrenchBroom::View
@@ -29,6 +29,11 @@
 #include "View/PasteType.h"
 #include "View/Tool.h"
 
+#include "vm/bbox.h"
+#include "vm/bbox_io.h" // IWYU pragma: keep
+
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom::View
@@ -89,6 +94,66 @@ TEST_CASE_METHOD(ValveMapDocumentTest, "ClipToolTest")
     CHECK(clippedBrushNode2->linkId() != originalLinkId);
     CHECK(clippedBrushNode1->linkId() != clippedBrushNode2->linkId());
   }
+
+  SECTION("Brushes that are not intersected by the clip plane are kept")
+  {
+    const auto data = R"(// entity 0
+{
+"mapversion" "220"
+"wad" ""
+"classname" "worldspawn"
+// brush 0
+{
+( -64 -64 -16 ) ( -64 -63 -16 ) ( -64 -64 -15 ) __TB_empty [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) __TB_empty [ -1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) __TB_empty [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+}
+// brush 1
+{
+( 128 -64 -16 ) ( 128 -63 -16 ) ( 128 -64 -15 ) __TB_empty [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 128 -64 -16 ) ( 128 -64 -15 ) ( 129 -64 -16 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 128 -64 -16 ) ( 129 -64 -16 ) ( 128 -63 -16 ) __TB_empty [ -1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 192 64 16 ) ( 192 65 16 ) ( 193 64 16 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 192 64 16 ) ( 193 64 16 ) ( 192 64 17 ) __TB_empty [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 192 64 16 ) ( 192 64 17 ) ( 192 65 16 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+}
+}
+)";
+    REQUIRE(document->paste(data) == PasteType::Node);
+
+    const auto* defaultLayer = document->world()->defaultLayer();
+    REQUIRE(defaultLayer->childCount() == 2);
+
+    auto tool = ClipTool{document};
+    REQUIRE(tool.activate());
+
+    tool.addPoint(vm::vec3{0, 16, 16}, {});
+    tool.addPoint(vm::vec3{0, -16, 16}, {});
+    tool.addPoint(vm::vec3{0, -64, 0}, {});
+
+    REQUIRE(tool.canClip());
+    tool.toggleSide();
+    tool.performClip();
+
+    auto bounds = std::vector<vm::bbox3>{};
+    for (const auto* node : defaultLayer->children())
+    {
+      const auto* brushNode = dynamic_cast<const Model::BrushNode*>(node);
+      REQUIRE(brushNode);
+      bounds.push_back(brushNode->logicalBounds());
+    }
+
+    CHECK_THAT(
+      bounds,
+      Catch::Matchers::UnorderedEquals(std::vector<vm::bbox3>{
+        {{-64, -64, -16}, {0, 64, 16}},
+        {{0, -64, -16}, {64, 64, 16}},
+        {{128, -64, -16}, {192, 64, 16}},
+      }));
+  }
 }
 
 } // namespace TrenchBroom::View
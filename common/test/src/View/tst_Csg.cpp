@@ -29,8 +29,13 @@
 #include "TestUtils.h"
 
 #include "kdl/result.h"
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/bbox_io.h"
 
 #include <filesystem>
+#include <vector>
 
 #include "CatchUtils/Matchers.h"
 
@@ -240,6 +245,55 @@ TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgSubtractMultipleBrushes")
   CHECK(remainderNode2->logicalBounds() == expectedBBox2);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgSubtractMultipleMinuends")
+{
+  const auto builder =
+    Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+  document->addNodes({{document->parentForNodes(), {entityNode}}});
+
+  auto* minuendNode1 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}}, "material")
+    | kdl::value()};
+  auto* minuendNode2 = new Model::BrushNode{
+    builder.createCuboid(
+      vm::bbox3{vm::vec3{256, 0, 0}, vm::vec3{320, 64, 64}}, "material")
+    | kdl::value()};
+  auto* subtrahendNode1 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{32, 64, 64}}, "material")
+    | kdl::value()};
+  auto* subtrahendNode2 = new Model::BrushNode{
+    builder.createCuboid(
+      vm::bbox3{vm::vec3{288, 0, 0}, vm::vec3{320, 64, 64}}, "material")
+    | kdl::value()};
+  auto* subtrahendNode3 = new Model::BrushNode{
+    builder.createCuboid(
+      vm::bbox3{vm::vec3{1024, 1024, 1024}, vm::vec3{1088, 1088, 1088}}, "material")
+    | kdl::value()};
+
+  document->addNodes(
+    {{entityNode,
+      {minuendNode1,
+       minuendNode2,
+       subtrahendNode1,
+       subtrahendNode2,
+       subtrahendNode3}}});
+
+  // every minuend must only be affected by the subtrahend that intersects it
+  document->selectNodes({subtrahendNode1, subtrahendNode2, subtrahendNode3});
+  CHECK(document->csgSubtract());
+
+  const auto remainderBounds = kdl::vec_transform(
+    entityNode->children(), [](const auto* node) { return node->logicalBounds(); });
+  CHECK_THAT(
+    remainderBounds,
+    Catch::Matchers::UnorderedEquals(std::vector<vm::bbox3>{
+      {{32, 0, 0}, {64, 64, 64}},
+      {{256, 0, 0}, {288, 64, 64}},
+    }));
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgSubtractAndUndoRestoresSelection")
 {
   const auto builder =
@@ -33,6 +33,7 @@
 #include "View/SelectionTool.h"
 
 #include "kdl/result.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
 #include "vm/ray.h"
@@ -389,4 +390,52 @@ TEST_CASE_METHOD(MapDocumentTest, "PickingTest.pickBrushEntity")
   CHECK(hits.front().distance() == vm::approx{32.0});
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "PickingTest.pickQuery")
+{
+  using namespace Model::HitFilters;
+
+  // delete default brush
+  document->selectAllNodes();
+  document->deleteObjects();
+
+  const auto builder =
+    Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+
+  auto* brushNode1 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {64, 64, 64}}, "material") | kdl::value()};
+  auto* brushNode2 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{128, 0, 0}, {192, 64, 64}}, "material")
+    | kdl::value()};
+  auto* brushNode3 = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{1024, 0, 0}, {1088, 64, 64}}, "material")
+    | kdl::value()};
+  document->addNodes(
+    {{document->parentForNodes(), {brushNode1, brushNode2, brushNode3}}});
+
+  const auto pickRay = vm::ray3{vm::vec3{-32, 32, 32}, vm::vec3::pos_x()};
+  const auto pick = [&](Model::PickResult pickResult) {
+    document->pick(pickRay, pickResult);
+    return kdl::vec_transform(
+      pickResult.all(), [](const auto& hit) { return hit.distance(); });
+  };
+
+  CHECK_THAT(
+    pick(Model::PickResult::byDistance()),
+    Catch::Matchers::Approx(std::vector<FloatType>{32.0, 160.0, 1056.0}));
+
+  CHECK_THAT(
+    pick(Model::PickResult::query(type(Model::BrushNode::BrushHitType))),
+    Catch::Matchers::Approx(std::vector<FloatType>{32.0}));
+  CHECK_THAT(
+    pick(Model::PickResult::query(type(Model::BrushNode::BrushHitType), 2)),
+    Catch::Matchers::Approx(std::vector<FloatType>{32.0, 160.0}));
+  CHECK(pick(Model::PickResult::query(type(Model::EntityNode::EntityHitType))).empty());
+
+  document->selectNodes({brushNode3});
+
+  CHECK_THAT(
+    pick(Model::PickResult::query(selected())),
+    Catch::Matchers::Approx(std::vector<FloatType>{1056.0}));
+}
+
 } // namespace TrenchBroom::View
@@ -20,10 +20,14 @@
 #include "MapDocumentTest.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
+#include "NotifierConnection.h"
 #include "TestUtils.h"
 
 #include "vm/mat_ext.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom::View
@@ -86,4 +90,73 @@ TEST_CASE_METHOD(MapDocumentTest, "Transaction")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "Transaction coalesces node change notifications")
+{
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+  document->addNodes({{document->parentForNodes(), {entityNode}}});
+  document->selectNodes({entityNode});
+
+  auto willChange = std::vector<std::vector<Model::Node*>>{};
+  auto didChange = std::vector<std::vector<Model::Node*>>{};
+
+  auto connection = NotifierConnection{};
+  connection += document->nodesWillChangeNotifier.connect(
+    [&](const auto& nodes) { willChange.push_back(nodes); });
+  connection += document->nodesDidChangeNotifier.connect(
+    [&](const auto& nodes) { didChange.push_back(nodes); });
+
+  const auto countNotifications =
+    [&](const std::vector<std::vector<Model::Node*>>& notifications) {
+      return std::count_if(
+        notifications.begin(), notifications.end(), [&](const auto& nodes) {
+          return std::find(nodes.begin(), nodes.end(), entityNode) != nodes.end();
+        });
+    };
+
+  const auto translate = [&]() {
+    document->transformObjects("translate", vm::translation_matrix(vm::vec3{1, 0, 0}));
+  };
+
+  SECTION("Transactions notify observers immediately by default")
+  {
+    auto transaction = Transaction{document};
+    translate();
+    translate();
+
+    CHECK(countNotifications(willChange) == 2);
+    CHECK(countNotifications(didChange) == 2);
+
+    transaction.commit();
+
+    CHECK(countNotifications(didChange) == 2);
+  }
+
+  SECTION("Coalescing transactions notify observers once")
+  {
+    auto transaction = Transaction{document, "", NodeChangeNotifications::Coalesced};
+    translate();
+    translate();
+
+    CHECK(countNotifications(willChange) == 1);
+    CHECK(didChange.empty());
+
+    SECTION("Changed nodes are notified once when the transaction is committed")
+    {
+      transaction.commit();
+
+      CHECK(countNotifications(willChange) == 1);
+      CHECK(didChange.size() == 1u);
+      CHECK(countNotifications(didChange) == 1);
+    }
+
+    SECTION("Removed nodes are not notified")
+    {
+      document->deleteObjects();
+      transaction.commit();
+
+      CHECK(countNotifications(didChange) == 0);
+    }
+  }
+}
+
 } // namespace TrenchBroom::View
@@ -124,6 +124,21 @@ TEST_CASE_METHOD(UpdateLinkedGroupsHelperTest, "ownership")
     CHECK_FALSE(deleted);
   }
 
+  SECTION("Helper takes ownership of replaced child nodes if the structure changed")
+  {
+    linkedNode->addChild(new Model::EntityNode{Model::Entity{}});
+
+    {
+      auto helper = UpdateLinkedGroupsHelper{{linkedNode}};
+      REQUIRE(helper
+                .applyLinkedGroupUpdates(
+                  *static_cast<MapDocumentCommandFacade*>(document.get()))
+                .is_success());
+    }
+    CHECK(deleted);
+    CHECK(groupNode->childCount() == 2u);
+  }
+
   // Need to clear the document and delete all nodes, otherwise the TestNode destructor
   // will access the deleted variable when its no longer valid.
   document.reset();
@@ -196,15 +211,15 @@ TEST_CASE_METHOD(UpdateLinkedGroupsHelperTest, "applyLinkedGroupUpdates")
     +-groupNode
       +-brushNode (translated 0 16 0)
     +-linkedGroupNode (translated 32 0 0)
-      +-newLinkedBrushNode (translated 32 16 0)
+      +-linkedBrushNode (translated 32 16 0)
   */
 
-  // changes were propagated
+  // changes were propagated by swapping the contents of the linked brush node
   REQUIRE(linkedGroupNode->childCount() == 1u);
-  CHECK(linkedBrushNode->parent() == nullptr);
-  auto* newLinkedBrushNode = linkedGroupNode->children().front();
+  CHECK(linkedGroupNode->children().front() == linkedBrushNode);
+  CHECK(linkedBrushNode->parent() == linkedGroupNode);
   CHECK(
-    newLinkedBrushNode->physicalBounds()
+    linkedBrushNode->physicalBounds()
     == originalBrushBounds.translate(vm::vec3(32.0, 16.0, 0.0)));
 
   // undo change propagation
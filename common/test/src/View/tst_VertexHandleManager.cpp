@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Error.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Hit.h"
+#include "Model/MapFormat.h"
+#include "Model/PickResult.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/segment.h"
+#include "vm/vec.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+
+TEST_CASE("VertexHandleManager.pick")
+{
+  auto camera = Renderer::PerspectiveCamera{};
+  camera.moveTo(vm::vec3f{-256, 0, 0});
+  camera.setDirection(vm::vec3f::pos_x(), vm::vec3f::pos_z());
+
+  auto manager = VertexHandleManager{};
+  manager.add(vm::vec3{0, 0, 0});
+  manager.add(vm::vec3{0, 64, 0});
+  manager.add(vm::vec3{1024, 0, 0});
+  manager.add(vm::vec3{-1024, 2048, 4096});
+
+  const auto pick = [&](const vm::vec3& target) {
+    const auto origin = vm::vec3{camera.position()};
+    const auto pickRay = vm::ray3{origin, vm::normalize(target - origin)};
+
+    auto pickResult = Model::PickResult{};
+    manager.pick(pickRay, camera, pickResult);
+
+    auto result = std::vector<vm::vec3>{};
+    for (const auto& hit : pickResult.all())
+    {
+      result.push_back(hit.target<vm::vec3>());
+    }
+    return result;
+  };
+
+  CHECK(pick(vm::vec3{0, 0, 0}) == std::vector<vm::vec3>{{0, 0, 0}, {1024, 0, 0}});
+  CHECK(pick(vm::vec3{0, 64, 0}) == std::vector<vm::vec3>{{0, 64, 0}});
+  CHECK(pick(vm::vec3{-1024, 2048, 4096}) == std::vector<vm::vec3>{{-1024, 2048, 4096}});
+  CHECK(pick(vm::vec3{0, 32, 0}).empty());
+
+  manager.remove(vm::vec3{0, 0, 0});
+  CHECK(pick(vm::vec3{0, 0, 0}) == std::vector<vm::vec3>{{1024, 0, 0}});
+}
+
+TEST_CASE("VertexHandleManager.findIncidentBrushes")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{Model::MapFormat::Standard, worldBounds};
+
+  auto brushNode1 = Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{0, 0, 0}, {64, 64, 64}}, "material") | kdl::value()};
+  auto brushNode2 = Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{64, 0, 0}, {128, 64, 64}}, "material")
+    | kdl::value()};
+  auto brushNode3 = Model::BrushNode{
+    builder.createCuboid(vm::bbox3{{512, 0, 0}, {576, 64, 64}}, "material")
+    | kdl::value()};
+
+  auto manager = VertexHandleManager{};
+  manager.addHandles(&brushNode1);
+  manager.addHandles(&brushNode2);
+  manager.addHandles(&brushNode3);
+
+  CHECK_THAT(
+    manager.findIncidentBrushes(vm::vec3{64, 0, 0}),
+    Catch::Matchers::UnorderedEquals(
+      std::vector<Model::BrushNode*>{&brushNode1, &brushNode2}));
+  CHECK(
+    manager.findIncidentBrushes(vm::vec3{0, 0, 0})
+    == std::vector<Model::BrushNode*>{&brushNode1});
+  CHECK(
+    manager.findIncidentBrushes(vm::vec3{576, 64, 64})
+    == std::vector<Model::BrushNode*>{&brushNode3});
+  CHECK(manager.findIncidentBrushes(vm::vec3{32, 0, 0}).empty());
+
+  manager.removeHandles(&brushNode1);
+  CHECK(
+    manager.findIncidentBrushes(vm::vec3{64, 0, 0})
+    == std::vector<Model::BrushNode*>{&brushNode2});
+
+  auto edgeManager = EdgeHandleManager{};
+  edgeManager.addHandles(&brushNode1);
+  edgeManager.addHandles(&brushNode2);
+
+  CHECK_THAT(
+    edgeManager.findIncidentBrushes(vm::segment3{{64, 0, 0}, {64, 64, 0}}),
+    Catch::Matchers::UnorderedEquals(
+      std::vector<Model::BrushNode*>{&brushNode1, &brushNode2}));
+
+  edgeManager.clear();
+  CHECK(edgeManager.findIncidentBrushes(vm::segment3{{64, 0, 0}, {64, 64, 0}}).empty());
+}
+
+} // namespace TrenchBroom::View
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapDocumentTest.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+#include "View/VertexHandleManager.h"
+#include "View/VertexTool.h"
+
+#include "kdl/result.h"
+
+#include "vm/vec.h"
+#include "vm/vec_io.h"
+
+#include "Catch2.h"
+
+namespace TrenchBroom::View
+{
+
+TEST_CASE_METHOD(MapDocumentTest, "VertexTool.removeSelection")
+{
+  auto builder =
+    Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+  auto* brushNode = new Model::BrushNode{
+    builder.createCuboid(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}}, "material")
+      .value()};
+
+  document->addNodes({{document->currentLayer(), {brushNode}}});
+  document->selectNodes({brushNode});
+
+  auto tool = VertexTool{document};
+  REQUIRE(tool.activate());
+  REQUIRE(tool.handleManager().totalHandleCount() == 8u);
+
+  tool.handleManager().select(vm::vec3{64, 64, 64});
+  REQUIRE(tool.canRemoveSelection());
+  tool.removeSelection();
+
+  REQUIRE(brushNode->brush().vertexCount() == 7u);
+
+  auto freshTool = VertexTool{document};
+  REQUIRE(freshTool.activate());
+
+  CHECK(
+    tool.handleManager().totalHandleCount()
+    == freshTool.handleManager().totalHandleCount());
+  CHECK_FALSE(tool.handleManager().contains(vm::vec3{64, 64, 64}));
+
+  // handles that were added more than once would outlive the brush's deselection
+  document->deselectAll();
+  CHECK(tool.handleManager().totalHandleCount() == 0u);
+  CHECK(freshTool.handleManager().totalHandleCount() == 0u);
+}
+
+} // namespace TrenchBroom::View
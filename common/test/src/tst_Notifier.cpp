@@ -417,4 +417,100 @@ TEST_CASE("NotifyBeforeAndAfter")
     CHECK(moveCount <= 3);
   }
 }
+
+TEST_CASE("NotifierTest.coalescing")
+{
+  auto notifier = Notifier<const std::vector<int>&>{};
+
+  auto calls = std::vector<std::vector<int>>{};
+  const auto con =
+    notifier.connect([&](const std::vector<int>& values) { calls.push_back(values); });
+
+  SECTION("Notifications are passed on when not coalescing")
+  {
+    notifier(std::vector<int>{1, 2});
+    notifier(std::vector<int>{2, 3});
+    CHECK(calls == std::vector<std::vector<int>>{{1, 2}, {2, 3}});
+  }
+
+  SECTION("Deferred notifications are delivered once coalescing ends")
+  {
+    notifier.startCoalescing(CoalescingMode::Deferred);
+    CHECK(notifier.coalescing());
+
+    notifier(std::vector<int>{1, 2, 1});
+    notifier.startCoalescing(CoalescingMode::Immediate);
+    notifier(std::vector<int>{2, 3});
+    notifier.stopCoalescing();
+    CHECK(calls.empty());
+
+    notifier.stopCoalescing();
+    CHECK_FALSE(notifier.coalescing());
+    CHECK(calls == std::vector<std::vector<int>>{{1, 2, 3}});
+
+    notifier(std::vector<int>{1});
+    CHECK(calls == std::vector<std::vector<int>>{{1, 2, 3}, {1}});
+  }
+
+  SECTION("Immediate notifications only contain new values")
+  {
+    notifier.startCoalescing(CoalescingMode::Immediate);
+
+    notifier(std::vector<int>{1, 2});
+    notifier(std::vector<int>{2, 1});
+    notifier(std::vector<int>{2, 3});
+    CHECK(calls == std::vector<std::vector<int>>{{1, 2}, {3}});
+
+    notifier.stopCoalescing();
+    CHECK(calls == std::vector<std::vector<int>>{{1, 2}, {3}});
+  }
+
+  SECTION("Discarded values are not delivered")
+  {
+    notifier.startCoalescing(CoalescingMode::Deferred);
+
+    notifier(std::vector<int>{1, 2, 3});
+    notifier.discardCoalescedValues({2, 3});
+    notifier(std::vector<int>{3});
+
+    notifier.stopCoalescing();
+    CHECK(calls == std::vector<std::vector<int>>{{1, 3}});
+  }
+}
+
+TEST_CASE("NotifierTest.observerTimings")
+{
+  const auto getNotificationCounts = [](const auto& notifier) {
+    auto result = std::vector<size_t>{};
+    for (const auto& timing : notifier.observerTimings())
+    {
+      result.push_back(timing.notificationCount);
+    }
+    return result;
+  };
+
+  auto o1 = Observer{};
+  auto o2 = Observer{};
+
+  auto obs = Observed{};
+  auto con = NotifierConnection{};
+
+  con += obs.oneArgNotifier.connect(&o1, &Observer::notify1);
+  con += obs.oneArgNotifier.connect(&o2, &Observer::notify1);
+
+  obs.notify1(1);
+  CHECK(getNotificationCounts(obs.oneArgNotifier) == std::vector<size_t>{0, 0});
+
+  obs.oneArgNotifier.setTimingEnabled(true);
+  obs.notify1(2);
+  obs.notify1(3);
+  obs.oneArgNotifier.setTimingEnabled(false);
+  obs.notify1(4);
+
+  CHECK(getNotificationCounts(obs.oneArgNotifier) == std::vector<size_t>{2, 2});
+  CHECK(o1.notify1Calls == std::vector<int>{1, 2, 3, 4});
+
+  obs.oneArgNotifier.resetObserverTimings();
+  CHECK(getNotificationCounts(obs.oneArgNotifier) == std::vector<size_t>{0, 0});
+}
 } // namespace TrenchBroom
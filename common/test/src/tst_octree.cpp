@@ -26,6 +26,9 @@
 #include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <tuple>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -620,6 +623,46 @@ TEST_CASE("octree.find_intersectors-ray")
   }
 }
 
+TEST_CASE("octree.visit_intersectors_near_to_far")
+{
+  auto tree = octree<double, int>{32.0};
+
+  const auto visit = [&](const vm::ray3d& ray, const size_t limit) {
+    auto result = std::vector<std::tuple<int, double>>{};
+    tree.visit_intersectors_near_to_far(ray, [&](const int data, const double distance) {
+      result.emplace_back(data, distance);
+      return result.size() < limit;
+    });
+    return result;
+  };
+
+  const auto ray = vm::ray3d{{-128, 16, 16}, {1, 0, 0}};
+
+  SECTION("empty tree")
+  {
+    CHECK(visit(ray, 10).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{256, 0, 0}, {288, 32, 32}}, 1);
+    tree.insert({{32, 0, 0}, {64, 32, 32}}, 2);
+    tree.insert({{-64, 0, 0}, {-32, 32, 32}}, 3);
+    tree.insert({{0, 64, 0}, {32, 96, 32}}, 4);
+
+    using T = std::tuple<int, double>;
+    CHECK(visit(ray, 10) == std::vector<T>{{3, 64.0}, {2, 160.0}, {1, 384.0}});
+
+    // stops when the visitor returns false
+    CHECK(visit(ray, 2) == std::vector<T>{{3, 64.0}, {2, 160.0}});
+
+    // the node that contains the ray origin is visited at distance 0
+    CHECK(
+      visit(vm::ray3d{{48, 16, 16}, {1, 0, 0}}, 10)
+      == std::vector<T>{{2, 0.0}, {1, 208.0}});
+  }
+}
+
 TEST_CASE("octree.find_intersectors-bbox")
 {
   auto tree = octree<double, int>{32.0};
@@ -724,4 +767,33 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.find_if")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_if([](const auto&) { return true; }).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+
+    CHECK(tree.find_if([](const auto&) { return false; }).empty());
+    CHECK_THAT(
+      tree.find_if([](const auto&) { return true; }),
+      Catch::Matchers::UnorderedEquals(std::vector<int>{1, 2}));
+
+    // only visits the children of nodes that satisfy the predicate
+    CHECK(
+      tree.find_if([](const auto& bounds) { return bounds.max.x() > 0.0; })
+      == std::vector<int>{1});
+    CHECK(
+      tree.find_if([](const auto& bounds) { return bounds.min.x() < 0.0; })
+      == std::vector<int>{2});
+  }
+}
 } // namespace TrenchBroom
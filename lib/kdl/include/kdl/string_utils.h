@@ -100,6 +100,30 @@ inline std::vector<std::string> str_split(
   return result;
 }
 
+/**
+ * Returns the first token of the given string and removes it from the string. Tokens are
+ * separated by any number of the given delimiters. Leading delimiters are skipped, and
+ * the returned token does not refer to a copy, but to the given string's memory.
+ *
+ * Unlike str_split, this function does not allocate memory and does not handle escaped
+ * delimiters, so it is suitable for tokenizing large inputs.
+ *
+ * @param str the string to tokenize, the returned token and any preceding delimiters are
+ * removed from it
+ * @param delims the delimiters
+ * @return the token or an empty string if the given string contains only delimiters
+ */
+inline std::string_view str_next_token(
+  std::string_view& str, const std::string_view delims)
+{
+  const auto begin = std::min(str.find_first_not_of(delims), str.size());
+  const auto end = std::min(str.find_first_of(delims, begin), str.size());
+
+  const auto token = str.substr(begin, end - begin);
+  str.remove_prefix(end);
+  return token;
+}
+
 /**
  * Joins the objects in the given range [it, end) using the given delimiters. The objects
  * are converted to string using the stream insertion operator and a string stream.
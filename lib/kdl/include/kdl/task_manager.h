@@ -0,0 +1,204 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A fixed size pool of worker threads that run tasks in the order in which they were
+ * submitted.
+ *
+ * In contrast to the functions in parallel.h, the threads are created once and reused for
+ * every task, so the overhead of running a task is small. A task manager is meant to be
+ * shared by all users of an application.
+ *
+ * When the task manager is destroyed, tasks that have not been started yet are dropped
+ * and their futures become ready with a std::future_error (broken promise). Tasks that
+ * are currently running are waited for.
+ */
+class task_manager
+{
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::packaged_task<void()>> m_tasks;
+  std::vector<std::thread> m_threads;
+  bool m_stopped = false;
+
+public:
+  /**
+   * Creates a task manager with one worker thread per hardware thread.
+   */
+  task_manager()
+    : task_manager{size_t(std::thread::hardware_concurrency())}
+  {
+  }
+
+  /**
+   * Creates a task manager with the given number of worker threads. If the given number
+   * is 0, one thread is created.
+   */
+  explicit task_manager(const size_t num_threads)
+  {
+    const auto actual_num_threads = std::max(num_threads, size_t(1));
+    m_threads.reserve(actual_num_threads);
+    for (size_t i = 0; i < actual_num_threads; ++i)
+    {
+      m_threads.emplace_back([&]() { run(); });
+    }
+  }
+
+  task_manager(const task_manager&) = delete;
+  task_manager(task_manager&&) = delete;
+
+  task_manager& operator=(const task_manager&) = delete;
+  task_manager& operator=(task_manager&&) = delete;
+
+  ~task_manager()
+  {
+    {
+      auto lock = std::unique_lock{m_mutex};
+      m_stopped = true;
+      m_tasks.clear();
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  /**
+   * Returns the number of worker threads.
+   */
+  size_t thread_count() const { return m_threads.size(); }
+
+  /**
+   * Enqueues the given task and returns a future that becomes ready when the task has
+   * run. Exceptions thrown by the task are stored in the future.
+   */
+  template <typename F>
+  auto run_task(F task)
+  {
+    using R = std::invoke_result_t<F>;
+
+    auto packaged_task = std::make_shared<std::packaged_task<R()>>(std::move(task));
+    auto future = packaged_task->get_future();
+
+    {
+      auto lock = std::unique_lock{m_mutex};
+      m_tasks.emplace_back([packaged_task = std::move(packaged_task)]() {
+        (*packaged_task)();
+      });
+    }
+    m_condition.notify_one();
+
+    return future;
+  }
+
+  /**
+   * Enqueues the given tasks and returns their futures in the same order.
+   */
+  template <typename F>
+  auto run_tasks(std::vector<F> tasks)
+  {
+    using R = std::invoke_result_t<F>;
+
+    auto futures = std::vector<std::future<R>>{};
+    futures.reserve(tasks.size());
+
+    for (auto& task : tasks)
+    {
+      futures.push_back(run_task(std::move(task)));
+    }
+
+    return futures;
+  }
+
+  /**
+   * Runs the given tasks and waits for all of them to complete. The results are returned
+   * in the same order as the tasks.
+   *
+   * Must not be called from a task that runs on this task manager, as that may deadlock.
+   */
+  template <typename F>
+  auto run_tasks_and_wait(std::vector<F> tasks)
+  {
+    using R = std::invoke_result_t<F>;
+
+    auto futures = run_tasks(std::move(tasks));
+    if constexpr (std::is_void_v<R>)
+    {
+      for (auto& future : futures)
+      {
+        future.get();
+      }
+    }
+    else
+    {
+      auto results = std::vector<R>{};
+      results.reserve(futures.size());
+      for (auto& future : futures)
+      {
+        results.push_back(future.get());
+      }
+      return results;
+    }
+  }
+
+private:
+  void run()
+  {
+    while (true)
+    {
+      auto task = std::packaged_task<void()>{};
+      {
+        auto lock = std::unique_lock{m_mutex};
+        m_condition.wait(lock, [&]() { return m_stopped || !m_tasks.empty(); });
+
+        if (m_stopped)
+        {
+          return;
+        }
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+
+      task();
+    }
+  }
+};
+
+} // namespace kdl
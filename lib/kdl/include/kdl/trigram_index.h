@@ -0,0 +1,278 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "kdl/string_format.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * Maps strings to values and finds the values of all strings that contain a given set of
+ * substrings.
+ *
+ * Every string is decomposed into its trigrams, i.e., its substrings of length 3. For
+ * each trigram, the index stores a sorted list of the strings containing it. A query
+ * first selects the strings containing all trigrams of the given substrings by
+ * intersecting these lists, and then tests only these candidates with a predicate. This
+ * makes substring, glob and regular expression searches fast as long as they contain a
+ * literal of at least three characters.
+ *
+ * Trigrams are case insensitive, so the index can answer case sensitive and case
+ * insensitive queries alike; the predicate decides.
+ *
+ * A string can be mapped to multiple values, and a value can be inserted multiple times
+ * for the same string. A value is removed from a string once it has been removed as many
+ * times as it was inserted.
+ *
+ * @tparam V the type of the values, must be hashable
+ */
+template <typename V>
+class trigram_index
+{
+private:
+  using trigram = std::uint32_t;
+  using string_id = std::size_t;
+
+  struct string_entry
+  {
+    std::string str;
+    std::unordered_map<V, std::size_t> value_counts;
+  };
+
+  std::unordered_map<std::string, string_id> m_ids;
+  std::vector<string_entry> m_entries;
+  std::vector<string_id> m_free_ids;
+  std::unordered_map<trigram, std::vector<string_id>> m_postings;
+
+public:
+  /**
+   * Inserts the given value for the given string.
+   */
+  void insert(const std::string_view str, V value)
+  {
+    auto it = m_ids.find(std::string{str});
+    if (it == m_ids.end())
+    {
+      const auto id = allocate_id(str);
+      for (const auto t : trigrams(str))
+      {
+        auto& posting = m_postings[t];
+        posting.insert(std::lower_bound(posting.begin(), posting.end(), id), id);
+      }
+      it = m_ids.emplace(std::string{str}, id).first;
+    }
+
+    ++m_entries[it->second].value_counts[std::move(value)];
+  }
+
+  /**
+   * Removes the given value for the given string.
+   *
+   * @return true if the value was removed and false if the given string is not mapped to
+   * the given value
+   */
+  bool remove(const std::string_view str, const V& value)
+  {
+    const auto it = m_ids.find(std::string{str});
+    if (it == m_ids.end())
+    {
+      return false;
+    }
+
+    const auto id = it->second;
+    auto& value_counts = m_entries[id].value_counts;
+    const auto count_it = value_counts.find(value);
+    if (count_it == value_counts.end())
+    {
+      return false;
+    }
+
+    if (--count_it->second == 0u)
+    {
+      value_counts.erase(count_it);
+      if (value_counts.empty())
+      {
+        for (const auto t : trigrams(str))
+        {
+          auto posting_it = m_postings.find(t);
+          auto& posting = posting_it->second;
+          posting.erase(std::lower_bound(posting.begin(), posting.end(), id));
+          if (posting.empty())
+          {
+            m_postings.erase(posting_it);
+          }
+        }
+
+        m_entries[id].str.clear();
+        m_free_ids.push_back(id);
+        m_ids.erase(it);
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Returns the number of distinct strings in this index.
+   */
+  std::size_t size() const { return m_ids.size(); }
+
+  /**
+   * Indicates whether this index contains any strings.
+   */
+  bool empty() const { return m_ids.empty(); }
+
+  /**
+   * Finds the values of the strings that contain each of the given substrings case
+   * insensitively and that satisfy the given predicate. The predicate is only called for
+   * strings that contain all trigrams of the given substrings. If none of the substrings
+   * has at least three characters, the predicate is called for every string.
+   *
+   * Every value is added to the given output iterator once for every matching string it
+   * is mapped to.
+   *
+   * @tparam P the type of the predicate, must accept a std::string_view
+   * @tparam O the type of the output iterator
+   * @param substrings the substrings that every matching string must contain
+   * @param predicate the predicate that every matching string must satisfy
+   * @param out the output iterator
+   */
+  template <typename P, typename O>
+  void find_matches(
+    const std::vector<std::string_view>& substrings, const P& predicate, O out) const
+  {
+    auto query_trigrams = std::vector<trigram>{};
+    for (const auto substring : substrings)
+    {
+      const auto substring_trigrams = trigrams(substring);
+      query_trigrams.insert(
+        query_trigrams.end(), substring_trigrams.begin(), substring_trigrams.end());
+    }
+
+    if (query_trigrams.empty())
+    {
+      for (const auto& [str, id] : m_ids)
+      {
+        get_values_if_matching(id, predicate, out);
+      }
+      return;
+    }
+
+    auto postings = std::vector<const std::vector<string_id>*>{};
+    for (const auto t : query_trigrams)
+    {
+      const auto it = m_postings.find(t);
+      if (it == m_postings.end())
+      {
+        // no string contains this trigram
+        return;
+      }
+      postings.push_back(&it->second);
+    }
+
+    // intersect the shortest lists first to keep the intermediate results small
+    std::sort(postings.begin(), postings.end(), [](const auto* lhs, const auto* rhs) {
+      return lhs->size() < rhs->size();
+    });
+
+    auto candidates = *postings.front();
+    auto intersection = std::vector<string_id>{};
+    for (auto it = std::next(postings.begin());
+         it != postings.end() && !candidates.empty();
+         ++it)
+    {
+      intersection.clear();
+      std::set_intersection(
+        candidates.begin(),
+        candidates.end(),
+        (*it)->begin(),
+        (*it)->end(),
+        std::back_inserter(intersection));
+      std::swap(candidates, intersection);
+    }
+
+    for (const auto id : candidates)
+    {
+      get_values_if_matching(id, predicate, out);
+    }
+  }
+
+private:
+  string_id allocate_id(const std::string_view str)
+  {
+    if (!m_free_ids.empty())
+    {
+      const auto id = m_free_ids.back();
+      m_free_ids.pop_back();
+      m_entries[id].str = std::string{str};
+      return id;
+    }
+
+    m_entries.push_back(string_entry{std::string{str}, {}});
+    return m_entries.size() - 1u;
+  }
+
+  template <typename P, typename O>
+  void get_values_if_matching(const string_id id, const P& predicate, O& out) const
+  {
+    const auto& entry = m_entries[id];
+    if (predicate(std::string_view{entry.str}))
+    {
+      for (const auto& [value, count] : entry.value_counts)
+      {
+        *out++ = value;
+      }
+    }
+  }
+
+  /**
+   * Returns the distinct, case folded trigrams of the given string in ascending order.
+   */
+  static std::vector<trigram> trigrams(const std::string_view str)
+  {
+    auto result = std::vector<trigram>{};
+    if (str.length() >= 3u)
+    {
+      result.reserve(str.length() - 2u);
+      for (std::size_t i = 0u; i + 2u < str.length(); ++i)
+      {
+        result.push_back(
+          trigram(static_cast<unsigned char>(str_to_lower(str[i]))) << 16u
+          | trigram(static_cast<unsigned char>(str_to_lower(str[i + 1u]))) << 8u
+          | trigram(static_cast<unsigned char>(str_to_lower(str[i + 2u]))));
+      }
+      std::sort(result.begin(), result.end());
+      result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+    return result;
+  }
+};
+
+} // namespace kdl
@@ -67,6 +67,35 @@ TEST_CASE("string_utils_test.str_split")
     str_split("c:\\x\\y", "\\"), Catch::Equals(std::vector<std::string>{"c:", "x", "y"}));
 }
 
+TEST_CASE("string_utils_test.str_next_token")
+{
+  auto str = std::string_view{};
+  CHECK(str_next_token(str, " ") == "");
+  CHECK(str == "");
+
+  str = "  ";
+  CHECK(str_next_token(str, " ") == "");
+  CHECK(str == "");
+
+  str = "asdf";
+  CHECK(str_next_token(str, " ") == "asdf");
+  CHECK(str == "");
+
+  str = " (1 -2.5 ) 3\n";
+  CHECK(str_next_token(str, " ()\n") == "1");
+  CHECK(str == " -2.5 ) 3\n");
+  CHECK(str_next_token(str, " ()\n") == "-2.5");
+  CHECK(str_next_token(str, " ()\n") == "3");
+  CHECK(str == "\n");
+  CHECK(str_next_token(str, " ()\n") == "");
+  CHECK(str == "");
+
+  const auto original = std::string{"The quick fox"};
+  str = original;
+  CHECK(str_next_token(str, " ").data() == original.data());
+  CHECK(str_next_token(str, " ").data() == original.data() + 4);
+}
+
 TEST_CASE("string_utils_test.str_join")
 {
   CHECK(str_join(std::vector<std::string_view>{}, ", ", " and ", ", and ") == "");
@@ -0,0 +1,102 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/task_manager.h"
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+TEST_CASE("task_manager")
+{
+  SECTION("thread_count")
+  {
+    CHECK(task_manager{0}.thread_count() == 1);
+    CHECK(task_manager{3}.thread_count() == 3);
+  }
+
+  SECTION("run_task")
+  {
+    auto taskManager = task_manager{2};
+
+    auto future = taskManager.run_task([]() { return 7; });
+    CHECK(future.get() == 7);
+  }
+
+  SECTION("run_task stores exceptions in the future")
+  {
+    auto taskManager = task_manager{2};
+
+    auto future =
+      taskManager.run_task([]() -> int { throw std::runtime_error{"error"}; });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
+  SECTION("run_tasks")
+  {
+    auto taskManager = task_manager{4};
+
+    auto tasks = std::vector<std::function<int()>>{};
+    for (int i = 0; i < 100; ++i)
+    {
+      tasks.emplace_back([i]() { return i * 2; });
+    }
+
+    auto futures = taskManager.run_tasks(std::move(tasks));
+    REQUIRE(futures.size() == 100);
+    for (int i = 0; i < 100; ++i)
+    {
+      CHECK(futures[size_t(i)].get() == i * 2);
+    }
+  }
+
+  SECTION("run_tasks_and_wait")
+  {
+    auto taskManager = task_manager{4};
+
+    auto counter = std::atomic<int>{0};
+    auto voidTasks = std::vector<std::function<void()>>{};
+    for (int i = 0; i < 100; ++i)
+    {
+      voidTasks.emplace_back([&]() { ++counter; });
+    }
+
+    taskManager.run_tasks_and_wait(std::move(voidTasks));
+    CHECK(counter == 100);
+
+    auto tasks = std::vector<std::function<int()>>{};
+    for (int i = 0; i < 10; ++i)
+    {
+      tasks.emplace_back([i]() { return i; });
+    }
+
+    CHECK(
+      taskManager.run_tasks_and_wait(std::move(tasks))
+      == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  }
+}
+
+} // namespace kdl
@@ -0,0 +1,180 @@
+/*
+ Copyright 2010-2019 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/string_compare.h"
+#include "kdl/trigram_index.h"
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+using test_index = trigram_index<std::string>;
+
+std::vector<std::string> find_containing(
+  const test_index& index, const std::string_view substring)
+{
+  auto result = std::vector<std::string>{};
+  index.find_matches(
+    {substring},
+    [&](const auto& str) { return cs::str_contains(str, substring); },
+    std::back_inserter(result));
+  return result;
+}
+
+std::vector<std::string> find_matching_glob(
+  const test_index& index,
+  const std::vector<std::string_view>& substrings,
+  const std::string_view pattern)
+{
+  auto result = std::vector<std::string>{};
+  index.find_matches(
+    substrings,
+    [&](const auto& str) { return cs::str_matches_glob(str, pattern); },
+    std::back_inserter(result));
+  return result;
+}
+} // namespace
+
+TEST_CASE("trigram_index.insert")
+{
+  auto index = test_index{};
+  CHECK(index.empty());
+
+  index.insert("info_player_start", "value1");
+  index.insert("info_player_deathmatch", "value2");
+  index.insert("light", "value3");
+  index.insert("light", "value4");
+  index.insert("ok", "value5");
+
+  CHECK(index.size() == 4u);
+
+  CHECK_THAT(
+    find_containing(index, "player"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value1", "value2"}));
+  CHECK_THAT(
+    find_containing(index, "start"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value1"}));
+  CHECK_THAT(
+    find_containing(index, "igh"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value3", "value4"}));
+  CHECK(find_containing(index, "monster").empty());
+  CHECK(find_containing(index, "player_light").empty());
+
+  // queries without trigrams test all strings
+  CHECK_THAT(
+    find_containing(index, "ok"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value5"}));
+  CHECK_THAT(
+    find_containing(index, "t"),
+    Catch::UnorderedEquals(
+      std::vector<std::string>{"value1", "value2", "value3", "value4"}));
+}
+
+TEST_CASE("trigram_index.insert_duplicates")
+{
+  auto index = test_index{};
+  index.insert("light", "value");
+  index.insert("light", "value");
+
+  CHECK(index.size() == 1u);
+  CHECK(find_containing(index, "light") == std::vector<std::string>{"value"});
+
+  CHECK(index.remove("light", "value"));
+  CHECK(find_containing(index, "light") == std::vector<std::string>{"value"});
+
+  CHECK(index.remove("light", "value"));
+  CHECK(find_containing(index, "light").empty());
+  CHECK(index.empty());
+}
+
+TEST_CASE("trigram_index.remove")
+{
+  auto index = test_index{};
+  index.insert("info_player_start", "value1");
+  index.insert("info_player_deathmatch", "value2");
+  index.insert("light", "value3");
+
+  CHECK_FALSE(index.remove("info_player_start", "value2"));
+  CHECK_FALSE(index.remove("info_player_coop", "value1"));
+
+  CHECK(index.remove("info_player_start", "value1"));
+  CHECK(index.size() == 2u);
+  CHECK(find_containing(index, "start").empty());
+  CHECK_THAT(
+    find_containing(index, "player"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value2"}));
+
+  // reuses the removed string's slot
+  index.insert("info_player_coop", "value4");
+  CHECK_THAT(
+    find_containing(index, "player"),
+    Catch::UnorderedEquals(std::vector<std::string>{"value2", "value4"}));
+  CHECK(find_containing(index, "start").empty());
+}
+
+TEST_CASE("trigram_index.find_matches")
+{
+  auto index = test_index{};
+  index.insert("info_player_start", "value1");
+  index.insert("INFO_PLAYER_DEATHMATCH", "value2");
+  index.insert("light_flame_large_yellow", "value3");
+
+  SECTION("Trigrams are case insensitive")
+  {
+    CHECK(find_containing(index, "PLAYER") == std::vector<std::string>{"value2"});
+
+    auto result = std::vector<std::string>{};
+    index.find_matches(
+      {"player"},
+      [](const auto& str) { return ci::str_contains(str, "player"); },
+      std::back_inserter(result));
+    CHECK_THAT(
+      result, Catch::UnorderedEquals(std::vector<std::string>{"value1", "value2"}));
+  }
+
+  SECTION("Multiple substrings")
+  {
+    CHECK(
+      find_matching_glob(index, {"info", "start"}, "info*start")
+      == std::vector<std::string>{"value1"});
+    CHECK(
+      find_matching_glob(index, {"light", "yellow"}, "light*yellow")
+      == std::vector<std::string>{"value3"});
+    CHECK(find_matching_glob(index, {"light", "start"}, "light*start").empty());
+  }
+
+  SECTION("Predicate filters candidates")
+  {
+    // both strings contain "info" and "start", but only one matches the pattern
+    index.insert("start_info", "value4");
+    CHECK(
+      find_matching_glob(index, {"info", "start"}, "info*start")
+      == std::vector<std::string>{"value1"});
+  }
+}
+
+} // namespace kdl